@@ -578,119 +578,107 @@ namespace QuantLib {
                 return -1;
         }
 
-        Real simpleDuration(const Leg& leg,
-                            const InterestRate& y,
-                            bool includeSettlementDateFlows,
-                            Date settlementDate,
-                            Date npvDate) {
-            if (leg.empty())
-                return 0.0;
+        /* Columnar snapshot of the cash flows of a leg that have not
+           occurred at the settlement date: amounts (zero if trading
+           ex-coupon) and accrual periods between consecutive payments
+           (starting at the npv date) measured with the given day
+           counter.  Since the latter don't depend on the yield, they
+           can be calculated once and reused when the leg is evaluated
+           repeatedly, e.g., while solving for its yield. */
+        class LegSnapshot {
+          public:
+            LegSnapshot(const Leg& leg,
+                        const DayCounter& dc,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+                if (settlementDate == Date())
+                    settlementDate = Settings::instance().evaluationDate();
 
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
+                if (npvDate == Date())
+                    npvDate = settlementDate;
 
-            if (npvDate == Date())
-                npvDate = settlementDate;
+                amounts.reserve(leg.size());
+                periods.reserve(leg.size());
+                Date lastDate = npvDate;
+                Date refStartDate, refEndDate;
+                for (Size i=0; i<leg.size(); ++i) {
+                    if (leg[i]->hasOccurred(settlementDate,
+                                            includeSettlementDateFlows))
+                        continue;
+
+                    Real c = leg[i]->amount();
+                    if (leg[i]->tradingExCoupon(settlementDate)) {
+                        c = 0.0;
+                    }
 
-            Real P = 0.0;
-            Real dPdy = 0.0;
-            Time t = 0.0;
-            Date lastDate = npvDate;
-            Date refStartDate, refEndDate;
-            const DayCounter& dc = y.dayCounter();
-            for (Size i=0; i<leg.size(); ++i) {
-                if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
-                    continue;
+                    Date couponDate = leg[i]->date();
+                    shared_ptr<Coupon> coupon =
+                        boost::dynamic_pointer_cast<Coupon>(leg[i]);
+                    if (coupon) {
+                        refStartDate = coupon->referencePeriodStart();
+                        refEndDate = coupon->referencePeriodEnd();
+                    } else {
+                        if (lastDate == npvDate) {
+                            // we don't have a previous coupon date,
+                            // so we fake it
+                            refStartDate = couponDate - 1*Years;
+                        } else  {
+                            refStartDate = lastDate;
+                        }
+                        refEndDate = couponDate;
+                    }
 
-                Real c = leg[i]->amount();
-                if (leg[i]->tradingExCoupon(settlementDate)) {
-                    c = 0.0;
+                    amounts.push_back(c);
+                    periods.push_back(dc.yearFraction(lastDate, couponDate,
+                                                      refStartDate,
+                                                      refEndDate));
+                    lastDate = couponDate;
                 }
-
-                Date couponDate = leg[i]->date();
-                shared_ptr<Coupon> coupon =
-                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
-                if (coupon) {
-                    refStartDate = coupon->referencePeriodStart();
-                    refEndDate = coupon->referencePeriodEnd();
-                } else {
-                    if (lastDate == npvDate) {
-                        // we don't have a previous coupon date,
-                        // so we fake it
-                        refStartDate = couponDate - 1*Years;
-                    } else  {
-                        refStartDate = lastDate;
-                    }
-                    refEndDate = couponDate;
+            }
+            Size size() const { return amounts.size(); }
+            Real npv(const InterestRate& y) const {
+                Real npv = 0.0;
+                DiscountFactor discount = 1.0;
+                for (Size i=0; i<amounts.size(); ++i) {
+                    discount *= y.discountFactor(periods[i]);
+                    npv += amounts[i] * discount;
                 }
+                return npv;
+            }
+            std::vector<Real> amounts;
+            std::vector<Time> periods;
+        };
 
-                t += dc.yearFraction(lastDate, couponDate,
-                                     refStartDate, refEndDate);
+        Real simpleDuration(const LegSnapshot& leg,
+                            const InterestRate& y) {
+            Real P = 0.0;
+            Real dPdy = 0.0;
+            Time t = 0.0;
+            for (Size i=0; i<leg.size(); ++i) {
+                Real c = leg.amounts[i];
+                t += leg.periods[i];
 
                 DiscountFactor B = y.discountFactor(t);
                 P += c * B;
                 dPdy += t * c * B;
-                
-                lastDate = couponDate;
             }
             if (P == 0.0) // no cashflows
                 return 0.0;
             return dPdy/P;
         }
 
-        Real modifiedDuration(const Leg& leg,
-                              const InterestRate& y,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
-            if (leg.empty())
-                return 0.0;
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
-
-            if (npvDate == Date())
-                npvDate = settlementDate;
-
+        Real modifiedDuration(const LegSnapshot& leg,
+                              const InterestRate& y) {
             Real P = 0.0;
             Time t = 0.0;
             Real dPdy = 0.0;
             Rate r = y.rate();
             Natural N = y.frequency();
-            Date lastDate = npvDate;
-            Date refStartDate, refEndDate;
-            const DayCounter& dc = y.dayCounter();
             for (Size i=0; i<leg.size(); ++i) {
-                if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
-                    continue;
+                Real c = leg.amounts[i];
+                t += leg.periods[i];
 
-                Real c = leg[i]->amount();
-                if (leg[i]->tradingExCoupon(settlementDate)) {
-                    c = 0.0;
-                }
-
-                Date couponDate = leg[i]->date();
-                shared_ptr<Coupon> coupon =
-                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
-                if (coupon) {
-                    refStartDate = coupon->referencePeriodStart();
-                    refEndDate = coupon->referencePeriodEnd();
-                } else {
-                    if (lastDate == npvDate) {
-                        // we don't have a previous coupon date,
-                        // so we fake it
-                        refStartDate = couponDate - 1*Years;
-                    } else  {
-                        refStartDate = lastDate;
-                    }
-                    refEndDate = couponDate;
-                }
-                
-                t += dc.yearFraction(lastDate, couponDate,
-                                     refStartDate, refEndDate);
-                
                 DiscountFactor B = y.discountFactor(t);
                 P += c * B;
                 switch (y.compounding()) {
@@ -713,7 +701,6 @@ namespace QuantLib {
                     QL_FAIL("unknown compounding convention (" <<
                             Integer(y.compounding()) << ")");
                 }
-                lastDate = couponDate;
             }
 
             if (P == 0.0) // no cashflows
@@ -721,6 +708,34 @@ namespace QuantLib {
             return -dPdy/P; // reverse derivative sign
         }
 
+        Real simpleDuration(const Leg& leg,
+                            const InterestRate& y,
+                            bool includeSettlementDateFlows,
+                            Date settlementDate,
+                            Date npvDate) {
+            if (leg.empty())
+                return 0.0;
+
+            return simpleDuration(LegSnapshot(leg, y.dayCounter(),
+                                              includeSettlementDateFlows,
+                                              settlementDate, npvDate),
+                                  y);
+        }
+
+        Real modifiedDuration(const Leg& leg,
+                              const InterestRate& y,
+                              bool includeSettlementDateFlows,
+                              Date settlementDate,
+                              Date npvDate) {
+            if (leg.empty())
+                return 0.0;
+
+            return modifiedDuration(LegSnapshot(leg, y.dayCounter(),
+                                                includeSettlementDateFlows,
+                                                settlementDate, npvDate),
+                                    y);
+        }
+
         Real macaulayDuration(const Leg& leg,
                               const InterestRate& y,
                               bool includeSettlementDateFlows,
@@ -750,29 +765,19 @@ namespace QuantLib {
               dayCounter_(dayCounter), compounding_(comp), frequency_(freq),
               includeSettlementDateFlows_(includeSettlementDateFlows),
               settlementDate_(settlementDate),
-              npvDate_(npvDate) {
-
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
-
-                if (npvDate == Date())
-                    npvDate = settlementDate;
-
+              npvDate_(npvDate),
+              snapshot_(leg, dayCounter, includeSettlementDateFlows,
+                        settlementDate, npvDate) {
                 checkSign();
             }
             Real operator()(Rate y) const {
                 InterestRate yield(y, dayCounter_, compounding_, frequency_);
-                Real NPV = CashFlows::npv(leg_, yield,
-                                          includeSettlementDateFlows_,
-                                          settlementDate_, npvDate_);
+                Real NPV = snapshot_.npv(yield);
                 return npv_ - NPV;
             }
             Real derivative(Rate y) const {
                 InterestRate yield(y, dayCounter_, compounding_, frequency_);
-                return modifiedDuration(leg_, yield,
-                                        includeSettlementDateFlows_,
-                                        settlementDate_, npvDate_);
+                return modifiedDuration(snapshot_, yield);
             }
           private:
             void checkSign() const {
@@ -824,6 +829,7 @@ namespace QuantLib {
             Frequency frequency_;
             bool includeSettlementDateFlows_;
             Date settlementDate_, npvDate_;
+            LegSnapshot snapshot_;
         };
 
 
@@ -839,52 +845,10 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
-        Real npv = 0.0;
-        DiscountFactor discount = 1.0;
-        Date lastDate = npvDate;
-        Date refStartDate, refEndDate;
-
-        for (Size i=0; i<leg.size(); ++i) {
-            if (leg[i]->hasOccurred(settlementDate,
-                                    includeSettlementDateFlows))
-                continue;
-
-            Date couponDate = leg[i]->date();
-            Real amount = leg[i]->amount();
-            if (leg[i]->tradingExCoupon(settlementDate)) {
-                amount = 0.0;
-            }
-
-            shared_ptr<Coupon> coupon =
-                boost::dynamic_pointer_cast<Coupon>(leg[i]);
-            if (coupon) {
-                refStartDate = coupon->referencePeriodStart();
-                refEndDate = coupon->referencePeriodEnd();
-            } else {
-                if (lastDate == npvDate) {
-                    // we don't have a previous coupon date,
-                    // so we fake it
-                    refStartDate = couponDate - 1*Years;
-                } else  {
-                    refStartDate = lastDate;
-                }
-                refEndDate = couponDate;
-            }
-            DiscountFactor b = y.discountFactor(lastDate, couponDate,
-                                                refStartDate, refEndDate);
-            discount *= b;
-            lastDate = couponDate;
-
-            npv += amount * discount;
-        }
-
-        return npv;
+        LegSnapshot snapshot(leg, y.dayCounter(),
+                             includeSettlementDateFlows,
+                             settlementDate, npvDate);
+        return snapshot.npv(y);
     }
 
     Real CashFlows::npv(const Leg& leg,
@@ -1020,45 +984,19 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        const DayCounter& dc = y.dayCounter();
+        LegSnapshot snapshot(leg, y.dayCounter(),
+                             includeSettlementDateFlows,
+                             settlementDate, npvDate);
 
         Real P = 0.0;
         Time t = 0.0;
         Real d2Pdy2 = 0.0;
         Rate r = y.rate();
         Natural N = y.frequency();
-        Date lastDate = npvDate;
-        Date refStartDate, refEndDate;
-        for (Size i=0; i<leg.size(); ++i) {
-            if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
-                continue;
-            
-            Real c = leg[i]->amount();
-            if (leg[i]->tradingExCoupon(settlementDate)) {
-                c = 0.0;
-            }
+        for (Size i=0; i<snapshot.size(); ++i) {
+            Real c = snapshot.amounts[i];
+            t += snapshot.periods[i];
 
-            Date couponDate = leg[i]->date();
-            shared_ptr<Coupon> coupon =
-                boost::dynamic_pointer_cast<Coupon>(leg[i]);
-            if (coupon) {
-                refStartDate = coupon->referencePeriodStart();
-                refEndDate = coupon->referencePeriodEnd();
-            } else {
-                if (lastDate == npvDate) {
-                    // we don't have a previous coupon date,
-                    // so we fake it
-                    refStartDate = couponDate - 1*Years;
-                } else  {
-                    refStartDate = lastDate;
-                }
-                refEndDate = couponDate;
-            }
-            
-            t += dc.yearFraction(lastDate, couponDate,
-                                 refStartDate, refEndDate);
-            
             DiscountFactor B = y.discountFactor(t);
             P += c * B;
             switch (y.compounding()) {
@@ -1081,7 +1019,6 @@ namespace QuantLib {
                 QL_FAIL("unknown compounding convention (" <<
                         Integer(y.compounding()) << ")");
             }
-            lastDate = couponDate;
         }
 
         if (P == 0.0)
@@ -1205,12 +1142,9 @@ namespace QuantLib {
                           bool includeSettlementDateFlows,
                           Date settlementDate,
                           Date npvDate)
-            : leg_(leg), npv_(npv), zSpread_(new SimpleQuote(0.0)),
+            : npv_(npv), zSpread_(new SimpleQuote(0.0)),
               curve_(Handle<YieldTermStructure>(discountCurve),
-                     Handle<Quote>(zSpread_), comp, freq, dc),
-              includeSettlementDateFlows_(includeSettlementDateFlows),
-              settlementDate_(settlementDate),
-              npvDate_(npvDate) {
+                     Handle<Quote>(zSpread_), comp, freq, dc) {
 
                 if (settlementDate == Date())
                     settlementDate = Settings::instance().evaluationDate();
@@ -1222,21 +1156,36 @@ namespace QuantLib {
                 // the spreaded curve do too.
                 curve_.enableExtrapolation(
                                   discountCurve->allowsExtrapolation());
+
+                // the payment times on the spreaded curve don't
+                // depend on the spread, so we store them once together
+                // with the corresponding amounts
+                for (Size i=0; i<leg.size(); ++i) {
+                    if (!leg[i]->hasOccurred(settlementDate,
+                                             includeSettlementDateFlows) &&
+                        !leg[i]->tradingExCoupon(settlementDate)) {
+                        amounts_.push_back(leg[i]->amount());
+                        times_.push_back(
+                                   curve_.timeFromReference(leg[i]->date()));
+                    }
+                }
+                npvTime_ = curve_.timeFromReference(npvDate);
             }
             Real operator()(Rate zSpread) const {
                 zSpread_->setValue(zSpread);
-                Real NPV = CashFlows::npv(leg_, curve_,
-                                          includeSettlementDateFlows_,
-                                          settlementDate_, npvDate_);
+                Real NPV = 0.0;
+                for (Size i=0; i<amounts_.size(); ++i)
+                    NPV += amounts_[i] * curve_.discount(times_[i]);
+                NPV /= curve_.discount(npvTime_);
                 return npv_ - NPV;
             }
           private:
-            const Leg& leg_;
             Real npv_;
             shared_ptr<SimpleQuote> zSpread_;
             ZeroSpreadedTermStructure curve_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
+            std::vector<Real> amounts_;
+            std::vector<Time> times_;
+            Time npvTime_;
         };
 
     } // anonymous namespace ends here
@@ -62,6 +62,11 @@ namespace QuantLib {
         smile_(volatilityStructure_->smileSection(expiryDate_, swapTenor_)) {
         }
 
+    BlackVanillaOptionPricer::BlackVanillaOptionPricer(
+            Rate forwardValue,
+            const boost::shared_ptr<SmileSection>& smile)
+    : forwardValue_(forwardValue), smile_(smile) {}
+
     Real BlackVanillaOptionPricer::operator()(Real strike,
                                               Option::Type optionType,
                                               Real deflator) const {
@@ -81,7 +86,7 @@ namespace QuantLib {
     : CmsCouponPricer(swaptionVol),
       modelOfYieldCurve_(modelOfYieldCurve),
       cutoffForCaplet_(2), cutoffForFloorlet_(0),
-      meanReversion_(meanReversion) {
+      meanReversion_(meanReversion), replication_(0) {
           registerWith(meanReversion_);
     }
 
@@ -99,6 +104,36 @@ namespace QuantLib {
         rateCurve_ = *(swapIndex->forwardingTermStructure());
 
         Date today = Settings::instance().evaluationDate();
+        if (today != cacheDate_) {
+            clearCache();
+            cacheDate_ = today;
+        }
+
+        ReplicationKey key;
+        key.fixingDate = fixingDate_;
+        key.paymentDate = paymentDate_;
+        key.swapIndex = swapIndex;
+        std::map<ReplicationKey, ReplicationData>::iterator cached =
+            replications_.find(key);
+        if (cached != replications_.end()) {
+            replication_ = &(cached->second);
+            discount_ = replication_->discount;
+            spreadLegValue_ = spread_ * accrualPeriod * discount_;
+            if (fixingDate_ > today) {
+                swapRateValue_ = replication_->swapRateValue;
+                annuity_ = replication_->annuity;
+                swapTenor_ = replication_->swapTenor;
+                gFunction_ = replication_->gFunction;
+                vanillaOptionPricer_ = replication_->vanillaOptionPricer;
+            }
+            return;
+        }
+
+        // the stored data depend on the index curves; registering
+        // once per stored result is enough
+        registerWith(swapIndex);
+        if (replications_.size() >= maxReplications())
+            clearCache();
 
         if(paymentDate_ > today)
             discount_ = rateCurve_->discount(paymentDate_);
@@ -145,10 +180,64 @@ namespace QuantLib {
                 default:
                     QL_FAIL("unknown/illegal gFunction type");
             }
+
+            boost::shared_ptr<SmileSection>& smile =
+                smileSections_[std::make_pair(fixingDate_,
+                                   std::make_pair(swapTenor_.length(),
+                                                  Integer(swapTenor_.units())))];
+            if (!smile)
+                smile = swaptionVolatility()->smileSection(fixingDate_,
+                                                           swapTenor_);
             vanillaOptionPricer_= boost::shared_ptr<VanillaOptionPricer>(new
-                BlackVanillaOptionPricer(swapRateValue_, fixingDate_, swapTenor_,
-                                        *swaptionVolatility()));
-         }
+                BlackVanillaOptionPricer(swapRateValue_, smile));
+        }
+
+        replication_ = &replications_[key];
+        replication_->discount = discount_;
+        if (fixingDate_ > today) {
+            replication_->swapRateValue = swapRateValue_;
+            replication_->annuity = annuity_;
+            replication_->swapTenor = swapTenor_;
+            replication_->gFunction = gFunction_;
+            replication_->vanillaOptionPricer = vanillaOptionPricer_;
+        }
+    }
+
+    Real HaganPricer::cachedOptionletPrice(Option::Type optionType,
+                                           Real strike) const {
+        if (!replication_)
+            return optionletPrice(optionType, strike);
+        Time accrualPeriod = coupon_->accrualPeriod();
+        std::pair<OptionletPrices::iterator, bool> i =
+            replication_->optionletPrices.insert(
+                std::make_pair(std::make_pair(optionType, strike),
+                               std::make_pair(accrualPeriod, Real(0.0))));
+        if (i.second) {
+            // compute before storing, so that a failure leaves no entry
+            try {
+                i.first->second.second = optionletPrice(optionType, strike);
+            } catch (...) {
+                replication_->optionletPrices.erase(i.first);
+                throw;
+            }
+            return i.first->second.second;
+        }
+        // optionlet prices scale with the accrual period
+        const std::pair<Time, Real>& cached = i.first->second;
+        if (cached.first == accrualPeriod)
+            return cached.second;
+        return cached.second * (accrualPeriod / cached.first);
+    }
+
+    void HaganPricer::clearCache() const {
+        replications_.clear();
+        smileSections_.clear();
+        replication_ = 0;
+    }
+
+    void HaganPricer::update() {
+        clearCache();
+        CmsCouponPricer::update();
     }
 
     Real HaganPricer::meanReversion() const { return meanReversion_->value();}
@@ -171,7 +260,7 @@ namespace QuantLib {
             Real capletPrice = 0;
             if (effectiveCap < cutoffForCaplet_) {
                 Rate effectiveStrikeForMax = std::max(effectiveCap,cutoffNearZero);
-                capletPrice = optionletPrice(Option::Call, effectiveStrikeForMax);
+                capletPrice = cachedOptionletPrice(Option::Call, effectiveStrikeForMax);
             }
             return gearing_ * capletPrice;
         }
@@ -195,7 +284,7 @@ namespace QuantLib {
             Real floorletPrice = 0;
             if (effectiveFloor > cutoffForFloorlet_){
                 Rate effectiveStrikeForMin = std::max(effectiveFloor,cutoffNearZero);
-                floorletPrice=optionletPrice(Option::Put, effectiveStrikeForMin);
+                floorletPrice=cachedOptionletPrice(Option::Put, effectiveStrikeForMin);
             }
             return gearing_ * floorletPrice;
         }
@@ -361,8 +450,10 @@ namespace QuantLib {
             Rate price = (gearing_*Rs + spread_)*(coupon_->accrualPeriod()*discount_);
             return price;
         } else {
-            Real atmCapletPrice = optionletPrice(Option::Call, swapRateValue_);
-            Real atmFloorletPrice = optionletPrice(Option::Put, swapRateValue_);
+            Real atmCapletPrice =
+                cachedOptionletPrice(Option::Call, swapRateValue_);
+            Real atmFloorletPrice =
+                cachedOptionletPrice(Option::Put, swapRateValue_);
             return gearing_ *(coupon_->accrualPeriod()* discount_ * swapRateValue_
                              + atmCapletPrice - atmFloorletPrice)
                    + spreadLegValue_;
@@ -25,10 +25,12 @@
 
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <map>
 
 namespace QuantLib {
 
     class CmsCoupon;
+    class SwapIndex;
     class YieldTermStructure;
     class Quote;
 
@@ -48,6 +50,10 @@ namespace QuantLib {
                 const Period& swapTenor,
                 const boost::shared_ptr<SwaptionVolatilityStructure>&
                                                          volatilityStructure);
+        //! reuses a smile section already taken from the volatility
+        BlackVanillaOptionPricer(
+                Rate forwardValue,
+                const boost::shared_ptr<SmileSection>& smile);
 
         Real operator()(Real strike,
                         Option::Type optionType,
@@ -195,6 +201,15 @@ namespace QuantLib {
     //! CMS-coupon pricer
     /*! Base class for the pricing of a CMS coupon via static replication
         as in Hagan's "Conundrums..." article
+
+        The replication results are stored and reused by coupons with
+        the same fixing date, payment date and swap index.  At most
+        maxReplications() of them are kept; they are all dropped when
+        the limit is reached.
+
+        \warning as the coupon data set by initialize(), the stored
+                 results are not synchronized: a pricer must not be
+                 shared by coupons priced concurrently.
     */
     class HaganPricer: public CmsCouponPricer, public MeanRevertingPricer {
       public:
@@ -207,12 +222,16 @@ namespace QuantLib {
         virtual Rate floorletRate(Rate effectiveFloor) const;
         /* */
         Real meanReversion() const;
+        //! maximum number of stored replication results
+        static Size maxReplications() { return 1000; }
         void setMeanReversion(const Handle<Quote>& meanReversion) {
             unregisterWith(meanReversion_);
             meanReversion_ = meanReversion;
             registerWith(meanReversion_);
             update();
         };
+        //! Observer interface
+        void update();
       protected:
         HaganPricer(
                 const Handle<SwaptionVolatilityStructure>& swaptionVol,
@@ -222,6 +241,13 @@ namespace QuantLib {
 
         virtual Real optionletPrice(Option::Type optionType,
                                     Real strike) const = 0;
+        /*! returns optionletPrice() for the current coupon, reusing
+            the result of a previous coupon with the same fixing date,
+            payment date, swap index and strike if the market data
+            did not change in between.
+        */
+        Real cachedOptionletPrice(Option::Type optionType,
+                                  Real strike) const;
 
         boost::shared_ptr<YieldTermStructure> rateCurve_;
         GFunctionFactory::YieldCurveModel modelOfYieldCurve_;
@@ -238,6 +264,43 @@ namespace QuantLib {
         Handle<Quote> meanReversion_;
         Period swapTenor_;
         boost::shared_ptr<VanillaOptionPricer> vanillaOptionPricer_;
+      private:
+        // the key holds the index, so that its address can't be
+        // reused by another index while the data are stored
+        struct ReplicationKey {
+            Date fixingDate, paymentDate;
+            boost::shared_ptr<SwapIndex> swapIndex;
+            bool operator<(const ReplicationKey& other) const {
+                if (fixingDate != other.fixingDate)
+                    return fixingDate < other.fixingDate;
+                if (paymentDate != other.paymentDate)
+                    return paymentDate < other.paymentDate;
+                return std::less<const SwapIndex*>()(swapIndex.get(),
+                                                     other.swapIndex.get());
+            }
+        };
+        // optionlet prices are stored together with the accrual
+        // period they were computed for
+        typedef std::map<std::pair<Option::Type, Real>,
+                         std::pair<Time, Real> > OptionletPrices;
+        struct ReplicationData {
+            DiscountFactor discount;
+            Rate swapRateValue;
+            Real annuity;
+            Period swapTenor;
+            boost::shared_ptr<GFunction> gFunction;
+            boost::shared_ptr<VanillaOptionPricer> vanillaOptionPricer;
+            OptionletPrices optionletPrices;
+        };
+        // smile sections are shared by coupons with the same fixing
+        // date and swap tenor, keyed by (length, units) of the tenor
+        typedef std::map<std::pair<Date, std::pair<Integer, Integer> >,
+                         boost::shared_ptr<SmileSection> > SmileSections;
+        void clearCache() const;
+        mutable std::map<ReplicationKey, ReplicationData> replications_;
+        mutable SmileSections smileSections_;
+        mutable ReplicationData* replication_;
+        mutable Date cacheDate_;
     };
 
 
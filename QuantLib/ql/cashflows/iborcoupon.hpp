@@ -53,6 +53,12 @@ namespace QuantLib {
         const boost::shared_ptr<IborIndex>& iborIndex() const {
             return iborIndex_;
         }
+        //! start of the period the fixing is forecast on
+        const Date& fixingValueDate() const { return fixingValueDate_; }
+        //! end of the period the fixing is forecast on
+        const Date& fixingEndDate() const { return fixingEndDate_; }
+        //! length of the period the fixing is forecast on
+        Time spanningTime() const { return spanningTime_; }
         //@}
         //! \name FloatingRateCoupon interface
         //@{
@@ -34,61 +34,85 @@ namespace QuantLib {
 
         class OvernightIndexedCouponPricer : public FloatingRateCouponPricer {
           public:
+            OvernightIndexedCouponPricer()
+            : coupon_(0), fixed_(0), fixedCompoundFactor_(1.0) {}
             void initialize(const FloatingRateCoupon& coupon) {
-                coupon_ = dynamic_cast<const OvernightIndexedCoupon*>(&coupon);
-                QL_ENSURE(coupon_, "wrong coupon type");
+                const OvernightIndexedCoupon* c =
+                    dynamic_cast<const OvernightIndexedCoupon*>(&coupon);
+                QL_ENSURE(c, "wrong coupon type");
+                if (c != coupon_) {
+                    if (index_)
+                        unregisterWith(index_);
+                    coupon_ = c;
+                    index_ = dynamic_pointer_cast<OvernightIndex>(c->index());
+                    registerWith(index_);
+                    resetFixedPart();
+                }
+            }
+            void update() {
+                // the fixings might have changed
+                resetFixedPart();
+                notifyObservers();
             }
             Rate swapletRate() const {
 
-                shared_ptr<OvernightIndex> index =
-                    dynamic_pointer_cast<OvernightIndex>(coupon_->index());
-
                 const vector<Date>& fixingDates = coupon_->fixingDates();
                 const vector<Time>& dt = coupon_->dt();
 
-                Size n = dt.size(),
-                     i = 0;
+                Size n = dt.size();
 
-                Real compoundFactor = 1.0;
-
-                // already fixed part
+                // already fixed part; this only changes with the
+                // evaluation date or the fixings, so it's stored and,
+                // when the evaluation date moves forward, extended
                 Date today = Settings::instance().evaluationDate();
-                while (i<n && fixingDates[i]<today) {
-                    // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
-                    QL_REQUIRE(pastFixing != Null<Real>(),
-                               "Missing " << index->name() <<
-                               " fixing for " << fixingDates[i]);
-                    compoundFactor *= (1.0 + pastFixing*dt[i]);
-                    ++i;
-                }
+                if (today != fixedToday_) {
+                    if (today < fixedToday_)
+                        resetFixedPart();
+
+                    Size i = fixed_;
+                    while (i<n && fixingDates[i]<today) {
+                        // rate must have been fixed
+                        Rate pastFixing =
+                            index_->historicalFixing(fixingDates[i]);
+                        QL_REQUIRE(pastFixing != Null<Real>(),
+                                   "Missing " << index_->name() <<
+                                   " fixing for " << fixingDates[i]);
+                        fixedCompoundFactor_ *= (1.0 + pastFixing*dt[i]);
+                        fixed_ = ++i;
+                    }
 
-                // today is a border case
-                if (i<n && fixingDates[i] == today) {
-                    // might have been fixed
-                    try {
-                        Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
-                        if (pastFixing != Null<Real>()) {
-                            compoundFactor *= (1.0 + pastFixing*dt[i]);
-                            ++i;
-                        } else {
-                            ;   // fall through and forecast
+                    // today is a border case
+                    if (i<n && fixingDates[i] == today) {
+                        // might have been fixed
+                        try {
+                            Rate pastFixing =
+                                index_->historicalFixing(fixingDates[i]);
+                            if (pastFixing != Null<Real>()) {
+                                fixedCompoundFactor_ *=
+                                    (1.0 + pastFixing*dt[i]);
+                                fixed_ = ++i;
+                            } else {
+                                ;   // fall through and forecast
+                            }
+                        } catch (Error&) {
+                            ;       // fall through and forecast
                         }
-                    } catch (Error&) {
-                        ;       // fall through and forecast
                     }
+
+                    fixedToday_ = today;
                 }
 
+                Size i = fixed_;
+                Real compoundFactor = fixedCompoundFactor_;
+
                 // forward part using telescopic property in order
                 // to avoid the evaluation of multiple forward fixings
                 if (i<n) {
                     Handle<YieldTermStructure> curve =
-                        index->forwardingTermStructure();
+                        index_->forwardingTermStructure();
                     QL_REQUIRE(!curve.empty(),
                                "null term structure set to this instance of "<<
-                               index->name());
+                               index_->name());
 
                     const vector<Date>& dates = coupon_->valueDates();
                     DiscountFactor startDiscount = curve->discount(dates[i]);
@@ -107,7 +131,17 @@ namespace QuantLib {
             Real floorletPrice(Rate) const { QL_FAIL("floorletPrice not available"); }
             Rate floorletRate(Rate) const { QL_FAIL("floorletRate not available"); }
           protected:
+            void resetFixedPart() const {
+                fixedToday_ = Date();
+                fixed_ = 0;
+                fixedCompoundFactor_ = 1.0;
+            }
             const OvernightIndexedCoupon* coupon_;
+            shared_ptr<OvernightIndex> index_;
+            // compounding of the fixings known at fixedToday_
+            mutable Date fixedToday_;
+            mutable Size fixed_;
+            mutable Real fixedCompoundFactor_;
         };
     }
 
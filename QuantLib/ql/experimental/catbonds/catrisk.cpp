@@ -20,6 +20,9 @@
 #include <ql/experimental/catbonds/catrisk.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/cstdint.hpp>
+#include <istream>
+#include <ostream>
 
 namespace QuantLib {
 
@@ -134,4 +137,139 @@ namespace QuantLib {
     boost::shared_ptr<CatSimulation> BetaRisk::newSimulation(const Date& start, const Date& end) const {
         return boost::make_shared<BetaRiskSimulation>(start, end, maxLoss_, lambda_, alpha_, beta_);
     }
+    namespace {
+
+        template <class T>
+        void writeBinary(std::ostream& out, T x) {
+            out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+        }
+
+        template <class T>
+        T readBinary(std::istream& in) {
+            T x;
+            in.read(reinterpret_cast<char*>(&x), sizeof(T));
+            QL_REQUIRE(in, "unexpected end of event catalogue");
+            return x;
+        }
+
+        const boost::uint32_t catalogueTag = 0x51434550; // "QCEP"
+
+    }
+
+    CatPathSet::CatPathSet(Date start, Date end)
+    : start_(start), end_(end), offsets_(1, 0) {}
+
+    CatPathSet::CatPathSet(CatSimulation& simulation, Date start, Date end, Size maxPaths)
+    : start_(start), end_(end), offsets_(1, 0) {
+        offsets_.reserve(maxPaths+1);
+        std::vector<std::pair<Date, Real> > path;
+        while(size()<maxPaths && simulation.nextPath(path))
+            addPath(path);
+    }
+
+    CatPathSet::CatPathSet(std::istream& in) {
+        QL_REQUIRE(readBinary<boost::uint32_t>(in) == catalogueTag,
+                   "not an event catalogue");
+        start_ = Date(readBinary<boost::int32_t>(in));
+        end_ = Date(readBinary<boost::int32_t>(in));
+        boost::uint64_t paths = readBinary<boost::uint64_t>(in);
+        boost::uint64_t events = readBinary<boost::uint64_t>(in);
+        offsets_.reserve(paths+1);
+        dates_.reserve(events);
+        losses_.reserve(events);
+        offsets_.push_back(0);
+        for (Size i=0; i<paths; ++i) {
+            Size n = readBinary<boost::uint32_t>(in);
+            offsets_.push_back(offsets_.back()+n);
+        }
+        QL_REQUIRE(offsets_.back() == events,
+                   "inconsistent event count in catalogue");
+        for (Size i=0; i<events; ++i)
+            dates_.push_back(Date(readBinary<boost::int32_t>(in)));
+        for (Size i=0; i<events; ++i)
+            losses_.push_back(readBinary<double>(in));
+    }
+
+    void CatPathSet::addPath(const std::vector<std::pair<Date, Real> >& path) {
+        for (Size i=0; i<path.size(); ++i) {
+            dates_.push_back(path[i].first);
+            losses_.push_back(path[i].second);
+        }
+        offsets_.push_back(dates_.size());
+    }
+
+    void CatPathSet::path(Size i, std::vector<std::pair<Date, Real> >& path) const {
+        QL_REQUIRE(i<size(), "path " << i << " out of range [0, " << size() << ")");
+        path.resize(0);
+        for (Size j=offsets_[i]; j<offsets_[i+1]; ++j)
+            path.push_back(std::make_pair(dates_[j], losses_[j]));
+    }
+
+    void CatPathSet::save(std::ostream& out) const {
+        writeBinary<boost::uint32_t>(out, catalogueTag);
+        writeBinary<boost::int32_t>(out, start_.serialNumber());
+        writeBinary<boost::int32_t>(out, end_.serialNumber());
+        writeBinary<boost::uint64_t>(out, size());
+        writeBinary<boost::uint64_t>(out, dates_.size());
+        for (Size i=0; i<size(); ++i)
+            writeBinary<boost::uint32_t>(out, events(i));
+        for (Size j=0; j<dates_.size(); ++j)
+            writeBinary<boost::int32_t>(out, dates_[j].serialNumber());
+        for (Size j=0; j<losses_.size(); ++j)
+            writeBinary<double>(out, losses_[j]);
+        QL_REQUIRE(out, "could not write event catalogue");
+    }
+
+    CatPathSetSimulation::CatPathSetSimulation(const boost::shared_ptr<CatPathSet>& paths)
+    : CatSimulation(paths->startDate(), paths->endDate()), paths_(paths), i_(0) {}
+
+    bool CatPathSetSimulation::nextPath(std::vector<std::pair<Date, Real> > &path) {
+        if (i_>=paths_->size()) {
+            path.resize(0);
+            return false;
+        }
+        paths_->path(i_++, path);
+        return true;
+    }
+
+    CachedCatRisk::CachedCatRisk(const boost::shared_ptr<CatRisk>& catRisk, 
+                                 Size maxPaths)
+    : catRisk_(catRisk), maxPaths_(maxPaths) {}
+
+    boost::shared_ptr<CatSimulation> CachedCatRisk::newSimulation(const Date& start, const Date& end) const {
+        return boost::make_shared<CatPathSetSimulation>(paths(start, end));
+    }
+
+    boost::shared_ptr<CatPathSet> CachedCatRisk::paths(const Date& start, const Date& end) const {
+        std::pair<Date, Date> period(start, end);
+        boost::shared_ptr<CatPathSet> cached;
+        #pragma omp critical(ql_cat_risk_paths)
+        {
+            std::map<std::pair<Date, Date>, boost::shared_ptr<CatPathSet> >::const_iterator i = paths_.find(period);
+            if (i != paths_.end())
+                cached = i->second;
+        }
+        if (cached)
+            return cached;
+
+        // simulated outside the lock, since it might throw; if another
+        // thread stored the same period meanwhile, its paths are kept
+        QL_REQUIRE(catRisk_, "no paths available from " << start << " to " << end);
+        boost::shared_ptr<CatSimulation> simulation = catRisk_->newSimulation(start, end);
+        boost::shared_ptr<CatPathSet> result(
+                          new CatPathSet(*simulation, start, end, maxPaths_));
+        #pragma omp critical(ql_cat_risk_paths)
+        result = paths_.insert(std::make_pair(period, result)).first->second;
+        return result;
+    }
+
+    void CachedCatRisk::add(const boost::shared_ptr<CatPathSet>& paths) {
+        #pragma omp critical(ql_cat_risk_paths)
+        paths_[std::make_pair(paths->startDate(), paths->endDate())] = paths;
+    }
+
+    void CachedCatRisk::clear() {
+        #pragma omp critical(ql_cat_risk_paths)
+        paths_.clear();
+    }
 }
@@ -35,6 +35,8 @@
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
 #endif
+#include <iosfwd>
+#include <map>
 #include <vector>
 
 namespace QuantLib {
@@ -130,6 +132,74 @@ namespace QuantLib {
 	    Real beta_;
     };
 
+    //! compact storage of simulated event paths
+    /*! Events of all paths are kept in flat arrays indexed by the
+        offsets of the paths, so that large event sets can be
+        simulated once, shared across instruments and saved to (or
+        read from) a binary event catalogue.
+    */
+    class CatPathSet {
+      public:
+        CatPathSet(Date start, 
+                   Date end);
+        //! stores at most \p maxPaths paths of the given simulation
+        CatPathSet(CatSimulation& simulation, 
+                   Date start, 
+                   Date end, 
+                   Size maxPaths);
+        //! reads a catalogue written by save()
+        explicit CatPathSet(std::istream& in);
+
+        void addPath(const std::vector<std::pair<Date, Real> >& path);
+        void save(std::ostream& out) const;
+
+        const Date& startDate() const { return start_; }
+        const Date& endDate() const { return end_; }
+        Size size() const { return offsets_.size()-1; }
+        Size events(Size i) const { return offsets_[i+1]-offsets_[i]; }
+        void path(Size i, std::vector<std::pair<Date, Real> >& path) const;
+      private:
+        Date start_;
+        Date end_;
+        std::vector<Size> offsets_;
+        std::vector<Date> dates_;
+        std::vector<Real> losses_;
+    };
+
+    //! replays the paths stored in a CatPathSet
+    class CatPathSetSimulation : public CatSimulation {
+      public:
+        CatPathSetSimulation(const boost::shared_ptr<CatPathSet>& paths);
+        virtual bool nextPath(std::vector<std::pair<Date, Real> > &path);
+      private:
+        boost::shared_ptr<CatPathSet> paths_;
+        Size i_;
+    };
+
+    //! cat risk whose simulated paths are generated once per period
+    /*! Paths are stored the first time a period is requested and are
+        shared by all simulations (and engines) for the same period.
+        Path sets read from a catalogue can be added directly; the
+        underlying risk can then be null.  Access to the stored
+        paths is serialized, so that engines sharing the risk can
+        be calculated in parallel.
+    */
+    class CachedCatRisk : public CatRisk {
+      public:
+        CachedCatRisk(const boost::shared_ptr<CatRisk>& catRisk, 
+                      Size maxPaths = 10000);
+
+        boost::shared_ptr<CatSimulation> newSimulation(const Date& start, const Date& end) const;
+        boost::shared_ptr<CatPathSet> paths(const Date& start, const Date& end) const;
+
+        void add(const boost::shared_ptr<CatPathSet>& paths);
+        void clear();
+      private:
+        boost::shared_ptr<CatRisk> catRisk_;
+        Size maxPaths_;
+        mutable std::map<std::pair<Date, Date>, boost::shared_ptr<CatPathSet> > paths_;
+    };
+
 }
 
 #endif
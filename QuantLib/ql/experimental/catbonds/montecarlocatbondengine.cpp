@@ -20,6 +20,7 @@
 #include <ql/experimental/catbonds/montecarlocatbondengine.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -86,27 +87,80 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real totalNPV = 0.0;
         Date effectiveDate = std::max(arguments_.startDate, settlementDate);
         Date maturityDate = (*arguments_.cashflows.rbegin())->date();
-        boost::shared_ptr<CatSimulation> catSimulation = catRisk_->newSimulation(effectiveDate, maturityDate);
-        std::vector<std::pair<Date, Real> > eventsPath;
-        NotionalPath notionalPath;
-        Real riskFreeNPV = pathNpv(includeSettlementDateFlows, settlementDate, notionalPath);
-        size_t pathCount=0;
-        while(catSimulation->nextPath(eventsPath) && pathCount<MAX_PATHS)
-        {
-            arguments_.notionalRisk->updatePath(eventsPath, notionalPath);
-            if(notionalPath.loss()>0) { //optimization, most paths will not include any loss
-                totalNPV += pathNpv(includeSettlementDateFlows, settlementDate, notionalPath);
-                lossProbability+=1;
-                if (notionalPath.loss()==1) 
-                    exhaustionProbability+=1;
-                expectedLoss+=notionalPath.loss();
-            } else {
-                totalNPV += riskFreeNPV;
+
+        // paths are shared with other engines when the risk caches them
+        boost::shared_ptr<CatPathSet> paths;
+        boost::shared_ptr<CachedCatRisk> cachedRisk =
+            boost::dynamic_pointer_cast<CachedCatRisk>(catRisk_);
+        if (cachedRisk) {
+            paths = cachedRisk->paths(effectiveDate, maturityDate);
+        } else {
+            boost::shared_ptr<CatSimulation> catSimulation = catRisk_->newSimulation(effectiveDate, maturityDate);
+            paths = boost::shared_ptr<CatPathSet>(
+                new CatPathSet(*catSimulation, effectiveDate, maturityDate, MAX_PATHS));
+        }
+        QL_REQUIRE(paths->size() > 0, "no event paths available");
+
+        // discounted amounts don't depend on the path
+        std::vector<Date> dates;
+        std::vector<Real> discountedAmounts;
+        for (Size i=0; i<arguments_.cashflows.size(); ++i) {
+            const boost::shared_ptr<CashFlow>& cf = arguments_.cashflows[i];
+            if (!cf->hasOccurred(settlementDate, includeSettlementDateFlows)) {
+                dates.push_back(cf->date());
+                discountedAmounts.push_back(cf->amount()*discountCurve_->discount(cf->date()));
+            }
+        }
+        Real riskFreeNPV = 0.0;
+        for (Size j=0; j<discountedAmounts.size(); ++j)
+            riskFreeNPV += discountedAmounts[j];
+
+        // paths are split in a fixed number of blocks whose partial
+        // sums are added in order, so that results don't depend on
+        // the number of threads
+        const long pathCount = paths->size();
+        const long blocks = std::min<long>(pathCount, 64);
+        std::vector<Real> totalNPVs(blocks, 0.0), losses(blocks, 0.0),
+                          exhaustions(blocks, 0.0), expectedLosses(blocks, 0.0);
+        std::vector<std::string> errors(blocks);
+        #pragma omp parallel for
+        for (long b=0; b<blocks; ++b) {
+            try {
+                std::vector<std::pair<Date, Real> > eventsPath;
+                NotionalPath notionalPath;
+                for (long i=b*pathCount/blocks; i<(b+1)*pathCount/blocks; ++i) {
+                    if (paths->events(i) == 0) { // no events, no loss
+                        totalNPVs[b] += riskFreeNPV;
+                        continue;
+                    }
+                    paths->path(i, eventsPath);
+                    arguments_.notionalRisk->updatePath(eventsPath, notionalPath);
+                    if(notionalPath.loss()>0) { //optimization, most paths will not include any loss
+                        for (Size j=0; j<discountedAmounts.size(); ++j)
+                            totalNPVs[b] += discountedAmounts[j]*notionalPath.notionalRate(dates[j]);
+                        losses[b]+=1;
+                        if (notionalPath.loss()==1)
+                            exhaustions[b]+=1;
+                        expectedLosses[b]+=notionalPath.loss();
+                    } else {
+                        totalNPVs[b] += riskFreeNPV;
+                    }
+                }
+            } catch (std::exception& e) {
+                errors[b] = e.what();
+            } catch (...) {
+                errors[b] = "unknown error";
             }
-            pathCount++;
+        }
+        Real totalNPV = 0.0;
+        for (long b=0; b<blocks; ++b) {
+            QL_REQUIRE(errors[b].empty(), errors[b]);
+            totalNPV += totalNPVs[b];
+            lossProbability += losses[b];
+            exhaustionProbability += exhaustions[b];
+            expectedLoss += expectedLosses[b];
         }
         lossProbability/=pathCount;
         exhaustionProbability/=pathCount;
@@ -114,23 +168,4 @@ namespace QuantLib {
         return totalNPV/(pathCount*discountCurve_->discount(npvDate));
     }
 
-    Real MonteCarloCatBondEngine::pathNpv(bool includeSettlementDateFlows, 
-                                          Date settlementDate, 
-                                          const NotionalPath& notionalPath) const {
-        Real totalNPV = 0.0;
-        for (Size i=0; i<arguments_.cashflows.size(); ++i) {
-            if (!arguments_.cashflows[i]->hasOccurred(settlementDate, 
-                                        includeSettlementDateFlows)) {
-                Real amount = cashFlowRiskyValue(arguments_.cashflows[i], notionalPath);
-                totalNPV += amount * discountCurve_->discount(arguments_.cashflows[i]->date());
-            }
-        }
-        return totalNPV;
-    }
-
-    Real MonteCarloCatBondEngine::cashFlowRiskyValue(const boost::shared_ptr<CashFlow> cf, 
-                                                     const NotionalPath& notionalPath) const {
-        return cf->amount()*notionalPath.notionalRate(cf->date()); //TODO: fix for more complicated cashflows
-    }
-
 }
@@ -28,6 +28,11 @@
 
 namespace QuantLib {
 
+    //! Monte Carlo pricing engine for cat bonds
+    /*! When the risk is a CachedCatRisk, the simulated event paths
+        are shared with all other engines using the same risk;
+        otherwise, they are simulated at each calculation.
+    */
     class MonteCarloCatBondEngine :
         public CatBond::engine
     {
@@ -42,19 +47,12 @@ namespace QuantLib {
             return discountCurve_;
         }
     protected:
-        Real cashFlowRiskyValue(const boost::shared_ptr<CashFlow> cf, 
-                                const NotionalPath& notionalPath) const;
-
         Real npv(bool includeSettlementDateFlows, 
                  Date settlementDate, 
                  Date npvDate, 
                  Real& lossProbability, 
                  Real& exhaustionProbability, 
                  Real& expectedLoss) const;
-
-        Real pathNpv(bool includeSettlementDateFlows, 
-                     Date settlementDate, 
-                     const NotionalPath& notionalPath) const;
       private:
         boost::shared_ptr<CatRisk> catRisk_;
         Handle<YieldTermStructure> discountCurve_;
@@ -45,8 +45,10 @@ namespace QuantLib {
         const boost::shared_ptr<Integrator> &integrator)
         : CmsCouponPricer(swaptionVol), meanReversion_(meanReversion),
           couponDiscountCurve_(couponDiscountCurve), settings_(settings),
-          volDayCounter_(swaptionVol->dayCounter()), integrator_(integrator) {
+          volDayCounter_(swaptionVol->dayCounter()), integrator_(integrator),
+          replication_(0) {
 
+        registerWith(meanReversion_);
         if (!couponDiscountCurve_.empty())
             registerWith(couponDiscountCurve_);
 
@@ -109,6 +111,40 @@ namespace QuantLib {
         // coupon discount curve.
 
         today_ = QuantLib::Settings::instance().evaluationDate();
+        if (today_ != cacheDate_) {
+            clearCache();
+            cacheDate_ = today_;
+        }
+
+        ReplicationKey key;
+        key.fixingDate = fixingDate_;
+        key.paymentDate = paymentDate_;
+        key.swapIndex = swapIndex_;
+        std::map<ReplicationKey, ReplicationData>::iterator cached =
+            replications_.find(key);
+        if (cached != replications_.end()) {
+            replication_ = &(cached->second);
+            couponDiscountRatio_ = replication_->couponDiscountRatio;
+            spreadLegValue_ = spread_ * coupon_->accrualPeriod() *
+                              discountCurve_->discount(paymentDate_) *
+                              couponDiscountRatio_;
+            if (fixingDate_ > today_) {
+                swapTenor_ = replication_->swapTenor;
+                swap_ = replication_->swap;
+                swapRateValue_ = replication_->swapRateValue;
+                annuity_ = replication_->annuity;
+                smileSection_ = replication_->smileSection;
+                a_ = replication_->a;
+                b_ = replication_->b;
+            }
+            return;
+        }
+
+        // the stored data depend on the index curves; registering
+        // once per stored result is enough
+        registerWith(swapIndex_);
+        if (replications_.size() >= maxReplications())
+            clearCache();
 
         if (paymentDate_ > today_ && !couponDiscountCurve_.empty())
             couponDiscountRatio_ =
@@ -129,8 +165,13 @@ namespace QuantLib {
             swapRateValue_ = swap_->fairRate();
             annuity_ = 1.0E4 * std::fabs(swap_->fixedLegBPS());
 
-            boost::shared_ptr<SmileSection> sectionTmp =
-                swaptionVolatility()->smileSection(fixingDate_, swapTenor_);
+            boost::shared_ptr<SmileSection> &sectionTmp =
+                smileSections_[std::make_pair(
+                    fixingDate_, std::make_pair(swapTenor_.length(),
+                                                Integer(swapTenor_.units())))];
+            if (!sectionTmp)
+                sectionTmp =
+                    swaptionVolatility()->smileSection(fixingDate_, swapTenor_);
 
             // if the section does not provide an atm level, we enhance it to
             // have one, no need to exit with an exception ...
@@ -165,6 +206,29 @@ namespace QuantLib {
             b_ = discountCurve_->discount(paymentDate_) / gy -
                  a_ * swapRateValue_;
         }
+
+        replication_ = &replications_[key];
+        replication_->couponDiscountRatio = couponDiscountRatio_;
+        if (fixingDate_ > today_) {
+            replication_->swapTenor = swapTenor_;
+            replication_->swap = swap_;
+            replication_->swapRateValue = swapRateValue_;
+            replication_->annuity = annuity_;
+            replication_->smileSection = smileSection_;
+            replication_->a = a_;
+            replication_->b = b_;
+        }
+    }
+
+    void LinearTsrPricer::clearCache() const {
+        replications_.clear();
+        smileSections_.clear();
+        replication_ = 0;
+    }
+
+    void LinearTsrPricer::update() {
+        clearCache();
+        CmsCouponPricer::update();
     }
 
     Real LinearTsrPricer::strikeFromVegaRatio(Real ratio,
@@ -305,6 +369,31 @@ namespace QuantLib {
                coupon_->accrualPeriod();
     }
 
+    Real LinearTsrPricer::cachedOptionletPrice(Option::Type optionType,
+                                               Real strike) const {
+        if (!replication_)
+            return optionletPrice(optionType, strike);
+        Time accrualPeriod = coupon_->accrualPeriod();
+        std::pair<OptionletPrices::iterator, bool> i =
+            replication_->optionletPrices.insert(std::make_pair(
+                std::make_pair(optionType, strike),
+                std::make_pair(accrualPeriod, Real(0.0))));
+        if (i.second) {
+            try {
+                i.first->second.second = optionletPrice(optionType, strike);
+            } catch (...) {
+                replication_->optionletPrices.erase(i.first);
+                throw;
+            }
+            return i.first->second.second;
+        }
+        // optionlet prices scale with the accrual period
+        const std::pair<Time, Real> &cached = i.first->second;
+        if (cached.first == accrualPeriod)
+            return cached.second;
+        return cached.second * (accrualPeriod / cached.first);
+    }
+
     Real LinearTsrPricer::meanReversion() const { return meanReversion_->value(); }
 
     Rate LinearTsrPricer::swapletRate() const {
@@ -325,7 +414,7 @@ namespace QuantLib {
                  discountCurve_->discount(paymentDate_) * couponDiscountRatio_);
             return price;
         } else {
-            Real capletPrice = optionletPrice(Option::Call, effectiveCap);
+            Real capletPrice = cachedOptionletPrice(Option::Call, effectiveCap);
             return gearing_ * capletPrice;
         }
     }
@@ -348,7 +437,7 @@ namespace QuantLib {
                  discountCurve_->discount(paymentDate_) * couponDiscountRatio_);
             return price;
         } else {
-            Real floorletPrice = optionletPrice(Option::Put, effectiveFloor);
+            Real floorletPrice = cachedOptionletPrice(Option::Put, effectiveFloor);
             return gearing_ * floorletPrice;
         }
     }
@@ -369,8 +458,10 @@ namespace QuantLib {
                  discountCurve_->discount(paymentDate_) * couponDiscountRatio_);
             return price;
         } else {
-            Real atmCapletPrice = optionletPrice(Option::Call, swapRateValue_);
-            Real atmFloorletPrice = optionletPrice(Option::Put, swapRateValue_);
+            Real atmCapletPrice =
+                cachedOptionletPrice(Option::Call, swapRateValue_);
+            Real atmFloorletPrice =
+                cachedOptionletPrice(Option::Put, swapRateValue_);
             return gearing_ * (coupon_->accrualPeriod() *
                                    discountCurve_->discount(paymentDate_) *
                                    swapRateValue_ * couponDiscountRatio_ +
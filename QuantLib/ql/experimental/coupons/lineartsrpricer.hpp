@@ -28,6 +28,7 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/indexes/swapindex.hpp>
 #include <ql/math/integrals/integral.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -46,6 +47,14 @@ namespace QuantLib {
         - by defining the lower and upper bound to be the strike where
           undeflated (!) payer resp. receiver prices are below a given
           threshold
+
+        The replication results are stored and reused by coupons with
+        the same fixing date, payment date and swap index; at most
+        maxReplications() of them are kept.
+
+        \warning as the coupon data set by initialize(), the stored
+                 results are not synchronized: a pricer must not be
+                 shared by coupons priced concurrently.
     */
 
     class LinearTsrPricer : public CmsCouponPricer, public MeanRevertingPricer {
@@ -117,12 +126,16 @@ namespace QuantLib {
         virtual Rate floorletRate(Rate effectiveFloor) const;
         /* */
         Real meanReversion() const;
+        //! maximum number of stored replication results
+        static Size maxReplications() { return 1000; }
         void setMeanReversion(const Handle<Quote> &meanReversion) {
             unregisterWith(meanReversion_);
             meanReversion_ = meanReversion;
             registerWith(meanReversion_);
             update();
         }
+        //! Observer interface
+        void update();
 
 
       private:
@@ -158,6 +171,7 @@ namespace QuantLib {
 
         void initialize(const FloatingRateCoupon &coupon);
         Real optionletPrice(Option::Type optionType, Real strike) const;
+        Real cachedOptionletPrice(Option::Type optionType, Real strike) const;
         Real strikeFromVegaRatio(Real ratio, Option::Type optionType,
                                  Real referenceStrike) const;
         Real strikeFromPrice(Real price, Option::Type optionType,
@@ -184,6 +198,40 @@ namespace QuantLib {
         Settings settings_;
         DayCounter volDayCounter_;
         boost::shared_ptr<Integrator> integrator_;
+
+        // replication data shared by coupons with the same fixing date,
+        // payment date and swap index until the market data change
+        // holding the index prevents its address from being reused
+        struct ReplicationKey {
+            Date fixingDate, paymentDate;
+            boost::shared_ptr<SwapIndex> swapIndex;
+            bool operator<(const ReplicationKey &other) const {
+                if (fixingDate != other.fixingDate)
+                    return fixingDate < other.fixingDate;
+                if (paymentDate != other.paymentDate)
+                    return paymentDate < other.paymentDate;
+                return std::less<const SwapIndex *>()(swapIndex.get(),
+                                                      other.swapIndex.get());
+            }
+        };
+        // optionlet prices are stored with the accrual period they were
+        // computed for
+        typedef std::map<std::pair<Option::Type, Real>,
+                         std::pair<Time, Real> > OptionletPrices;
+        struct ReplicationData {
+            Real couponDiscountRatio, swapRateValue, annuity, a, b;
+            Period swapTenor;
+            boost::shared_ptr<VanillaSwap> swap;
+            boost::shared_ptr<SmileSection> smileSection;
+            OptionletPrices optionletPrices;
+        };
+        typedef std::map<std::pair<Date, std::pair<Integer, Integer> >,
+                         boost::shared_ptr<SmileSection> > SmileSections;
+        void clearCache() const;
+        mutable std::map<ReplicationKey, ReplicationData> replications_;
+        mutable SmileSections smileSections_;
+        mutable ReplicationData *replication_;
+        mutable Date cacheDate_;
     };
 }
 
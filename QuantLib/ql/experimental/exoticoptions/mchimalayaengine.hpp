@@ -71,9 +71,12 @@ namespace QuantLib {
             typename RNG::rsg_type gen =
                 RNG::make_sequence_generator(numAssets*(grid.size()-1),seed_);
 
+            // paths are generated in blocks, so that the correlation
+            // is applied to many paths at once
             return boost::shared_ptr<path_generator_type>(
-                         new path_generator_type(processes_,
-                                                 grid, gen, brownianBridge_));
+                new path_generator_type(processes_, grid, gen,
+                                        brownianBridge_,
+                                        path_generator_type::defaultPathBlock));
         }
         boost::shared_ptr<path_pricer_type> pathPricer() const;
 
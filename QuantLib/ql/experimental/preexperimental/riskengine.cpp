@@ -214,12 +214,32 @@ namespace QuantLib {
 		int n = data.size();
 		Matrix corr(n,n);
 
-		// pointwise estimation
+		for(int i=1;i<n;i++) {
+			QL_REQUIRE(data[i].size()==data[0].size(),"vectors are of different dimensions (" << data[0].size() << "," << data[i].size() << ")");
+		}
+		if(n>0) {
+			QL_REQUIRE(start<=data[0].size(),"number of start values " << start << " have to be le number of data points (" << data[0].size() << ")");
+		}
 
-		for(int i=0;i<n;i++) {
-			for(int j=0;j<i;j++) {
-				corr[i][j]=corr[j][i] = naive ? naiveCorr(data[i],data[j],start,lambda) : sin( M_PI/2.0* kendallsTau(data[i],data[j],start,lambda) );
+		// pointwise estimation, the pairs for kendalls tau are computed in parallel
+		// by the library, which rethrows any error after all pairs are done
+
+		if(naive) {
+			for(int i=1;i<n;i++) {
+				for(int j=0;j<i;j++) {
+					corr[i][j]=corr[j][i] = naiveCorr(data[i],data[j],start,lambda);
+				}
+			}
+		}
+		else if(n>0) {
+			Matrix tau = QuantLib::kendallsTauMatrix(data, kendallsWeights(data[0].size(),start,lambda));
+			for(int i=1;i<n;i++) {
+				for(int j=0;j<i;j++) {
+					corr[i][j]=corr[j][i] = sin( M_PI/2.0* tau[i][j] );
+				}
 			}
+		}
+		for(int i=0;i<n;i++) {
 			corr[i][i]=1.0;
 		}
 
@@ -261,15 +281,7 @@ namespace QuantLib {
 
 	vector<double> RiskEngine::eigenvalues(vector<string> names,  int mode, bool naive, int start, double lambda) {
 		vector<vector<double>> data = consolidateData(names, mode);
-		int n = data.size();
-		Matrix corr(n,n);
-		// pointwise estimation
-		for(int i=0;i<n;i++) {
-			for(int j=0;j<i;j++) {
-				corr[i][j]=corr[j][i]=naive ? naiveCorr(data[i],data[j],start,lambda) : sin( M_PI/2.0* kendallsTau(data[i],data[j],start,lambda) );
-			}
-			corr[i][i]=1.0;
-		}
+		Matrix corr = correlation(data,false,naive,start,lambda);
 		SymmetricSchurDecomposition dec(corr);
 		return array2Vector(dec.eigenvalues());
 	}
@@ -333,41 +345,22 @@ namespace QuantLib {
 		
 		int n=d1.size();
 		QL_REQUIRE(d2.size()==n,"vectors are of different dimensions (" << d1.size() << "," << d2.size() << ")");
-		
-		double sum=0.0;
-		double t,res;
 
-		if(start==0) {
-			// unweighted
-			for(int i=0;i<n;i++) {
-				for(int j=0;j<i;j++) {
-					t=(d1[j]-d1[i])*(d2[j]-d2[i]);
-					if(t!=0.0) {
-						sum+= t > 0.0 ? 1.0 : -1.0;
-					}
-				}
-			}
-			res=2.0* sum / (((double)n)*((double)(n-1)));
-		}
-		else {
-			// weighted
-			double li,lj;
-			double denom=0.0;
+		return QuantLib::kendallsTau(d1,d2,kendallsWeights(n,start,lambda));
+
+	}
+
+	vector<double> RiskEngine::kendallsWeights(int n, int start, double lambda) {
+
+		// observation weights, a pair is weighted with the product of the weights of its observations
+		vector<double> w(n,1.0);
+		if(start!=0) {
+			double w0 = 1.0 / sqrt((double)start) * pow(lambda,(n-start)/2.0);
 			for(int i=0;i<n;i++) {
-				for(int j=0;j<i;j++) {
-					li = i<=start ? 1.0 / sqrt((double)start) * pow(lambda,(n-start)/2.0) : pow(lambda,n-i)*sqrt(1.0-lambda);
-					lj = j<=start ? 1.0 / sqrt((double)start) * pow(lambda,(n-start)/2.0) : pow(lambda,n-j)*sqrt(1.0-lambda);
-					t=(d1[j]-d1[i])*(d2[j]-d2[i]);
-					if(t!=0.0) {
-						sum+= li*lj* (t > 0.0 ? 1.0 : -1.0);
-					}
-					denom+=li*lj;
-				}
+				w[i] = i<=start ? w0 : pow(lambda,n-i)*sqrt(1.0-lambda);
 			}
-			res=sum / denom;
 		}
-
-		return res;
+		return w;
 
 	}
 
@@ -56,7 +56,8 @@ namespace QuantLib {
 			
 			long lookup(string name); // searches for series index, throws exception if not found
 			vector<double> transformData(const vector<double>& data, int mode=0); // transform given data, method: 0 = raw, 1 = abs diff, 2 = rel diff, 3 = log diff
-			double kendallsTau(const vector<double>& d1, const vector<double>& d2,int start=0, double lambda=0.0); // compute kendalls tau
+			double kendallsTau(const vector<double>& d1, const vector<double>& d2,int start=0, double lambda=0.0); // compute kendalls tau in O(n log n) (Knight)
+			vector<double> kendallsWeights(int n, int start, double lambda); // observation weights used by kendallsTau
 			double naiveCorr(const vector<double>& d1, const vector<double>& d2,int start=0, double lambda=0.0); // compute naive correlation coeff
 
 			vector<string> name_;
@@ -20,6 +20,8 @@
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/instrument.hpp>
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <algorithm>
 
 using std::vector;
 using std::pair;
@@ -285,6 +287,187 @@ namespace QuantLib {
         return result;
     }
 
+    pair<vector<Real>, vector<Real> >
+    parallelBucketAnalysis(const vector<vector<Handle<SimpleQuote> > >& quotes,
+                           const vector<vector<shared_ptr<Instrument> > >& instr,
+                           const vector<Real>& quant,
+                           Real shift,
+                           SensitivityAnalysis type)
+    {
+        QL_REQUIRE(!quotes.empty(), "no market replicas given");
+        Size nReplicas = quotes.size();
+        QL_REQUIRE(instr.size() == nReplicas,
+                   "dimension mismatch between quote replicas ("
+                   << nReplicas << ") and instrument replicas ("
+                   << instr.size() << ")");
+        Size n = quotes[0].size();
+        QL_REQUIRE(n > 0, "empty SimpleQuote vector");
+        for (Size r=1; r<nReplicas; ++r) {
+            QL_REQUIRE(quotes[r].size() == n,
+                       "replica #" << r << " has " << quotes[r].size()
+                       << " quotes, instead of " << n);
+            QL_REQUIRE(instr[r].size() == instr[0].size(),
+                       "replica #" << r << " has " << instr[r].size()
+                       << " instruments, instead of " << instr[0].size());
+        }
+        pair<vector<Real>, vector<Real> > result(vector<Real>(n, 0.0),
+                                                 vector<Real>(n, 0.0));
+
+        if (instr[0].empty()) return result;
+
+        // no more replicas than quotes are used
+        Size nWorkers = std::min(nReplicas, n);
+        vector<std::string> errors(nWorkers);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (Size r=0; r<nWorkers; ++r) {
+            try {
+                // the reference value also sets up the lazy objects of
+                // the replica, which are reused for each bump
+                Real npv = aggregateNPV(instr[r], quant);
+                Size begin = (r*n)/nWorkers, end = ((r+1)*n)/nWorkers;
+                for (Size i=begin; i<end; ++i) {
+                    pair<Real, Real> tmp =
+                        bucketAnalysis(quotes[r][i], instr[r], quant,
+                                       shift, type, npv);
+                    result.first[i] = tmp.first;
+                    result.second[i] = tmp.second;
+                }
+            } catch (std::exception& e) {
+                errors[r] = e.what();
+            } catch (...) {
+                errors[r] = "unknown error";
+            }
+        }
+
+        for (Size r=0; r<nWorkers; ++r)
+            QL_REQUIRE(errors[r].empty(),
+                       "replica #" << r << ": " << errors[r]);
+
+        return result;
+    }
+
+    vector<Real>
+    scenarioAnalysis(const vector<Handle<SimpleQuote> >& quotes,
+                     const vector<shared_ptr<Instrument> >& instruments,
+                     const vector<Real>& quantities,
+                     const vector<vector<Real> >& shifts,
+                     Real referenceNpv)
+    {
+        QL_REQUIRE(!quotes.empty(), "empty SimpleQuote vector");
+        Size n = quotes.size(), nScenarios = shifts.size();
+        for (Size s=0; s<nScenarios; ++s)
+            QL_REQUIRE(shifts[s].size() == n,
+                       "scenario #" << s << " has " << shifts[s].size()
+                       << " shifts, instead of " << n);
+
+        vector<Real> result(nScenarios, 0.0);
+        if (instruments.empty()) return result;
+
+        if (referenceNpv==Null<Real>())
+            referenceNpv = aggregateNPV(instruments, quantities);
+
+        vector<Real> quoteValues(n, Null<Real>());
+        for (Size i=0; i<n; ++i)
+            if (quotes[i]->isValid())
+                quoteValues[i] = quotes[i]->value();
+        try {
+            for (Size s=0; s<nScenarios; ++s) {
+                for (Size i=0; i<n; ++i)
+                    if (quoteValues[i]!=Null<Real>())
+                        quotes[i]->setValue(quoteValues[i]+shifts[s][i]);
+                result[s] = aggregateNPV(instruments, quantities)
+                          - referenceNpv;
+            }
+            for (Size i=0; i<n; ++i)
+                if (quoteValues[i]!=Null<Real>())
+                    quotes[i]->setValue(quoteValues[i]);
+        } catch (...) {
+            for (Size i=0; i<n; ++i)
+                if (quoteValues[i]!=Null<Real>())
+                    quotes[i]->setValue(quoteValues[i]);
+            throw;
+        }
+
+        return result;
+    }
+
+    vector<Real>
+    parallelScenarioAnalysis(const vector<vector<Handle<SimpleQuote> > >& quotes,
+                             const vector<vector<shared_ptr<Instrument> > >& instr,
+                             const vector<Real>& quant,
+                             const vector<vector<Real> >& shifts)
+    {
+        QL_REQUIRE(!quotes.empty(), "no market replicas given");
+        Size nReplicas = quotes.size();
+        QL_REQUIRE(instr.size() == nReplicas,
+                   "dimension mismatch between quote replicas ("
+                   << nReplicas << ") and instrument replicas ("
+                   << instr.size() << ")");
+        Size n = quotes[0].size();
+        QL_REQUIRE(n > 0, "empty SimpleQuote vector");
+        for (Size r=1; r<nReplicas; ++r) {
+            QL_REQUIRE(quotes[r].size() == n,
+                       "replica #" << r << " has " << quotes[r].size()
+                       << " quotes, instead of " << n);
+            QL_REQUIRE(instr[r].size() == instr[0].size(),
+                       "replica #" << r << " has " << instr[r].size()
+                       << " instruments, instead of " << instr[0].size());
+        }
+        Size nScenarios = shifts.size();
+        for (Size s=0; s<nScenarios; ++s)
+            QL_REQUIRE(shifts[s].size() == n,
+                       "scenario #" << s << " has " << shifts[s].size()
+                       << " shifts, instead of " << n);
+
+        vector<Real> result(nScenarios, 0.0);
+        if (instr[0].empty() || nScenarios == 0) return result;
+
+        // no more replicas than scenarios are used
+        Size nWorkers = std::min(nReplicas, nScenarios);
+        vector<std::string> errors(nWorkers);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (Size r=0; r<nWorkers; ++r) {
+            try {
+                Size begin = (r*nScenarios)/nWorkers,
+                     end = ((r+1)*nScenarios)/nWorkers;
+                vector<Real> pnl =
+                    scenarioAnalysis(quotes[r], instr[r], quant,
+                                     vector<vector<Real> >(
+                                                    shifts.begin()+begin,
+                                                    shifts.begin()+end));
+                std::copy(pnl.begin(), pnl.end(), result.begin()+begin);
+            } catch (std::exception& e) {
+                errors[r] = e.what();
+            } catch (...) {
+                errors[r] = "unknown error";
+            }
+        }
+
+        for (Size r=0; r<nWorkers; ++r)
+            QL_REQUIRE(errors[r].empty(),
+                       "replica #" << r << ": " << errors[r]);
+
+        return result;
+    }
+
+    pair<Real, Real>
+    historicalRiskAnalysis(const vector<vector<Handle<SimpleQuote> > >& quotes,
+                           const vector<vector<shared_ptr<Instrument> > >& instr,
+                           const vector<Real>& quant,
+                           const vector<vector<Real> >& shifts,
+                           Real percentile)
+    {
+        QL_REQUIRE(!shifts.empty(), "no scenarios given");
+        vector<Real> pnl =
+            parallelScenarioAnalysis(quotes, instr, quant, shifts);
+        RiskStatistics stats;
+        stats.addSequence(pnl.begin(), pnl.end());
+        return std::make_pair(stats.valueAtRisk(percentile),
+                              stats.expectedShortfall(percentile));
+    }
+
     void
     bucketAnalysis(std::vector<std::vector<Real> >& deltaMatrix, // result
                    std::vector<std::vector<Real> >& gammaMatrix, // result
@@ -138,6 +138,92 @@ namespace QuantLib {
                    Real shift = 0.0001,
                    SensitivityAnalysis type = Centered);
 
+    //! bucket PV01 sensitivity analysis on independent market replicas
+    /*! returns the same results as the bucketAnalysis() overload above,
+        but the work is shared among several replicas of the market.
+        Both quotes[r] and instruments[r] belong to the r-th replica:
+        quotes[r][i] must be the i-th quote as seen by that replica,
+        and instruments[r][k] the k-th instrument priced on it.  Each
+        replica bumps a contiguous block of quotes, one by one; the
+        replicas are processed in parallel when OpenMP is enabled.
+
+        Objects that do not depend on a bumped quote are not
+        recalculated, as with the serial version.
+
+        The replicas still share some global state: calendars (and
+        their business-day caches), the schedule cache and the index
+        fixings, which are synchronized and can be read concurrently,
+        and the evaluation date and other Settings.  None of them
+        can be modified during the analysis.
+
+        Results match the serial version up to the accuracy of any
+        iterative calculation involved; e.g., a bootstrapped curve
+        starts from its previous solution, which depends on the
+        buckets its replica processed before.
+
+        \warning the replicas must not share any lazy object, pricing
+                 engine, coupon pricer or quote, since they are
+                 modified concurrently.
+    */
+    std::pair<std::vector<Real>, std::vector<Real> >
+    parallelBucketAnalysis(
+        const std::vector<std::vector<Handle<SimpleQuote> > >& quotes,
+        const std::vector<std::vector<boost::shared_ptr<Instrument> > >&,
+        const std::vector<Real>& quantities,
+        Real shift = 0.0001,
+        SensitivityAnalysis type = Centered);
+
+    //! full-revaluation scenario analysis for a SimpleQuote vector
+    /*! returns the profit and loss of the portfolio, with respect to
+        the reference NPV, in each of the given scenarios.  In the
+        s-th scenario each quote is set to its current value plus
+        shifts[s][i], where i is the index of the quote; the quotes
+        are restored afterwards.
+
+        Empty quantities vector is considered as unit vector. The same if
+        the vector is of size one.
+    */
+    std::vector<Real>
+    scenarioAnalysis(const std::vector<Handle<SimpleQuote> >& quotes,
+                     const std::vector<boost::shared_ptr<Instrument> >&,
+                     const std::vector<Real>& quantities,
+                     const std::vector<std::vector<Real> >& shifts,
+                     Real referenceNpv = Null<Real>());
+
+    //! full-revaluation scenario analysis on independent market replicas
+    /*! returns the same results as scenarioAnalysis(), but the
+        scenarios are shared among several replicas of the market,
+        as in parallelBucketAnalysis(); each replica revalues a
+        contiguous block of scenarios, and the replicas are processed
+        in parallel when OpenMP is enabled.
+
+        The same requirements on the replicas apply as for
+        parallelBucketAnalysis().
+    */
+    std::vector<Real>
+    parallelScenarioAnalysis(
+        const std::vector<std::vector<Handle<SimpleQuote> > >& quotes,
+        const std::vector<std::vector<boost::shared_ptr<Instrument> > >&,
+        const std::vector<Real>& quantities,
+        const std::vector<std::vector<Real> >& shifts);
+
+    //! historical full-revaluation value at risk and expected shortfall
+    /*! returns the value at risk and the expected shortfall at the
+        given percentile of the profit-and-loss distribution obtained
+        by parallelScenarioAnalysis() for the given historical shifts,
+        each scenario having the same weight.  They are calculated as
+        in RiskStatistics and are thus expressed as non-negative losses.
+
+        \pre percentile must be in range [90%-100%)
+    */
+    std::pair<Real, Real>
+    historicalRiskAnalysis(
+        const std::vector<std::vector<Handle<SimpleQuote> > >& quotes,
+        const std::vector<std::vector<boost::shared_ptr<Instrument> > >&,
+        const std::vector<Real>& quantities,
+        const std::vector<std::vector<Real> >& shifts,
+        Real percentile = 0.99);
+
     //! bucket parameters' sensitivity analysis for a SimpleQuote vector
     /*! returns a vector (one element for each paramet) of pair of first and
         second derivative vectors calculated as prescribed by
@@ -42,6 +42,20 @@ namespace QuantLib {
                    forceOverwrite);
     }
 
+    Real Index::historicalFixing(const Date& fixingDate) const {
+        // the lookup is refreshed from const methods, possibly by
+        // several threads at once; each reader works on its own copy
+        IndexManager::FixingLookup lookup;
+        #pragma omp critical(ql_index_fixing_lookup)
+        {
+            if (!fixingLookup_.isValid())
+                fixingLookup_ =
+                    IndexManager::instance().fixingLookup(name());
+            lookup = fixingLookup_;
+        }
+        return lookup[fixingDate];
+    }
+
     void Index::clearFixings() {
         checkNativeFixingsAllowed();
         IndexManager::instance().clearHistory(name());
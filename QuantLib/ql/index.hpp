@@ -64,6 +64,13 @@ namespace QuantLib {
         const TimeSeries<Real>& timeSeries() const {
             return IndexManager::instance().getHistory(name());
         }
+        //! returns the (possibly null) stored fixing at the given date
+        /*! This is equivalent to <tt>timeSeries()[fixingDate]</tt>,
+            but the index history is only looked up by name the
+            first time (and after it was cleared) and the fixing is
+            then read by date in constant time.
+        */
+        Real historicalFixing(const Date& fixingDate) const;
         //! check if index allows for native fixings
         virtual void checkNativeFixingsAllowed() {}
         //! stores the historical fixing at the given date
@@ -130,6 +137,8 @@ namespace QuantLib {
         }
         //! clears all stored historical fixings
         void clearFixings();
+      private:
+        mutable IndexManager::FixingLookup fixingLookup_;
     };
 
 }
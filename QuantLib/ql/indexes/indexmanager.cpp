@@ -32,40 +32,109 @@ using std::string;
 
 namespace QuantLib {
 
+    BigNatural IndexManager::revision_ = 1;
+
+    void IndexManager::History::set(const TimeSeries<Real>& fixings) {
+        // the dense copy is rebuilt before observers are notified, so
+        // that readers never need to modify it
+        if (fixings.empty()) {
+            firstSerial = 0;
+            dense.clear();
+        } else {
+            firstSerial = fixings.firstDate().serialNumber();
+            dense.assign(fixings.lastDate().serialNumber() - firstSerial + 1,
+                         Null<Real>());
+            for (TimeSeries<Real>::const_iterator i = fixings.begin();
+                 i != fixings.end(); ++i)
+                dense[i->first.serialNumber() - firstSerial] = i->second;
+        }
+        series = fixings;
+    }
+
+    const boost::shared_ptr<IndexManager::History>&
+    IndexManager::history(const string& name) const {
+        string key = to_upper_copy(name);
+        // const accessors might insert new histories concurrently
+        boost::shared_ptr<History>* h;
+        #pragma omp critical(ql_index_manager)
+        {
+            h = &data_[key];
+            if (!*h)
+                *h = boost::shared_ptr<History>(new History);
+        }
+        return *h;
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        string key = to_upper_copy(name);
+        bool found;
+        #pragma omp critical(ql_index_manager)
+        found = data_.find(key) != data_.end();
+        return found;
     }
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        return history(name)->series.value();
     }
 
     void IndexManager::setHistory(const string& name,
-                                  const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+                                  const TimeSeries<Real>& fixings) {
+        history(name)->set(fixings);
     }
 
     boost::shared_ptr<Observable>
     IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        return history(name)->series;
+    }
+
+    IndexManager::FixingLookup
+    IndexManager::fixingLookup(const string& name) const {
+        FixingLookup lookup;
+        lookup.history_ = history(name);
+        lookup.revision_ = revision_;
+        return lookup;
     }
 
     std::vector<string> IndexManager::histories() const {
         std::vector<string> temp;
-        temp.reserve(data_.size());
-        for (history_map::const_iterator i=data_.begin();
-             i!=data_.end(); ++i)
-            temp.push_back(i->first);
+        #pragma omp critical(ql_index_manager)
+        {
+            temp.reserve(data_.size());
+            for (history_map::const_iterator i=data_.begin();
+                 i!=data_.end(); ++i)
+                temp.push_back(i->first);
+        }
         return temp;
     }
 
     void IndexManager::clearHistory(const string& name) {
-        data_.erase(to_upper_copy(name));
+        string key = to_upper_copy(name);
+        boost::shared_ptr<History> h;
+        #pragma omp critical(ql_index_manager)
+        {
+            history_map::iterator i = data_.find(key);
+            if (i != data_.end()) {
+                h = i->second;
+                data_.erase(i);
+                ++revision_;
+            }
+        }
+        // let observers know that the fixings are gone
+        if (h)
+            h->set(TimeSeries<Real>());
     }
 
     void IndexManager::clearHistories() {
-        data_.clear();
+        history_map histories;
+        #pragma omp critical(ql_index_manager)
+        {
+            histories.swap(data_);
+            ++revision_;
+        }
+        for (history_map::iterator i=histories.begin();
+             i!=histories.end(); ++i)
+            i->second->set(TimeSeries<Real>());
     }
 
 }
@@ -32,12 +32,37 @@
 namespace QuantLib {
 
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! \note index names are case insensitive
+
+        \warning histories can be read concurrently, but they must not
+                 be modified (set or cleared) while other threads are
+                 reading them.
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
       private:
         IndexManager() {}
+        struct History;
       public:
+        //! fast access to the stored fixings of an index
+        /*! The index name is resolved once, when the lookup is
+            obtained; fixings are then read from a dense copy of the
+            history, indexed by date serial number, which is rebuilt
+            whenever the history is set.  A lookup is no longer valid
+            once the history is cleared and must be obtained again.
+        */
+        class FixingLookup {
+            friend class IndexManager;
+          public:
+            FixingLookup() : revision_(0) {}
+            //! whether the lookup is still bound to a stored history
+            bool isValid() const;
+            //! returns the (possibly null) fixing at the given date
+            Real operator[](const Date& d) const;
+          private:
+            boost::shared_ptr<History> history_;
+            BigNatural revision_;
+        };
         //! returns whether historical fixings were stored for the index
         bool hasHistory(const std::string& name) const;
         //! returns the (possibly empty) history of the index fixings
@@ -49,15 +74,47 @@ namespace QuantLib {
         //! returns all names of the indexes for which fixings were stored
         std::vector<std::string> histories() const;
         //! clears the historical fixings of the index
+        /*! Observers of the history are notified. */
         void clearHistory(const std::string& name);
         //! clears all stored fixings
+        /*! Observers of the histories are notified. */
         void clearHistories();
+        //! returns a lookup for the stored fixings of the index
+        FixingLookup fixingLookup(const std::string& name) const;
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
+        struct History {
+            History() : firstSerial(0) {}
+            void set(const TimeSeries<Real>& fixings);
+            ObservableValue<TimeSeries<Real> > series;
+            // dense copy of the series; dates without fixings are null
+            std::vector<Real> dense;
+            BigInteger firstSerial;
+        };
+        const boost::shared_ptr<History>&
+        history(const std::string& name) const;
+        typedef std::map<std::string, boost::shared_ptr<History> >
                                                                   history_map;
         mutable history_map data_;
+        // bumped whenever histories are removed, which invalidates lookups
+        static BigNatural revision_;
     };
 
+
+    // inline definitions
+
+    inline bool IndexManager::FixingLookup::isValid() const {
+        return history_ && revision_ == IndexManager::revision_;
+    }
+
+    inline Real IndexManager::FixingLookup::operator[](const Date& d) const {
+        QL_REQUIRE(isValid(), "fixing lookup no longer valid");
+        const History& h = *history_;
+        BigInteger i = d.serialNumber() - h.firstSerial;
+        if (i < 0 || i >= BigInteger(h.dense.size()))
+            return Null<Real>();
+        return h.dense[i];
+    }
+
 }
 
 
@@ -50,7 +50,8 @@ namespace QuantLib {
       floatSpread_(0.0),
       floatDayCount_(index->dayCounter()),
       engine_(new DiscountingSwapEngine(iborIndex_->forwardingTermStructure(),
-                                        false))
+                                        false)),
+      cachedSchedules_(false)
     {
     }
 
@@ -100,19 +101,37 @@ namespace QuantLib {
                 fixedTenor = Period(1, Years);
         }
 
-        Schedule fixedSchedule(startDate, endDate,
-                               fixedTenor, fixedCalendar_,
-                               fixedConvention_,
-                               fixedTerminationDateConvention_,
-                               fixedRule_, fixedEndOfMonth_,
-                               fixedFirstDate_, fixedNextToLastDate_);
-
-        Schedule floatSchedule(startDate, endDate,
-                               floatTenor_, floatCalendar_,
-                               floatConvention_,
-                               floatTerminationDateConvention_,
-                               floatRule_, floatEndOfMonth_,
-                               floatFirstDate_, floatNextToLastDate_);
+        Schedule fixedSchedule, floatSchedule;
+        if (cachedSchedules_) {
+            ScheduleCache& cache = ScheduleCache::instance();
+            fixedSchedule = cache.schedule(startDate, endDate,
+                                           fixedTenor, fixedCalendar_,
+                                           fixedConvention_,
+                                           fixedTerminationDateConvention_,
+                                           fixedRule_, fixedEndOfMonth_,
+                                           fixedFirstDate_,
+                                           fixedNextToLastDate_);
+            floatSchedule = cache.schedule(startDate, endDate,
+                                           floatTenor_, floatCalendar_,
+                                           floatConvention_,
+                                           floatTerminationDateConvention_,
+                                           floatRule_, floatEndOfMonth_,
+                                           floatFirstDate_,
+                                           floatNextToLastDate_);
+        } else {
+            fixedSchedule = Schedule(startDate, endDate,
+                                     fixedTenor, fixedCalendar_,
+                                     fixedConvention_,
+                                     fixedTerminationDateConvention_,
+                                     fixedRule_, fixedEndOfMonth_,
+                                     fixedFirstDate_, fixedNextToLastDate_);
+            floatSchedule = Schedule(startDate, endDate,
+                                     floatTenor_, floatCalendar_,
+                                     floatConvention_,
+                                     floatTerminationDateConvention_,
+                                     floatRule_, floatEndOfMonth_,
+                                     floatFirstDate_, floatNextToLastDate_);
+        }
 
         DayCounter fixedDayCount;
         if (fixedDayCount_ != DayCounter())
@@ -200,6 +219,11 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeVanillaSwap& MakeVanillaSwap::withCachedSchedules(bool flag) {
+        cachedSchedules_ = flag;
+        return *this;
+    }
+
     MakeVanillaSwap& MakeVanillaSwap::withFixedLegTenor(const Period& t) {
         fixedTenor_ = t;
         return *this;
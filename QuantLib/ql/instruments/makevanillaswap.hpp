@@ -80,6 +80,10 @@ namespace QuantLib {
                               const Handle<YieldTermStructure>& discountCurve);
         MakeVanillaSwap& withPricingEngine(
                               const boost::shared_ptr<PricingEngine>& engine);
+        /*! share the leg schedules with other swaps built with the
+            same dates and conventions (see ScheduleCache)
+        */
+        MakeVanillaSwap& withCachedSchedules(bool flag = true);
       private:
         Period swapTenor_;
         boost::shared_ptr<IborIndex> iborIndex_;
@@ -102,6 +106,7 @@ namespace QuantLib {
         DayCounter fixedDayCount_, floatDayCount_;
 
         boost::shared_ptr<PricingEngine> engine_;
+        bool cachedSchedules_;
     };
 
 }
@@ -0,0 +1,291 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/instruments/portfolio.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    void Portfolio::add(const boost::shared_ptr<Instrument>& instrument,
+                        const boost::shared_ptr<PricingEngine>& engine) {
+        QL_REQUIRE(instrument, "null instrument");
+        if (engine)
+            instrument->setPricingEngine(engine);
+
+        boost::shared_ptr<DirtyFlag> flag(new DirtyFlag);
+        flag->registerWith(instrument);
+        instruments_.push_back(instrument);
+        instrumentFlags_.push_back(flag);
+        engines_.push_back(engine);
+        groupsAreValid_ = false;
+    }
+
+    void Portfolio::addSharedObject(
+                               const boost::shared_ptr<LazyObject>& object) {
+        QL_REQUIRE(object, "null shared object");
+        boost::shared_ptr<DirtyFlag> flag(new DirtyFlag);
+        flag->registerWith(object);
+        order_.push_back(sharedObjects_.size());
+        sharedObjects_.push_back(object);
+        sharedFlags_.push_back(flag);
+        dependents_.push_back(std::vector<Size>());
+    }
+
+    void Portfolio::addSequentialObject(
+                               const boost::shared_ptr<Observable>& object) {
+        QL_REQUIRE(object, "null sequential object");
+        sequentialObjects_.push_back(object);
+        groupsAreValid_ = false;
+    }
+
+    const boost::shared_ptr<Instrument>& Portfolio::instrument(Size i) const {
+        QL_REQUIRE(i < instruments_.size(),
+                   "instrument #" << i << " does not exist (only "
+                   << instruments_.size() << " instruments in portfolio)");
+        return instruments_[i];
+    }
+
+    bool Portfolio::isDirty(Size i) const {
+        QL_REQUIRE(i < instruments_.size(),
+                   "instrument #" << i << " does not exist (only "
+                   << instruments_.size() << " instruments in portfolio)");
+        return instrumentFlags_[i]->isDirty();
+    }
+
+    std::vector<Size> Portfolio::dirtyInstruments() const {
+        std::vector<Size> result;
+        for (Size i=0; i<instrumentFlags_.size(); ++i)
+            if (instrumentFlags_[i]->isDirty())
+                result.push_back(i);
+        return result;
+    }
+
+    void Portfolio::recalculateSharedObjects() {
+        Size n = sharedObjects_.size();
+        std::vector<bool> wasDirty(n);
+        // each pass either leaves all objects up to date or finds
+        // dependencies violating the current order; in the latter
+        // case the order is refined and another pass is made.
+        bool newDependencies = true;
+        while (newDependencies) {
+            newDependencies = false;
+            for (Size k=0; k<n; ++k) {
+                Size i = order_[k];
+                if (!sharedFlags_[i]->isDirty())
+                    continue;
+                for (Size j=0; j<n; ++j)
+                    wasDirty[j] = sharedFlags_[j]->isDirty();
+                sharedObjects_[i]->recalculate();
+                // recalculate() also notifies the flag of the object
+                sharedFlags_[i]->set(false);
+                for (Size j=0; j<n; ++j) {
+                    if (j != i && !wasDirty[j] &&
+                        sharedFlags_[j]->isDirty()) {
+                        // j was notified by i, hence it depends on it
+                        std::vector<Size>& d = dependents_[i];
+                        if (std::find(d.begin(), d.end(), j) == d.end()) {
+                            d.push_back(j);
+                            newDependencies = true;
+                        }
+                    }
+                }
+            }
+            if (newDependencies)
+                sortSharedObjects();
+        }
+    }
+
+    void Portfolio::sortSharedObjects() {
+        Size n = sharedObjects_.size();
+        std::vector<Size> inDegree(n, 0);
+        for (Size i=0; i<n; ++i)
+            for (Size k=0; k<dependents_[i].size(); ++k)
+                ++inDegree[dependents_[i][k]];
+        // among the objects ready to be calculated, pick the one
+        // added first so that the order is stable
+        std::vector<bool> done(n, false);
+        order_.clear();
+        while (order_.size() < n) {
+            Size next = n;
+            for (Size i=0; i<n && next==n; ++i)
+                if (!done[i] && inDegree[i] == 0)
+                    next = i;
+            QL_REQUIRE(next != n, "cyclic dependency between shared objects");
+            done[next] = true;
+            order_.push_back(next);
+            for (Size k=0; k<dependents_[next].size(); ++k)
+                --inDegree[dependents_[next][k]];
+        }
+    }
+
+    namespace {
+
+        Size root(std::vector<Size>& parent, Size i) {
+            while (parent[i] != i)
+                i = parent[i] = parent[parent[i]];
+            return i;
+        }
+
+        void join(std::vector<Size>& parent, Size i, Size j) {
+            i = root(parent, i);
+            j = root(parent, j);
+            // keep the smallest index as root so that groups are
+            // ordered by their first instrument
+            if (i < j)
+                parent[j] = i;
+            else if (j < i)
+                parent[i] = j;
+        }
+
+    }
+
+    void Portfolio::groupInstruments() {
+        Size n = instruments_.size();
+        std::vector<Size> parent(n);
+        for (Size i=0; i<n; ++i)
+            parent[i] = i;
+
+        // instruments sharing an engine
+        for (Size i=0; i<n; ++i) {
+            Size j = std::find(engines_.begin(), engines_.begin()+i,
+                               engines_[i]) - engines_.begin();
+            if (j < i)
+                join(parent, i, j);
+        }
+
+        // instruments sharing a sequential object, as found by the
+        // notifications it sends; the instruments it flags stay dirty
+        std::vector<bool> wasDirty(n);
+        for (Size k=0; k<sequentialObjects_.size(); ++k) {
+            for (Size i=0; i<n; ++i) {
+                wasDirty[i] = instrumentFlags_[i]->isDirty();
+                instrumentFlags_[i]->set(false);
+            }
+            sequentialObjects_[k]->notifyObservers();
+            Size first = n;
+            for (Size i=0; i<n; ++i) {
+                if (instrumentFlags_[i]->isDirty()) {
+                    if (first == n)
+                        first = i;
+                    else
+                        join(parent, i, first);
+                } else if (wasDirty[i]) {
+                    instrumentFlags_[i]->set(true);
+                }
+            }
+        }
+
+        groups_.clear();
+        std::vector<Size> groupOf(n, n);
+        for (Size i=0; i<n; ++i) {
+            Size r = root(parent, i);
+            if (groupOf[r] == n) {
+                groupOf[r] = groups_.size();
+                groups_.push_back(std::vector<Size>());
+            }
+            groups_[groupOf[r]].push_back(i);
+        }
+        groupsAreValid_ = true;
+    }
+
+    void Portfolio::recalculateSerially(std::vector<bool>& recalculated) {
+        for (Size i=0; i<instruments_.size(); ++i) {
+            if (!instrumentFlags_[i]->isDirty())
+                continue;
+            instrumentFlags_[i]->set(false);
+            try {
+                instruments_[i]->NPV();
+                recalculated[i] = true;
+            } catch (std::exception& e) {
+                instrumentFlags_[i]->set(true);
+                QL_FAIL("could not recalculate instrument #" << i
+                        << ": " << e.what());
+            } catch (...) {
+                instrumentFlags_[i]->set(true);
+                QL_FAIL("could not recalculate instrument #" << i
+                        << ": unknown error");
+            }
+        }
+    }
+
+    Size Portfolio::recalculate() {
+        recalculateSharedObjects();
+
+        Size n = instruments_.size();
+        std::vector<bool> wasRecalculated(n, false);
+        if (!groupsAreValid_) {
+            // an instrument forwards notifications only after being
+            // calculated; the instruments are calculated serially
+            // before the sequential objects look for them
+            if (!sequentialObjects_.empty())
+                recalculateSerially(wasRecalculated);
+            groupInstruments();
+        }
+
+        Size nGroups = groups_.size();
+        // one entry per instrument, since std::vector<bool> elements
+        // can't be written from different threads
+        std::vector<Size> recalculated(n, 0);
+        std::vector<Size> failed(nGroups, Null<Size>());
+        std::vector<std::string> errors(nGroups);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (Size g=0; g<nGroups; ++g) {
+            const std::vector<Size>& group = groups_[g];
+            for (Size k=0; k<group.size(); ++k) {
+                Size i = group[k];
+                if (!instrumentFlags_[i]->isDirty())
+                    continue;
+                instrumentFlags_[i]->set(false);
+                try {
+                    instruments_[i]->NPV();
+                    recalculated[i] = 1;
+                } catch (std::exception& e) {
+                    instrumentFlags_[i]->set(true);
+                    failed[g] = i;
+                    errors[g] = e.what();
+                    break;
+                } catch (...) {
+                    instrumentFlags_[i]->set(true);
+                    failed[g] = i;
+                    errors[g] = "unknown error";
+                    break;
+                }
+            }
+        }
+
+        for (Size g=0; g<nGroups; ++g)
+            QL_REQUIRE(failed[g] == Null<Size>(),
+                       "could not recalculate instrument #" << failed[g]
+                       << ": " << errors[g]);
+        Size result = 0;
+        for (Size i=0; i<n; ++i)
+            if (recalculated[i] != 0 || wasRecalculated[i])
+                ++result;
+        return result;
+    }
+
+    Real Portfolio::NPV() {
+        recalculate();
+        Real result = 0.0;
+        for (Size i=0; i<instruments_.size(); ++i)
+            result += instruments_[i]->NPV();
+        return result;
+    }
+
+}
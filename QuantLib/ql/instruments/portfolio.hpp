@@ -0,0 +1,152 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file portfolio.hpp
+    \brief set of instruments recalculated on demand
+*/
+
+#ifndef quantlib_portfolio_hpp
+#define quantlib_portfolio_hpp
+
+#include <ql/instrument.hpp>
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Set of instruments tracking which of them need recalculation
+    /*! The portfolio observes its instruments and a number of shared
+        intermediate objects (e.g., bootstrapped curves or volatility
+        cubes) and records which of them were notified of a change
+        since they were last calculated.  recalculate() brings the
+        dirty part of the portfolio up to date and leaves the rest
+        untouched.
+
+        Shared objects are recalculated first, on the calling
+        thread.  Whenever the recalculation of one of them notifies
+        another one, the latter is known to depend on the former;
+        these dependencies are used to keep the shared objects in
+        topological order, so that each of them is calculated once
+        per recalculation after the objects it depends upon.
+
+        Dirty instruments are then recalculated in parallel when
+        OpenMP is enabled.  Instruments added with the same pricing
+        engine are recalculated sequentially on the same thread,
+        since an engine holds its arguments and results; the same
+        holds for all instruments added without an engine, and for
+        all instruments depending on an object added with
+        addSequentialObject().
+
+        Calendars, schedules, index fixings and cat-risk event
+        paths are safe to use from several threads at once.
+
+        \warning the library is not thread-safe in general.  Any
+                 lazy object shared by instruments with different
+                 engines must be added with addSharedObject(), so
+                 that it is calculated before the instruments are
+                 dispatched to different threads.  Any other object
+                 modified during the calculation of the instruments
+                 using it, such as a coupon pricer, must be added
+                 with addSequentialObject().  Quotes, settings and
+                 fixings must not be changed during recalculate().
+    */
+    class Portfolio : private boost::noncopyable {
+      public:
+        Portfolio() : groupsAreValid_(true) {}
+        /*! adds an instrument to the portfolio.  If an engine is
+            given, it is set on the instrument and used to group
+            instruments that cannot be calculated concurrently.
+        */
+        void add(const boost::shared_ptr<Instrument>& instrument,
+                 const boost::shared_ptr<PricingEngine>& engine =
+                                      boost::shared_ptr<PricingEngine>());
+        //! adds a lazy object shared by the instruments
+        void addSharedObject(const boost::shared_ptr<LazyObject>& object);
+        /*! adds an object holding state during the calculation of
+            the instruments using it, e.g., a coupon pricer.  These
+            instruments are recalculated sequentially on the same
+            thread.  They are found by having the object notify its
+            observers, which flags them for recalculation; since
+            instruments only forward notifications once calculated,
+            the first recalculation after adding instruments or
+            objects is performed serially.
+        */
+        void addSequentialObject(const boost::shared_ptr<Observable>& object);
+        //! \name Inspectors
+        //@{
+        Size size() const { return instruments_.size(); }
+        const boost::shared_ptr<Instrument>& instrument(Size i) const;
+        //! whether the i-th instrument needs to be recalculated
+        bool isDirty(Size i) const;
+        //! indices of the instruments needing recalculation
+        std::vector<Size> dirtyInstruments() const;
+        //! indices of the shared objects in calculation order
+        const std::vector<Size>& sharedObjectOrder() const {
+            return order_;
+        }
+        //@}
+        //! \name Calculations
+        //@{
+        /*! recalculates the dirty shared objects and instruments and
+            returns the number of instruments that were recalculated.
+        */
+        Size recalculate();
+        //! sum of the instrument NPVs, after recalculating if needed
+        Real NPV();
+        //@}
+      private:
+        // notifications might come from any thread
+        class DirtyFlag : public Observer {
+          public:
+            DirtyFlag() : dirty_(true) {}
+            void update() { set(true); }
+            bool isDirty() const {
+                bool result;
+                #pragma omp critical(ql_portfolio_flags)
+                result = dirty_;
+                return result;
+            }
+            void set(bool dirty) {
+                #pragma omp critical(ql_portfolio_flags)
+                dirty_ = dirty;
+            }
+          private:
+            bool dirty_;
+        };
+        void recalculateSharedObjects();
+        void sortSharedObjects();
+        void groupInstruments();
+        void recalculateSerially(std::vector<bool>& recalculated);
+        std::vector<boost::shared_ptr<Instrument> > instruments_;
+        std::vector<boost::shared_ptr<DirtyFlag> > instrumentFlags_;
+        // the engine of each instrument; a null engine groups the
+        // instruments added without one
+        std::vector<boost::shared_ptr<PricingEngine> > engines_;
+        std::vector<boost::shared_ptr<Observable> > sequentialObjects_;
+        // indices of the instruments recalculated on the same thread
+        std::vector<std::vector<Size> > groups_;
+        bool groupsAreValid_;
+        std::vector<boost::shared_ptr<LazyObject> > sharedObjects_;
+        std::vector<boost::shared_ptr<DirtyFlag> > sharedFlags_;
+        std::vector<std::vector<Size> > dependents_;
+        std::vector<Size> order_;
+    };
+
+}
+
+#endif
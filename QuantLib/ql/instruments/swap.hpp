@@ -91,6 +91,7 @@ namespace QuantLib {
             QL_REQUIRE(j<legs_.size(), "leg #" << j << " doesn't exist!");
             return legs_[j];
         }
+        Size numberOfLegs() const { return legs_.size(); }
         //@}
       protected:
         //! \name Constructors
@@ -15,6 +15,7 @@
 #include <ql/math/generallinearleastsquares.hpp>
 #include <ql/math/kernelfunctions.hpp>
 #include <ql/math/incompletegamma.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #include <ql/math/interpolation.hpp>
 #include <ql/math/lexicographicalview.hpp>
 #include <ql/math/linearleastsquaresregression.hpp>
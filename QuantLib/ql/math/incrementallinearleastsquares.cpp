@@ -0,0 +1,122 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/math/incrementallinearleastsquares.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/comparison.hpp>
+
+namespace QuantLib {
+
+    IncrementalLinearLeastSquares::IncrementalLinearLeastSquares(
+                                                              Size dimension)
+    : samples_(0), r_(dimension, dimension, 0.0), qty_(dimension, 0.0),
+      row_(dimension, 0.0) {}
+
+    void IncrementalLinearLeastSquares::addRow(Real y) {
+        const Size n = dimension();
+        for (Size k=0; k<n; ++k) {
+            if (row_[k] == 0.0)
+                continue;
+            // Givens rotation zeroing the k-th element of the row
+            const Real rkk = r_[k][k];
+            const Real norm = std::sqrt(rkk*rkk + row_[k]*row_[k]);
+            const Real c = rkk/norm, s = row_[k]/norm;
+            r_[k][k] = norm;
+            row_[k] = 0.0;
+            for (Size j=k+1; j<n; ++j) {
+                const Real t = r_[k][j];
+                r_[k][j] = c*t + s*row_[j];
+                row_[j] = c*row_[j] - s*t;
+            }
+            const Real t = qty_[k];
+            qty_[k] = c*t + s*y;
+            y = c*y - s*t;
+        }
+    }
+
+    void IncrementalLinearLeastSquares::add(
+                                 const IncrementalLinearLeastSquares& other) {
+        QL_REQUIRE(other.dimension() == dimension(),
+                   "regression dimensions do not match ("
+                   << other.dimension() << " != " << dimension() << ")");
+        // stacking the two factors gives the same normal equations
+        // as stacking the two sets of samples
+        for (Size i=0; i<dimension(); ++i) {
+            std::copy(other.r_.row_begin(i), other.r_.row_end(i),
+                      row_.begin());
+            addRow(other.qty_[i]);
+        }
+        samples_ += other.samples_;
+    }
+
+    void IncrementalLinearLeastSquares::reset() {
+        std::fill(r_.begin(), r_.end(), 0.0);
+        std::fill(qty_.begin(), qty_.end(), 0.0);
+        samples_ = 0;
+    }
+
+    Disposable<Array> IncrementalLinearLeastSquares::coefficients() const {
+        const Size n = dimension();
+
+        Array result(n, 0.0);
+        // Frobenius norm of R, i.e., of the (weighted) regressors
+        Real norm = 0.0;
+        for (Size i=0; i<n; ++i)
+            for (Size j=i; j<n; ++j)
+                norm += r_[i][j]*r_[i][j];
+        norm = std::sqrt(norm);
+        if (close_enough(norm, 0.0))
+            return result;
+
+        // pivots below this threshold signal collinear regressors;
+        // rounding errors grow with the dimension and the number of
+        // rotations applied
+        const Real threshold =
+            n*std::max<Size>(n, samples_)*QL_EPSILON*norm;
+
+        bool fullRank = true;
+        for (Size i=0; i<n && fullRank; ++i)
+            fullRank = std::fabs(r_[i][i]) > threshold;
+
+        if (fullRank) {
+            // back substitution
+            for (Size i=n; i>0; --i) {
+                Real sum = qty_[i-1];
+                for (Size k=i; k<n; ++k)
+                    sum -= r_[i-1][k]*result[k];
+                result[i-1] = sum/r_[i-1][i-1];
+            }
+        } else {
+            const SVD svd(r_);
+            const Matrix& U = svd.U();
+            const Matrix& V = svd.V();
+            const Array& w = svd.singularValues();
+            for (Size i=0; i<n; ++i) {
+                if (w[i] > threshold) {
+                    const Real u = std::inner_product(U.column_begin(i),
+                                                      U.column_end(i),
+                                                      qty_.begin(), 0.0)/w[i];
+                    for (Size j=0; j<n; ++j)
+                        result[j] += u*V[j][i];
+                }
+            }
+        }
+        return result;
+    }
+
+}
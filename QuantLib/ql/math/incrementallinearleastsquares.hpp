@@ -0,0 +1,101 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file incrementallinearleastsquares.hpp
+    \brief linear least squares regression accumulated sample by sample
+*/
+
+#ifndef quantlib_incremental_linear_least_squares_hpp
+#define quantlib_incremental_linear_least_squares_hpp
+
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! linear least squares regression accumulated sample by sample
+    /*! Only the triangular factor \f$ R \f$ of a QR decomposition of
+        the regressors and the correspondingly rotated targets are
+        stored, so that memory does not grow with the number of
+        samples.  Each sample is merged into the factor by Givens
+        rotations; unlike forming the normal equations, this does not
+        square the condition number of the problem, which is poor for,
+        e.g., monomial bases over a narrow range.  Partial regressions
+        built independently, e.g. on disjoint sets of samples in
+        different threads, can be merged with add().
+
+        The coefficients are obtained by back substitution; if the
+        regressors are (numerically) collinear, the minimum-norm
+        solution is obtained from the singular value decomposition of
+        \f$ R \f$.
+
+        \test the coefficients are checked against the ones returned by
+              GeneralLinearLeastSquares.
+    */
+    class IncrementalLinearLeastSquares {
+      public:
+        explicit IncrementalLinearLeastSquares(Size dimension = 0);
+        //! \name Inspectors
+        //@{
+        Size dimension() const { return qty_.size(); }
+        Size samples() const { return samples_; }
+        //! regression coefficients for the samples added so far
+        Disposable<Array> coefficients() const;
+        //@}
+        //! \name Modifiers
+        //@{
+        //! adds a sample given by its regressor values and target
+        template <class Iterator>
+        void add(Iterator begin, Iterator end, Real y, Real weight = 1.0);
+        //! merges the samples of another regression
+        void add(const IncrementalLinearLeastSquares&);
+        void reset();
+        //@}
+      private:
+        // rotates the row stored in row_, with target y, into r_
+        void addRow(Real y);
+        Size samples_;
+        Matrix r_;
+        Array qty_;
+        // workspace
+        Array row_;
+    };
+
+
+    // inline definitions
+
+    template <class Iterator>
+    inline void IncrementalLinearLeastSquares::add(Iterator begin,
+                                                   Iterator end,
+                                                   Real y, Real weight) {
+        QL_REQUIRE(Size(std::distance(begin, end)) == dimension(),
+                   "sample size (" << std::distance(begin, end)
+                   << ") does not match regression dimension ("
+                   << dimension() << ")");
+        QL_REQUIRE(weight >= 0.0, "negative weight (" << weight << ")");
+        const Real w = std::sqrt(weight);
+        Size i = 0;
+        for (Iterator xi=begin; xi!=end; ++xi, ++i)
+            row_[i] = w * (*xi);
+        addRow(w * y);
+        ++samples_;
+    }
+
+}
+
+
+#endif
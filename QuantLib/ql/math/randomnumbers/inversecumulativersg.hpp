@@ -63,6 +63,8 @@ namespace QuantLib {
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
+        //! underlying uniform sequence generator
+        USG& uniformSequenceGenerator() { return uniformSequenceGenerator_; }
       private:
         USG uniformSequenceGenerator_;
         Size dimension_;
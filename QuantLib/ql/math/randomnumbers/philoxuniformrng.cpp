@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        const boost::uint32_t multiplier0 = 0xD2511F53UL;
+        const boost::uint32_t multiplier1 = 0xCD9E8D57UL;
+        const boost::uint32_t weyl0 = 0x9E3779B9UL;
+        const boost::uint32_t weyl1 = 0xBB67AE85UL;
+        const Size rounds = 10;
+
+    }
+
+    PhiloxUniformRng::PhiloxUniformRng(BigNatural seed, BigNatural stream)
+    : counter_(0), stream_(stream), index_(4) {
+        boost::uint64_t key =
+            (seed != 0 ? seed : SeedGenerator::instance().get());
+        key_[0] = boost::uint32_t(key & 0xffffffffUL);
+        key_[1] = boost::uint32_t(key >> 32);
+    }
+
+    void PhiloxUniformRng::discard(BigNatural n) {
+        // block_ holds the outputs of block counter_-1, of which the
+        // first index_ were already used (index_ == 4 if exhausted)
+        boost::uint64_t position = boost::uint64_t(index_) + n;
+        counter_ += position/4 - 1;
+        index_ = 4;
+        if (position % 4 != 0) {
+            generate();
+            index_ = Size(position % 4);
+        }
+    }
+
+    void PhiloxUniformRng::generate() const {
+        boost::uint32_t c0 = boost::uint32_t(counter_ & 0xffffffffUL),
+                        c1 = boost::uint32_t(counter_ >> 32),
+                        c2 = boost::uint32_t(stream_ & 0xffffffffUL),
+                        c3 = boost::uint32_t(stream_ >> 32);
+        boost::uint32_t k0 = key_[0], k1 = key_[1];
+
+        for (Size i=0; i<rounds; ++i) {
+            if (i > 0) {
+                k0 += weyl0;
+                k1 += weyl1;
+            }
+            boost::uint64_t p0 = boost::uint64_t(multiplier0)*c0;
+            boost::uint64_t p1 = boost::uint64_t(multiplier1)*c2;
+            boost::uint32_t n0 = boost::uint32_t(p1 >> 32) ^ c1 ^ k0;
+            boost::uint32_t n2 = boost::uint32_t(p0 >> 32) ^ c3 ^ k1;
+            c1 = boost::uint32_t(p1);
+            c3 = boost::uint32_t(p0);
+            c0 = n0;
+            c2 = n2;
+        }
+
+        block_[0] = c0;
+        block_[1] = c1;
+        block_[2] = c2;
+        block_[3] = c3;
+        ++counter_;
+    }
+
+}
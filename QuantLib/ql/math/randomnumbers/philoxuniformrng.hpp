@@ -0,0 +1,86 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file philoxuniformrng.hpp
+    \brief Counter-based Philox uniform random number generator
+*/
+
+#ifndef quantlib_philox_uniform_rng_hpp
+#define quantlib_philox_uniform_rng_hpp
+
+#include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
+
+namespace QuantLib {
+
+    //! Counter-based uniform random number generator
+    /*! Philox4x32-10 generator as described in J.K. Salmon,
+        M.A. Moraes, R.O. Dror and D.E. Shaw (2011), "Parallel random
+        numbers: as easy as 1, 2, 3", Proceedings of the International
+        Conference for High Performance Computing, Networking, Storage
+        and Analysis.
+
+        The generator has no state besides a 128-bit counter and a
+        64-bit key; each value of the counter is mapped to four
+        32-bit outputs by ten rounds of a keyed bijection.  The key is
+        given by the seed, while the upper half of the counter is given
+        by the stream number, so that generators built with the same
+        seed and different streams produce independent sequences of
+        length 2**66.  Any position in a stream can be reached in
+        constant time by means of the discard() method.
+
+        \test the correctness of the returned values is tested by
+              checking them against known good results.
+    */
+    class PhiloxUniformRng {
+      public:
+        typedef Sample<Real> sample_type;
+        /*! if the given seed is 0, a random seed will be chosen
+            based on clock() */
+        explicit PhiloxUniformRng(BigNatural seed = 0,
+                                  BigNatural stream = 0);
+        /*! returns a sample with weight 1.0 containing a random number
+            in the (0.0, 1.0) interval  */
+        sample_type next() const { return sample_type(nextReal(),1.0); }
+        //! return a random number in the (0.0, 1.0)-interval
+        Real nextReal() const {
+            return (Real(nextInt32()) + 0.5)/4294967296.0;
+        }
+        //! return a random integer in the [0,0xffffffff]-interval
+        unsigned long nextInt32() const {
+            if (index_ == 4) {
+                generate();
+                index_ = 0;
+            }
+            return block_[index_++];
+        }
+        //! skips the next n outputs in constant time
+        void discard(BigNatural n);
+      private:
+        void generate() const;
+        boost::uint32_t key_[2];
+        mutable boost::uint64_t counter_;
+        boost::uint64_t stream_;
+        mutable boost::uint32_t block_[4];
+        mutable Size index_;
+    };
+
+}
+
+
+#endif
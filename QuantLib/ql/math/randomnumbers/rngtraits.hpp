@@ -28,9 +28,12 @@
 
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
+#include <ql/math/randomnumbers/zigguratrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
@@ -78,6 +81,64 @@ namespace QuantLib {
                                 InverseCumulativePoisson> PoissonPseudoRandom;
 
 
+    //! traits for counter-based pseudo-random number generation
+    /*! Besides the usual factory, sequence generators can be built
+        for a given stream; generators built from the same seed and
+        different streams draw independent sequences, and building one
+        does not require drawing the others.  This allows a parallel
+        simulation to assign a stream to each block of paths and to
+        reproduce the same results regardless of the number of
+        threads.
+
+        \test sequence generators are generated and tested by comparing
+              samples against known good values.
+    */
+    template <class IC>
+    struct GenericCounterBasedRandom
+        : public GenericPseudoRandom<PhiloxUniformRng,IC> {
+        // typedefs
+        typedef GenericPseudoRandom<PhiloxUniformRng,IC> base_type;
+        typedef typename base_type::urng_type urng_type;
+        typedef typename base_type::ursg_type ursg_type;
+        typedef typename base_type::rsg_type rsg_type;
+        // factories
+        using base_type::make_sequence_generator;
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                BigNatural stream) {
+            ursg_type g(dimension, urng_type(seed, stream));
+            return (base_type::icInstance ?
+                    rsg_type(g, *base_type::icInstance) :
+                    rsg_type(g));
+        }
+    };
+
+    //! default traits for counter-based pseudo-random number generation
+    typedef GenericCounterBasedRandom<InverseCumulativeNormal>
+                                                    CounterBasedPseudoRandom;
+
+
+    //! traits for Ziggurat Gaussian pseudo-random number generation
+    /*! Normal variates are drawn directly by the Ziggurat method
+        instead of being obtained by inversion of uniform ones.
+
+        \test a sequence generator is generated and tested by comparing
+              samples against known good values.
+    */
+    struct Ziggurat {
+        // typedefs
+        typedef ZigguratRng rng_type;
+        typedef RandomSequenceGenerator<rng_type> rsg_type;
+        // more traits
+        enum { allowsErrorEstimate = 1 };
+        // factory
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed) {
+            return rsg_type(dimension, seed);
+        }
+    };
+
+
     template <class URSG, class IC>
     struct GenericLowDiscrepancy {
         // typedefs
@@ -104,6 +165,56 @@ namespace QuantLib {
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
+
+    //! traits for randomized quasi-Monte Carlo
+    /*! Sequences are drawn from a randomized low-discrepancy
+        generator, which must provide a
+        <tt>randomize(BigNatural)</tt> method restarting the
+        sequence with the given randomization.  Monte Carlo
+        simulations (see McSimulation) run the given number of
+        independent randomizations and use the spread of their
+        results as error estimate.
+
+        \test a sequence generator is generated and tested by checking
+              the error estimate of a Monte Carlo simulation.
+    */
+    template <class URSG, class IC>
+    struct GenericRandomizedLowDiscrepancy {
+        // typedefs
+        typedef URSG ursg_type;
+        typedef InverseCumulativeRsg<ursg_type,IC> rsg_type;
+        // more traits
+        enum { allowsErrorEstimate = 1 };
+        // factory
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed) {
+            ursg_type g(dimension, seed);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
+        //! restart the sequence with the given randomization
+        static void randomize(rsg_type& generator,
+                              BigNatural randomization) {
+            generator.uniformSequenceGenerator().randomize(randomization);
+        }
+        // data
+        static boost::shared_ptr<IC> icInstance;
+        //! number of independent randomizations, 16 by default
+        static Size replications;
+    };
+
+    // static member initialization
+    template<class URSG, class IC>
+    boost::shared_ptr<IC> GenericRandomizedLowDiscrepancy<URSG, IC>::icInstance;
+
+    template<class URSG, class IC>
+    Size GenericRandomizedLowDiscrepancy<URSG, IC>::replications = 16;
+
+
+    //! default traits for randomized quasi-Monte Carlo
+    typedef GenericRandomizedLowDiscrepancy<ScrambledSobolRsg,
+                                            InverseCumulativeNormal>
+                                                    RandomizedLowDiscrepancy;
+
 }
 
 
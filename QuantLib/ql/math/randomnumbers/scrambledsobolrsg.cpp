@@ -0,0 +1,143 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        unsigned long randomBits(const PhiloxUniformRng& rng, int bits) {
+            unsigned long x = rng.nextInt32();
+            // the shift is split to stay defined for 32-bit longs
+            for (int b=32; b<bits; b+=32)
+                x = ((x << 16) << 16) | rng.nextInt32();
+            return x;
+        }
+
+    }
+
+    const int ScrambledSobolRsg::bits_ = 8*sizeof(unsigned long);
+
+    ScrambledSobolRsg::ScrambledSobolRsg(
+                            Size dimensionality,
+                            BigNatural seed,
+                            Scrambling scrambling,
+                            SobolRsg::DirectionIntegers directionIntegers)
+    : dimensionality_(dimensionality),
+      seed_(seed != 0 ? seed : SeedGenerator::instance().get()),
+      scrambling_(scrambling),
+      sobol_(dimensionality, 0, directionIntegers), pristineSobol_(sobol_),
+      sequenceCounter_(0), firstDraw_(true),
+      sequence_(std::vector<Real>(dimensionality), 1.0),
+      integerSequence_(dimensionality), sobolSequence_(dimensionality, 0),
+      shift_(dimensionality),
+      directionIntegers_(dimensionality,
+                         std::vector<unsigned long>(bits_)),
+      cached_(bits_, false) {
+        if (scrambling_ == LinearScrambling)
+            scrambledDigits_ = std::vector<std::vector<unsigned long> >(
+                           dimensionality, std::vector<unsigned long>(bits_));
+        // only the leading digits can be represented by a Real
+        discardedBits_ = std::max(bits_ - 53, 0);
+        normalization_ = std::ldexp(1.0, discardedBits_ - bits_);
+        randomize(0);
+    }
+
+    void ScrambledSobolRsg::randomize(BigNatural randomization) {
+        PhiloxUniformRng rng(seed_, randomization);
+        for (Size k=0; k<dimensionality_; ++k) {
+            shift_[k] = randomBits(rng, bits_);
+            if (scrambling_ == LinearScrambling) {
+                // lower-triangular matrix with unit diagonal: each
+                // digit only affects itself and the less significant ones
+                for (int b=0; b<bits_; ++b) {
+                    unsigned long unit = 1UL << b;
+                    scrambledDigits_[k][b] =
+                        unit | (randomBits(rng, bits_) & (unit-1));
+                }
+            }
+        }
+        std::fill(cached_.begin(), cached_.end(), false);
+        sobol_ = pristineSobol_;
+        std::fill(sobolSequence_.begin(), sobolSequence_.end(), 0UL);
+        sequenceCounter_ = 0;
+        firstDraw_ = true;
+    }
+
+    unsigned long ScrambledSobolRsg::scramble(unsigned long x,
+                                              Size k) const {
+        if (scrambling_ == DigitalShift)
+            return x;
+        unsigned long y = 0;
+        for (int b=0; b<bits_ && x != 0; ++b, x >>= 1) {
+            if (x & 1UL)
+                y ^= scrambledDigits_[k][b];
+        }
+        return y;
+    }
+
+    const std::vector<unsigned long>&
+    ScrambledSobolRsg::nextInt32Sequence() const {
+        if (firstDraw_) {
+            // the origin is the scrambled image of the null digits
+            firstDraw_ = false;
+            integerSequence_ = shift_;
+            return integerSequence_;
+        }
+
+        // consecutive Sobol points differ by a single direction
+        // integer in each dimension, whose index only depends on the
+        // position in the sequence; as the scrambling is linear, its
+        // image is computed once and xor-ed to the previous point
+        Size j = 0;
+        for (unsigned long n = sequenceCounter_; n & 1UL; n >>= 1)
+            ++j;
+        ++sequenceCounter_;
+        QL_REQUIRE(sequenceCounter_ != 0, "period exceeded");
+
+        const std::vector<unsigned long>& v = sobol_.nextInt32Sequence();
+        if (!cached_[j]) {
+            for (Size k=0; k<dimensionality_; ++k)
+                directionIntegers_[k][j] =
+                    scramble(v[k] ^ sobolSequence_[k], k);
+            cached_[j] = true;
+        }
+        for (Size k=0; k<dimensionality_; ++k) {
+            integerSequence_[k] ^= directionIntegers_[k][j];
+            sobolSequence_[k] = v[k];
+        }
+        return integerSequence_;
+    }
+
+    const ScrambledSobolRsg::sample_type&
+    ScrambledSobolRsg::nextSequence() const {
+        const std::vector<unsigned long>& v = nextInt32Sequence();
+        // the midpoint of the cell is taken so that the result is in (0,1)
+        for (Size k=0; k<dimensionality_; ++k)
+            sequence_.value[k] =
+                (Real(v[k] >> discardedBits_) + 0.5)*normalization_;
+        return sequence_;
+    }
+
+}
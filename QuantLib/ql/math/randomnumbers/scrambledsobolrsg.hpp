@@ -0,0 +1,95 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file scrambledsobolrsg.hpp
+    \brief Randomly scrambled Sobol low-discrepancy sequence generator
+*/
+
+#ifndef quantlib_scrambled_sobol_ld_rsg_hpp
+#define quantlib_scrambled_sobol_ld_rsg_hpp
+
+#include <ql/math/randomnumbers/sobolrsg.hpp>
+
+namespace QuantLib {
+
+    //! Randomly scrambled Sobol low-discrepancy sequence generator
+    /*! The digits of the Sobol points, origin included, are randomized
+        either by a random digital shift, i.e., they are xor-ed with a
+        random vector of bits in each dimension, or by the random
+        linear scrambling of J. Matousek, "On the L2-discrepancy for
+        anchored boxes", Journal of Complexity, 14, pp. 527-556, 1998,
+        followed by a digital shift.  The latter is a cheaper variant
+        of Owen's nested scrambling with the same variance for
+        smooth integrands.  In both cases each point is uniformly
+        distributed in the unit hypercube while the net structure of
+        the sequence is preserved, so that independent randomizations
+        give independent unbiased estimates of the integral whose
+        spread measures the quasi-Monte Carlo error.
+
+        Randomizations are numbered; the random bits for randomization
+        \f$ r \f$ are drawn from the stream \f$ r \f$ of a counter-based
+        generator keyed by the seed, so that any of them can be
+        obtained directly by means of the randomize() method.
+
+        \test the mean of the randomized points is checked against
+              its expected value and distinct randomizations are
+              checked to be independent.
+    */
+    class ScrambledSobolRsg {
+      public:
+        typedef Sample<std::vector<Real> > sample_type;
+        enum Scrambling { DigitalShift, LinearScrambling };
+        /*! if the given seed is 0, a random seed will be chosen
+            based on clock() */
+        explicit ScrambledSobolRsg(
+            Size dimensionality,
+            BigNatural seed = 0,
+            Scrambling scrambling = LinearScrambling,
+            SobolRsg::DirectionIntegers directionIntegers = SobolRsg::Jaeckel);
+        /*! restart the sequence with the given randomization; the
+            generator is built with randomization 0 */
+        void randomize(BigNatural randomization);
+        const std::vector<unsigned long>& nextInt32Sequence() const;
+        const sample_type& nextSequence() const;
+        const sample_type& lastSequence() const { return sequence_; }
+        Size dimension() const { return dimensionality_; }
+      private:
+        unsigned long scramble(unsigned long x, Size dimension) const;
+        static const int bits_;
+        Size dimensionality_;
+        BigNatural seed_;
+        Scrambling scrambling_;
+        SobolRsg sobol_, pristineSobol_;
+        mutable unsigned long sequenceCounter_;
+        mutable bool firstDraw_;
+        mutable sample_type sequence_;
+        mutable std::vector<unsigned long> integerSequence_, sobolSequence_;
+        std::vector<unsigned long> shift_;
+        // images of the digits under the linear scrambling
+        std::vector<std::vector<unsigned long> > scrambledDigits_;
+        // images of the direction integers, computed when first needed
+        mutable std::vector<std::vector<unsigned long> > directionIntegers_;
+        mutable std::vector<bool> cached_;
+        Real normalization_;
+        int discardedBits_;
+    };
+
+}
+
+
+#endif
@@ -17,7 +17,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
-#include <ql/experimental/math/zigguratrng.hpp>
+#include <ql/math/randomnumbers/zigguratrng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <cmath>
 
@@ -172,6 +172,27 @@ namespace QuantLib {
         }
     }
 
+    void IncrementalStatistics::merge(const IncrementalStatistics& other) {
+        if (other.sampleNumber_ == 0)
+            return;
+        if (sampleNumber_ == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+        }
+        sampleNumber_ += other.sampleNumber_;
+        downsideSampleNumber_ += other.downsideSampleNumber_;
+        sampleWeight_ += other.sampleWeight_;
+        downsideSampleWeight_ += other.downsideSampleWeight_;
+        sum_ += other.sum_;
+        quadraticSum_ += other.quadraticSum_;
+        downsideQuadraticSum_ += other.downsideQuadraticSum_;
+        cubicSum_ += other.cubicSum_;
+        fourthPowerSum_ += other.fourthPowerSum_;
+    }
+
     void IncrementalStatistics::reset() {
         min_ = QL_MAX_REAL;
         max_ = QL_MIN_REAL;
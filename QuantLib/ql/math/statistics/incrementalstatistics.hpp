@@ -126,6 +126,13 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! adds the samples collected by another instance
+        /*! The result is the same (up to rounding) as adding to this
+            instance all the samples added to the other one; this
+            allows samples to be collected separately, e.g., by
+            different threads, and combined at the end.
+        */
+        void merge(const IncrementalStatistics& other);
         //! resets the data to a null set
         void reset();
         //@}
@@ -0,0 +1,185 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/math/statistics/kendallstau.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        // orders observation indices by the first, then the second series
+        class LexicographicOrder {
+          public:
+            LexicographicOrder(const std::vector<Real>& x,
+                               const std::vector<Real>& y)
+            : x_(x), y_(y) {}
+            bool operator()(Size i, Size j) const {
+                return x_[i] < x_[j] || (x_[i] == x_[j] && y_[i] < y_[j]);
+            }
+          private:
+            const std::vector<Real>& x_;
+            const std::vector<Real>& y_;
+        };
+
+        // total weight of the pairs within a group of observations,
+        // given the sum and the sum of squares of their weights
+        inline Real pairWeight(Real sum, Real sumOfSquares) {
+            return 0.5*(sum*sum - sumOfSquares);
+        }
+
+    }
+
+    Real kendallsTau(const std::vector<Real>& x,
+                     const std::vector<Real>& y) {
+        return kendallsTau(x, y, std::vector<Real>(x.size(), 1.0));
+    }
+
+    Real kendallsTau(const std::vector<Real>& x,
+                     const std::vector<Real>& y,
+                     const std::vector<Real>& weights) {
+        Size n = x.size();
+        QL_REQUIRE(y.size() == n,
+                   "series have different sizes (" << n << ", "
+                   << y.size() << ")");
+        QL_REQUIRE(weights.size() == n,
+                   "wrong number of weights (" << weights.size()
+                   << " instead of " << n << ")");
+        QL_REQUIRE(n >= 2, "at least two observations are required");
+
+        // sort by x, then y; this collects the pairs tied in x and
+        // those tied in both series
+        std::vector<Size> order(n);
+        for (Size i=0; i<n; ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), LexicographicOrder(x, y));
+
+        std::vector<Real> v(n), w(n);
+        for (Size i=0; i<n; ++i) {
+            v[i] = y[order[i]];
+            w[i] = weights[order[i]];
+        }
+
+        Real tiedX = 0.0, tiedBoth = 0.0;
+        Real s = 0.0, q = 0.0, sb = 0.0, qb = 0.0;
+        for (Size i=0; i<n; ++i) {
+            if (i > 0 && x[order[i]] != x[order[i-1]]) {
+                tiedX += pairWeight(s, q);
+                s = q = 0.0;
+            }
+            if (i > 0 && (x[order[i]] != x[order[i-1]] || v[i] != v[i-1])) {
+                tiedBoth += pairWeight(sb, qb);
+                sb = qb = 0.0;
+            }
+            s += w[i]; q += w[i]*w[i];
+            sb += w[i]; qb += w[i]*w[i];
+        }
+        tiedX += pairWeight(s, q);
+        tiedBoth += pairWeight(sb, qb);
+
+        // bottom-up merge sort by y; every element of the right run
+        // that passes elements of the left run forms a discordant
+        // pair with each of them
+        Real discordant = 0.0;
+        std::vector<Real> v2(n), w2(n);
+        for (Size width=1; width<n; width*=2) {
+            for (Size lo=0; lo<n; lo+=2*width) {
+                Size mid = std::min(lo+width, n), hi = std::min(lo+2*width, n);
+                Real left = 0.0;
+                for (Size k=lo; k<mid; ++k)
+                    left += w[k];
+                Size a = lo, b = mid, k = lo;
+                while (a < mid || b < hi) {
+                    if (b >= hi || (a < mid && v[a] <= v[b])) {
+                        left -= w[a];
+                        v2[k] = v[a]; w2[k++] = w[a++];
+                    } else {
+                        discordant += w[b]*left;
+                        v2[k] = v[b]; w2[k++] = w[b++];
+                    }
+                }
+            }
+            v.swap(v2);
+            w.swap(w2);
+        }
+
+        // the data are now sorted by y; collect the pairs tied in y
+        Real tiedY = 0.0, total = 0.0, totalSquares = 0.0;
+        s = q = 0.0;
+        for (Size i=0; i<n; ++i) {
+            if (i > 0 && v[i] != v[i-1]) {
+                tiedY += pairWeight(s, q);
+                s = q = 0.0;
+            }
+            s += w[i]; q += w[i]*w[i];
+            total += w[i]; totalSquares += w[i]*w[i];
+        }
+        tiedY += pairWeight(s, q);
+
+        Real all = pairWeight(total, totalSquares);
+        QL_REQUIRE(all > 0.0, "null total weight of pairs");
+
+        // concordant = all - tiedX - tiedY + tiedBoth - discordant
+        return (all - tiedX - tiedY + tiedBoth - 2.0*discordant) / all;
+    }
+
+    Matrix kendallsTauMatrix(const std::vector<std::vector<Real> >& series) {
+        Size n = series.empty() ? 0 : series[0].size();
+        return kendallsTauMatrix(series, std::vector<Real>(n, 1.0));
+    }
+
+    Matrix kendallsTauMatrix(const std::vector<std::vector<Real> >& series,
+                             const std::vector<Real>& weights) {
+        Size m = series.size();
+        for (Size i=1; i<m; ++i)
+            QL_REQUIRE(series[i].size() == series[0].size(),
+                       "series have different sizes (" << series[0].size()
+                       << ", " << series[i].size() << ")");
+
+        Matrix result(m, m, 0.0);
+        for (Size i=0; i<m; ++i)
+            result[i][i] = 1.0;
+
+        // the pairs (i,j) with j<i are enumerated by a single index,
+        // so that they can be distributed evenly over the threads
+        long pairs = long(m*(m-1)/2);
+        std::vector<std::string> errors(pairs);
+        #pragma omp parallel for schedule(dynamic)
+        for (long k=0; k<pairs; ++k) {
+            Size i = 1, first = 0;
+            while (first + i <= Size(k))
+                first += i++;
+            Size j = Size(k) - first;
+            try {
+                result[i][j] = result[j][i] =
+                    kendallsTau(series[i], series[j], weights);
+            } catch (std::exception& e) {
+                errors[k] = e.what();
+            } catch (...) {
+                errors[k] = "unknown error";
+            }
+        }
+        for (long k=0; k<pairs; ++k)
+            QL_REQUIRE(errors[k].empty(), errors[k]);
+
+        return result;
+    }
+
+}
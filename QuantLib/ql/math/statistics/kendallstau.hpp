@@ -0,0 +1,85 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file kendallstau.hpp
+    \brief Kendall's rank correlation coefficient
+*/
+
+#ifndef quantlib_kendalls_tau_hpp
+#define quantlib_kendalls_tau_hpp
+
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Kendall's rank correlation coefficient
+    /*! Returns
+        \f[
+            \tau = \frac{n_c - n_d}{n(n-1)/2}
+        \f]
+        where \f$ n_c \f$ and \f$ n_d \f$ are the numbers of
+        concordant and discordant pairs among the \f$ n \f$
+        observations; pairs tied in either series count as neither.
+
+        The coefficient is calculated in \f$ O(n \log n) \f$ time with
+        Knight's algorithm, i.e., by counting the discordant pairs as
+        the inversions of a merge sort.
+
+        \test the results are checked against a direct count over
+              all pairs, with and without ties and weights.
+    */
+    Real kendallsTau(const std::vector<Real>& x,
+                     const std::vector<Real>& y);
+
+    /*! Weighted version of the above; the pair \f$ (i,j) \f$ is
+        weighted with \f$ w_i w_j \f$, so that
+        \f[
+            \tau = \frac{\sum_{i<j} w_i w_j \,
+                         \mathrm{sgn}(x_i-x_j) \, \mathrm{sgn}(y_i-y_j)}
+                        {\sum_{i<j} w_i w_j}.
+        \f]
+    */
+    Real kendallsTau(const std::vector<Real>& x,
+                     const std::vector<Real>& y,
+                     const std::vector<Real>& weights);
+
+    //! Kendall's rank correlation matrix
+    /*! Returns the matrix of the coefficients between each pair of
+        the given series, all of which must have the same size; the
+        diagonal elements are 1.
+
+        The pairs are calculated in parallel when OpenMP is enabled.
+        An error raised for any of them is rethrown after all pairs
+        were processed.
+
+        \test the results are checked against the coefficients
+              calculated pair by pair.
+    */
+    Matrix kendallsTauMatrix(const std::vector<std::vector<Real> >& series);
+
+    /*! Weighted version of the above; the same observation weights
+        are used for all pairs.
+    */
+    Matrix kendallsTauMatrix(const std::vector<std::vector<Real> >& series,
+                             const std::vector<Real>& weights);
+
+}
+
+
+#endif
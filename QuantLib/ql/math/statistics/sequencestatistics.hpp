@@ -139,6 +139,25 @@ namespace QuantLib {
                 stats_[i].add(*begin, weight);
 
         }
+        //! adds the samples collected by another instance
+        /*! \pre the underlying statistics class must provide a
+                 merge() method, as IncrementalStatistics does.
+        */
+        void merge(const GenericSequenceStatistics& other) {
+            if (other.dimension_ == 0)
+                return;
+            if (dimension_ == 0)
+                reset(other.dimension_);
+
+            QL_REQUIRE(other.dimension_ == dimension_,
+                       "sample size mismatch: " << dimension_ <<
+                       " required, " << other.dimension_ <<
+                       " provided");
+
+            quadraticSum_ += other.quadraticSum_;
+            for (Size i=0; i<dimension_; ++i)
+                stats_[i].merge(other.stats_[i]);
+        }
         //@}
       protected:
         Size dimension_;
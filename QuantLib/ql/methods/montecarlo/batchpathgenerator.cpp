@@ -0,0 +1,306 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/methods/montecarlo/batchpathgenerator.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/processes/stochasticprocessarray.hpp>
+#include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/localvolcurve.hpp>
+#include <typeinfo>
+
+namespace QuantLib {
+
+    namespace {
+
+        // only the exact classes are accepted, since derived
+        // processes might override evolve()
+        bool isPlainBlackScholes(const StochasticProcess& p) {
+            const std::type_info& t = typeid(p);
+            return t == typeid(GeneralizedBlackScholesProcess)
+                || t == typeid(BlackScholesProcess)
+                || t == typeid(BlackScholesMertonProcess)
+                || t == typeid(BlackProcess)
+                || t == typeid(GarmanKohlagenProcess);
+        }
+
+        bool isTruncatedEulerScheme(HestonProcess::Discretization d) {
+            return d == HestonProcess::PartialTruncation
+                || d == HestonProcess::FullTruncation
+                || d == HestonProcess::Reflection;
+        }
+
+        // tiles of the product below; a tile of variates takes 16k
+        const Size pathTile = 64, factorTile = 32;
+
+        // dz = a * dw, with dw given as a (factor, path) block and dz
+        // returned as a (row, path) block.  The product is tiled over
+        // paths and factors so that the variates in use stay in cache;
+        // each element is still accumulated in increasing factor
+        // order, which reproduces the matrix-vector product exactly.
+        void blockedProduct(const Matrix& a, const Real* dw,
+                            Size nPaths, Real* dz) {
+            const Size rows = a.rows(), factors = a.columns();
+            std::fill(dz, dz+rows*nPaths, 0.0);
+            for (Size k0=0; k0<nPaths; k0+=pathTile) {
+                Size k1 = std::min(k0+pathTile, nPaths);
+                for (Size f0=0; f0<factors; f0+=factorTile) {
+                    Size f1 = std::min(f0+factorTile, factors);
+                    for (Size j=0; j<rows; ++j) {
+                        Real* z = dz + j*nPaths;
+                        for (Size f=f0; f<f1; ++f) {
+                            const Real ajf = a[j][f];
+                            const Real* w = dw + f*nPaths;
+                            for (Size k=k0; k<k1; ++k)
+                                z[k] += ajf*w[k];
+                        }
+                    }
+                }
+            }
+        }
+
+    }
+
+    BatchPathEvolver::BatchPathEvolver(
+                  const boost::shared_ptr<StochasticProcess>& process)
+    : process_(process),
+      process1D_(boost::dynamic_pointer_cast<StochasticProcess1D>(process)) {
+
+        QL_REQUIRE(process_, "null process");
+
+        if (isPlainBlackScholes(*process_)) {
+            blackScholes_ =
+                boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                                   process_);
+        } else if (typeid(*process_) == typeid(HestonProcess)) {
+            boost::shared_ptr<HestonProcess> heston =
+                boost::dynamic_pointer_cast<HestonProcess>(process_);
+            if (isTruncatedEulerScheme(heston->discretizationScheme()))
+                heston_ = heston;
+        } else if (typeid(*process_) == typeid(StochasticProcessArray)) {
+            array_ = boost::dynamic_pointer_cast<StochasticProcessArray>(
+                                                                   process_);
+        }
+    }
+
+    void BatchPathEvolver::evolve(const std::vector<Real>& dw,
+                                  bool antithetic,
+                                  PathBatch& paths) const {
+        QL_REQUIRE(paths.assetNumber() == process_->size(),
+                   "number of assets (" << paths.assetNumber()
+                   << ") differs from process size ("
+                   << process_->size() << ")");
+        QL_REQUIRE(dw.size() == process_->factors()*(paths.pathSize()-1)
+                                *paths.pathNumber(),
+                   "wrong number of Gaussian variates (" << dw.size()
+                   << ") for the given batch");
+
+        Real sign = antithetic ? -1.0 : 1.0;
+        if (blackScholes_)
+            evolveBlackScholes(dw, sign, paths);
+        else if (heston_)
+            evolveHeston(dw, sign, paths);
+        else if (process1D_)
+            evolve1D(dw, sign, paths);
+        else if (array_)
+            evolveArray(dw, sign, paths);
+        else
+            evolveND(dw, sign, paths);
+    }
+
+    void BatchPathEvolver::evolveBlackScholes(const std::vector<Real>& dw,
+                                              Real sign,
+                                              PathBatch& paths) const {
+        // the kernel relies on the drift and diffusion not depending
+        // on the underlying, which holds when the local volatility
+        // is at most time dependent
+        const boost::shared_ptr<LocalVolTermStructure>& localVol =
+            *(blackScholes_->localVolatility());
+        if (!boost::dynamic_pointer_cast<LocalConstantVol>(localVol)
+            && !boost::dynamic_pointer_cast<LocalVolCurve>(localVol)) {
+            evolve1D(dw, sign, paths);
+            return;
+        }
+
+        const TimeGrid& grid = paths.timeGrid();
+        const Size nPaths = paths.pathNumber();
+        const Real x0 = blackScholes_->x0();
+
+        std::fill(paths.slice(0,0), paths.slice(0,0)+nPaths, x0);
+
+        for (Size i=1; i<paths.pathSize(); ++i) {
+            Time t = grid[i-1], dt = grid.dt(i-1);
+            // log-drift and standard deviation over the step
+            Real drift = std::log(blackScholes_->evolve(t, x0, dt, 0.0)/x0);
+            Real stdDev = sign*blackScholes_->stdDeviation(t, x0, dt);
+
+            const Real* x = paths.slice(i-1,0);
+            const Real* w = &dw[(i-1)*nPaths];
+            Real* y = paths.slice(i,0);
+            for (Size k=0; k<nPaths; ++k)
+                y[k] = x[k]*std::exp(drift + stdDev*w[k]);
+        }
+    }
+
+    void BatchPathEvolver::evolveHeston(const std::vector<Real>& dw,
+                                        Real sign,
+                                        PathBatch& paths) const {
+        const TimeGrid& grid = paths.timeGrid();
+        const Size nPaths = paths.pathNumber();
+
+        const Real kappa = heston_->kappa(), theta = heston_->theta();
+        const Real sigma = heston_->sigma(), rho = heston_->rho();
+        const Real sqrhov = std::sqrt(1.0 - rho*rho);
+        const HestonProcess::Discretization scheme =
+            heston_->discretizationScheme();
+
+        std::fill(paths.slice(0,0), paths.slice(0,0)+nPaths,
+                  heston_->s0()->value());
+        std::fill(paths.slice(0,1), paths.slice(0,1)+nPaths, heston_->v0());
+
+        for (Size i=1; i<paths.pathSize(); ++i) {
+            Time t = grid[i-1], dt = grid.dt(i-1);
+            const Real sdt = std::sqrt(dt);
+            const Real rate =
+                  heston_->riskFreeRate()->forwardRate(t, t+dt, Continuous)
+                - heston_->dividendYield()->forwardRate(t, t+dt, Continuous);
+
+            const Real* s = paths.slice(i-1,0);
+            const Real* v = paths.slice(i-1,1);
+            const Real* w0 = &dw[2*(i-1)*nPaths];
+            const Real* w1 = &dw[(2*(i-1)+1)*nPaths];
+            Real* sNext = paths.slice(i,0);
+            Real* vNext = paths.slice(i,1);
+
+            // see HestonProcess::evolve for the discretization schemes
+            switch (scheme) {
+              case HestonProcess::PartialTruncation:
+                for (Size k=0; k<nPaths; ++k) {
+                    Real vol = (v[k] > 0.0) ? std::sqrt(v[k]) : 0.0;
+                    Real mu = rate - 0.5*vol*vol;
+                    Real nu = kappa*(theta - v[k]);
+                    Real z0 = sign*w0[k], z1 = sign*w1[k];
+                    sNext[k] = s[k]*std::exp(mu*dt+vol*z0*sdt);
+                    vNext[k] = v[k] + nu*dt
+                             + sigma*vol*sdt*(rho*z0 + sqrhov*z1);
+                }
+                break;
+              case HestonProcess::FullTruncation:
+                for (Size k=0; k<nPaths; ++k) {
+                    Real vol = (v[k] > 0.0) ? std::sqrt(v[k]) : 0.0;
+                    Real mu = rate - 0.5*vol*vol;
+                    Real nu = kappa*(theta - vol*vol);
+                    Real z0 = sign*w0[k], z1 = sign*w1[k];
+                    sNext[k] = s[k]*std::exp(mu*dt+vol*z0*sdt);
+                    vNext[k] = v[k] + nu*dt
+                             + sigma*vol*sdt*(rho*z0 + sqrhov*z1);
+                }
+                break;
+              case HestonProcess::Reflection:
+                for (Size k=0; k<nPaths; ++k) {
+                    Real vol = std::sqrt(std::fabs(v[k]));
+                    Real mu = rate - 0.5*vol*vol;
+                    Real nu = kappa*(theta - vol*vol);
+                    Real z0 = sign*w0[k], z1 = sign*w1[k];
+                    sNext[k] = s[k]*std::exp(mu*dt+vol*z0*sdt);
+                    vNext[k] = vol*vol + nu*dt
+                             + sigma*vol*sdt*(rho*z0 + sqrhov*z1);
+                }
+                break;
+              default:
+                QL_FAIL("unsupported Heston discretization");
+            }
+        }
+    }
+
+    void BatchPathEvolver::evolve1D(const std::vector<Real>& dw,
+                                    Real sign,
+                                    PathBatch& paths) const {
+        const TimeGrid& grid = paths.timeGrid();
+        const Size nPaths = paths.pathNumber();
+
+        std::fill(paths.slice(0,0), paths.slice(0,0)+nPaths,
+                  process1D_->x0());
+
+        for (Size i=1; i<paths.pathSize(); ++i) {
+            Time t = grid[i-1], dt = grid.dt(i-1);
+            const Real* x = paths.slice(i-1,0);
+            const Real* w = &dw[(i-1)*nPaths];
+            Real* y = paths.slice(i,0);
+            for (Size k=0; k<nPaths; ++k)
+                y[k] = process1D_->evolve(t, x[k], dt, sign*w[k]);
+        }
+    }
+
+    void BatchPathEvolver::evolveArray(const std::vector<Real>& dw,
+                                       Real sign,
+                                       PathBatch& paths) const {
+        const TimeGrid& grid = paths.timeGrid();
+        const Size nPaths = paths.pathNumber();
+        const Size m = array_->size(), n = array_->factors();
+        const Matrix& sqrtCorrelation = array_->sqrtCorrelation();
+
+        Array x0 = array_->initialValues();
+        for (Size j=0; j<m; ++j)
+            std::fill(paths.slice(0,j), paths.slice(0,j)+nPaths, x0[j]);
+
+        dz_.resize(m*nPaths);
+        for (Size i=1; i<paths.pathSize(); ++i) {
+            Time t = grid[i-1], dt = grid.dt(i-1);
+            blockedProduct(sqrtCorrelation, &dw[(i-1)*n*nPaths],
+                           nPaths, &dz_[0]);
+            // as in StochasticProcessArray::evolve
+            for (Size j=0; j<m; ++j) {
+                const StochasticProcess1D& process = *(array_->process(j));
+                const Real* x = paths.slice(i-1,j);
+                const Real* z = &dz_[j*nPaths];
+                Real* y = paths.slice(i,j);
+                for (Size k=0; k<nPaths; ++k)
+                    y[k] = process.evolve(t, x[k], dt, sign*z[k]);
+            }
+        }
+    }
+
+    void BatchPathEvolver::evolveND(const std::vector<Real>& dw,
+                                    Real sign,
+                                    PathBatch& paths) const {
+        const TimeGrid& grid = paths.timeGrid();
+        const Size nPaths = paths.pathNumber();
+        const Size m = process_->size(), n = process_->factors();
+
+        Array x = process_->initialValues();
+        for (Size j=0; j<m; ++j)
+            std::fill(paths.slice(0,j), paths.slice(0,j)+nPaths, x[j]);
+
+        Array w(n), y(m);
+        for (Size i=1; i<paths.pathSize(); ++i) {
+            Time t = grid[i-1], dt = grid.dt(i-1);
+            const Real* dwi = &dw[(i-1)*n*nPaths];
+            for (Size k=0; k<nPaths; ++k) {
+                for (Size j=0; j<m; ++j)
+                    x[j] = paths(i-1,j,k);
+                for (Size f=0; f<n; ++f)
+                    w[f] = sign*dwi[f*nPaths+k];
+                y = process_->evolve(t, x, dt, w);
+                for (Size j=0; j<m; ++j)
+                    paths(i,j,k) = y[j];
+            }
+        }
+    }
+
+}
@@ -0,0 +1,199 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file batchpathgenerator.hpp
+    \brief Generates batches of paths from a random-sequence generator
+*/
+
+#ifndef quantlib_montecarlo_batch_path_generator_hpp
+#define quantlib_montecarlo_batch_path_generator_hpp
+
+#include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/pathbatch.hpp>
+#include <ql/stochasticprocess.hpp>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+    class HestonProcess;
+    class StochasticProcessArray;
+
+    //! Evolves a batch of paths one time step at a time
+    /*! Generalized Black-Scholes processes whose local volatility
+        does not depend on the underlying level, and Heston processes
+        using the partial-truncation, full-truncation or reflection
+        schemes, are evolved by specialised kernels which evaluate
+        the term structures once per time step and update all paths
+        in the batch without virtual calls or temporaries.  For
+        arrays of correlated processes, the square root of the
+        correlation is applied to the variates of each time step
+        with a single matrix-matrix product over the whole batch.
+        Any other process is evolved path by path through its own
+        evolve() method.
+
+        The Gaussian variates are given as a (time step, factor,
+        path) buffer, with the paths of a given step and factor
+        stored contiguously.
+
+        \ingroup mcarlo
+    */
+    class BatchPathEvolver {
+      public:
+        BatchPathEvolver(const boost::shared_ptr<StochasticProcess>&);
+        void evolve(const std::vector<Real>& dw,
+                    bool antithetic,
+                    PathBatch& paths) const;
+        const boost::shared_ptr<StochasticProcess>& process() const {
+            return process_;
+        }
+      private:
+        void evolveBlackScholes(const std::vector<Real>& dw,
+                                Real sign, PathBatch& paths) const;
+        void evolveHeston(const std::vector<Real>& dw,
+                          Real sign, PathBatch& paths) const;
+        void evolve1D(const std::vector<Real>& dw,
+                      Real sign, PathBatch& paths) const;
+        void evolveArray(const std::vector<Real>& dw,
+                         Real sign, PathBatch& paths) const;
+        void evolveND(const std::vector<Real>& dw,
+                      Real sign, PathBatch& paths) const;
+        boost::shared_ptr<StochasticProcess> process_;
+        boost::shared_ptr<StochasticProcess1D> process1D_;
+        boost::shared_ptr<GeneralizedBlackScholesProcess> blackScholes_;
+        boost::shared_ptr<HestonProcess> heston_;
+        boost::shared_ptr<StochasticProcessArray> array_;
+        mutable std::vector<Real> dz_;
+    };
+
+
+    //! Generates a batch of paths from a random-sequence generator
+    /*! Draws as many sequences as there are paths in the batch and
+        evolves them together into a preallocated PathBatch.  Paths
+        are consumed from the generator in the same order, and are
+        the same, as when drawn one at a time by PathGenerator or
+        MultiPathGenerator.
+
+        \ingroup mcarlo
+
+        \test the generated paths are checked against the ones
+              returned by PathGenerator and MultiPathGenerator.
+    */
+    template <class GSG>
+    class BatchPathGenerator {
+      public:
+        typedef PathBatch sample_type;
+        BatchPathGenerator(const boost::shared_ptr<StochasticProcess>&,
+                           const TimeGrid&,
+                           GSG generator,
+                           Size batchSize,
+                           bool brownianBridge = false);
+        //! \name inspectors
+        //@{
+        const sample_type& next() const;
+        //! antithetic counterparts of the paths of the last batch
+        const sample_type& antithetic() const;
+        Size batchSize() const { return batchSize_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+      private:
+        const sample_type& next(bool antithetic) const;
+        bool brownianBridge_;
+        GSG generator_;
+        TimeGrid timeGrid_;
+        Size factors_, batchSize_;
+        BatchPathEvolver evolver_;
+        BrownianBridge bb_;
+        mutable sample_type next_;
+        mutable std::vector<Real> dw_, temp_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    BatchPathGenerator<GSG>::BatchPathGenerator(
+                   const boost::shared_ptr<StochasticProcess>& process,
+                   const TimeGrid& times,
+                   GSG generator,
+                   Size batchSize,
+                   bool brownianBridge)
+    : brownianBridge_(brownianBridge), generator_(generator),
+      timeGrid_(times), factors_(process->factors()),
+      batchSize_(batchSize), evolver_(process), bb_(timeGrid_),
+      next_(process->size(), timeGrid_, batchSize),
+      dw_(factors_*(times.size()-1)*batchSize),
+      temp_(factors_*(times.size()-1)) {
+
+        QL_REQUIRE(times.size() > 1,
+                   "no times given");
+        QL_REQUIRE(generator_.dimension() == factors_*(times.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << factors_ << " * " << times.size()-1
+                   << ") the number of factors "
+                   << "times the number of time steps");
+        QL_REQUIRE(!brownianBridge || factors_ == 1,
+                   "Brownian bridge only supported for one-factor "
+                   "processes");
+    }
+
+    template <class GSG>
+    inline const typename BatchPathGenerator<GSG>::sample_type&
+    BatchPathGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const typename BatchPathGenerator<GSG>::sample_type&
+    BatchPathGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const typename BatchPathGenerator<GSG>::sample_type&
+    BatchPathGenerator<GSG>::next(bool antithetic) const {
+
+        // the variates of the last batch are kept in dw_, so that
+        // the antithetic batch only needs to evolve them again
+        if (!antithetic) {
+            typedef typename GSG::sample_type sequence_type;
+            Size dimension = temp_.size();
+            for (Size k=0; k<batchSize_; ++k) {
+                const sequence_type& sequence_ = generator_.nextSequence();
+                next_.weight(k) = sequence_.weight;
+                if (brownianBridge_) {
+                    bb_.transform(sequence_.value.begin(),
+                                  sequence_.value.end(),
+                                  temp_.begin());
+                    for (Size d=0; d<dimension; ++d)
+                        dw_[d*batchSize_+k] = temp_[d];
+                } else {
+                    for (Size d=0; d<dimension; ++d)
+                        dw_[d*batchSize_+k] = sequence_.value[d];
+                }
+            }
+        }
+
+        evolver_.evolve(dw_, antithetic, next_);
+        return next_;
+    }
+
+}
+
+
+#endif
@@ -18,8 +18,8 @@
 */
 
 #include <ql/methods/montecarlo/genericlsregression.hpp>
-#include <ql/math/statistics/sequencestatistics.hpp>
-#include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 
 namespace QuantLib {
 
@@ -34,72 +34,89 @@ namespace QuantLib {
 
             std::vector<NodeData>& exerciseData = simulationData[i];
 
-            // 1) find the covariance matrix of basis function values and
-            //    deflated cash-flows
+            // 1) accumulate the cross products of basis function values
+            //    and deflated cash-flows; the paths are split in a fixed
+            //    number of blocks, so that the result does not depend on
+            //    the number of threads
             Size N = exerciseData.front().values.size();
-            std::vector<Real> temp(N+1);
-            SequenceStatistics stats(N+1);
-
-            Size j;
-            for (j=0; j<exerciseData.size(); ++j) {
-                if (exerciseData[j].isValid) {
-                    std::copy(exerciseData[j].values.begin(),
-                              exerciseData[j].values.end(),
-                              temp.begin());
-                    temp.back() = exerciseData[j].cumulatedCashFlows
-                                - exerciseData[j].controlValue;
-
-                    stats.add(temp);
+            long paths = exerciseData.size();
+            long blocks = std::min<long>(paths, 64);
+            std::vector<IncrementalLinearLeastSquares> partial(
+                                     blocks, IncrementalLinearLeastSquares(N));
+
+            std::vector<std::string> errors(blocks);
+            #pragma omp parallel for
+            for (long b=0; b<blocks; ++b) {
+                // exceptions must not escape the parallel region
+                try {
+                    for (long j=b*paths/blocks; j<(b+1)*paths/blocks; ++j) {
+                        if (exerciseData[j].isValid)
+                            partial[b].add(exerciseData[j].values.begin(),
+                                           exerciseData[j].values.end(),
+                                           exerciseData[j].cumulatedCashFlows
+                                           - exerciseData[j].controlValue);
+                    }
+                } catch (std::exception& e) {
+                    errors[b] = e.what();
+                } catch (...) {
+                    errors[b] = "unknown error";
                 }
             }
+            for (long b=0; b<blocks; ++b)
+                QL_REQUIRE(errors[b].empty(), errors[b]);
 
-            std::vector<Real> means = stats.mean();
-            Matrix covariance = stats.covariance();
-
-            Matrix C(N,N);
-            Array target(N);
-            for (Size k=0; k<N; ++k) {
-                target[k] = covariance[k][N] + means[k]*means[N];
-                for (Size l=0; l<=k; ++l)
-                    C[k][l] = C[l][k] = covariance[k][l] + means[k]*means[l];
-            }
+            IncrementalLinearLeastSquares regression(N);
+            for (long b=0; b<blocks; ++b)
+                regression.add(partial[b]);
 
             // 2) solve for least squares regression
-            Array alphas = SVD(C).solveFor(target);
+            Array alphas = regression.coefficients();
             basisCoefficients[i-1].resize(N);
             std::copy(alphas.begin(), alphas.end(),
                       basisCoefficients[i-1].begin());
 
             // 3) use exercise strategy to divide paths into exercise and
             //    non-exercise domains
-            for (j=0; j<exerciseData.size(); ++j) {
-                if (exerciseData[j].isValid) {
-                    Real exerciseValue = exerciseData[j].exerciseValue;
-                    Real continuationValue =
-                        exerciseData[j].cumulatedCashFlows;
-                    Real estimatedContinuationValue =
-                        std::inner_product(
-                                 exerciseData[j].values.begin(),
-                                 exerciseData[j].values.end(),
-                                 alphas.begin(),
-                                 exerciseData[j].controlValue);
-
-                    // for exercise paths, add deflated rebate to
-                    // deflated cash-flows at previous time frame;
-                    // for non-exercise paths, add deflated cash-flows to
-                    // deflated cash-flows at previous time frame
-                    Real value = estimatedContinuationValue <= exerciseValue ?
-                                 exerciseValue :
-                                 continuationValue;
-
-                    simulationData[i-1][j].cumulatedCashFlows += value;
+            #pragma omp parallel for
+            for (long b=0; b<blocks; ++b) {
+                try {
+                    for (long j=b*paths/blocks; j<(b+1)*paths/blocks; ++j) {
+                        if (!exerciseData[j].isValid)
+                            continue;
+                        Real exerciseValue = exerciseData[j].exerciseValue;
+                        Real continuationValue =
+                            exerciseData[j].cumulatedCashFlows;
+                        Real estimatedContinuationValue =
+                            std::inner_product(
+                                     exerciseData[j].values.begin(),
+                                     exerciseData[j].values.end(),
+                                     alphas.begin(),
+                                     exerciseData[j].controlValue);
+
+                        // for exercise paths, add deflated rebate to
+                        // deflated cash-flows at previous time frame;
+                        // for non-exercise paths, add deflated cash-flows
+                        // to deflated cash-flows at previous time frame
+                        Real value =
+                            estimatedContinuationValue <= exerciseValue ?
+                            exerciseValue :
+                            continuationValue;
+
+                        simulationData[i-1][j].cumulatedCashFlows += value;
+                    }
+                } catch (std::exception& e) {
+                    errors[b] = e.what();
+                } catch (...) {
+                    errors[b] = "unknown error";
                 }
             }
+            for (long b=0; b<blocks; ++b)
+                QL_REQUIRE(errors[b].empty(), errors[b]);
         }
 
         // the value of the product can now be estimated by averaging
         // over all paths
-        Statistics estimate;
+        IncrementalStatistics estimate;
         std::vector<NodeData>& estimatedData = simulationData[0];
         for (Size j=0; j<estimatedData.size(); ++j)
             estimate.add(estimatedData[j].cumulatedCashFlows);
@@ -26,7 +26,7 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
-#include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
 
@@ -45,6 +45,72 @@
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // calibration paths stored by the path pricer
+        template <class PathType>
+        class LsStoredPaths {
+          public:
+            explicit LsStoredPaths(const std::vector<PathType>& paths)
+            : paths_(paths) {}
+            Size size() const { return paths_.size(); }
+            void restart() {}
+            void load(Size, Size) {}
+            const PathType& operator[](Size j) const { return paths_[j]; }
+          private:
+            const std::vector<PathType>& paths_;
+        };
+
+        // calibration paths drawn again from a new generator at each
+        // restart; only the paths being processed are kept
+        template <class PathGenerator>
+        class LsGeneratedPaths {
+          public:
+            typedef typename PathGenerator::sample_type::value_type
+                                                                path_type;
+            LsGeneratedPaths(
+                const boost::function<boost::shared_ptr<PathGenerator>()>&
+                                                             newGenerator,
+                Size samples,
+                bool antitheticVariate)
+            : newGenerator_(newGenerator), samples_(samples),
+              antitheticVariate_(antitheticVariate), first_(0) {}
+            Size size() const {
+                return antitheticVariate_ ? 2*samples_ : samples_;
+            }
+            void restart() {
+                generator_ = newGenerator_();
+                QL_REQUIRE(generator_, "null path generator");
+                first_ = 0;
+                buffer_.clear();
+            }
+            // paths must be loaded in sequence after a restart
+            void load(Size first, Size m) {
+                QL_REQUIRE(first == first_ + buffer_.size(),
+                           "calibration paths must be loaded in sequence");
+                first_ = first;
+                buffer_.clear();
+                while (buffer_.size() < m) {
+                    buffer_.push_back(generator_->next().value);
+                    if (antitheticVariate_)
+                        buffer_.push_back(generator_->antithetic().value);
+                }
+            }
+            const path_type& operator[](Size j) const {
+                return buffer_[j-first_];
+            }
+          private:
+            boost::function<boost::shared_ptr<PathGenerator>()>
+                                                            newGenerator_;
+            Size samples_;
+            bool antitheticVariate_;
+            boost::shared_ptr<PathGenerator> generator_;
+            Size first_;
+            std::vector<path_type> buffer_;
+        };
+
+    }
+
     //! Longstaff-Schwarz path pricer for early exercise options
     /*! References:
 
@@ -52,15 +118,40 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        The pricer can be calibrated in two ways.  Paths passed to it
+        before calibrate() is called are stored, so that memory grows
+        with their number and length.  Alternatively, calibrate() can
+        be given a function returning a new path generator which
+        replays the same paths each time; the paths are then drawn
+        again for each exercise time and processed in chunks of
+        calibrationChunk paths, so that only one value per path is
+        kept.  This trades memory for one path generation per
+        exercise time.  Either way, the regression only keeps the
+        triangular factor of the basis function values.
+
+        \warning with OpenMP enabled, calibration calls the early
+                 exercise path pricer (its operator() and state()
+                 methods) and its basis functions from several threads
+                 at once.  They must therefore be reentrant, i.e., not
+                 modify any state shared between calls.
+
         \ingroup mcarlo
 
-        \test the correctness of the returned value is tested by
-              reproducing results available in web/literature
+        \test
+        - the correctness of the returned value is tested by
+          reproducing results available in web/literature
+        - the regression is checked against a serial one, and
+          calibration on regenerated paths against calibration on
+          stored ones.
     */
     template <class PathType>
     class LongstaffSchwartzPathPricer : public PathPricer<PathType> {
       public:
         typedef typename EarlyExerciseTraits<PathType>::StateType StateType;
+        //! calibration paths processed by each thread at a time
+        static const Size calibrationBlock = 128;
+        //! calibration paths drawn at a time when regenerating them
+        static const Size calibrationChunk = 32*calibrationBlock;
 
         LongstaffSchwartzPathPricer(
             const TimeGrid& times,
@@ -68,7 +159,20 @@ namespace QuantLib {
             const boost::shared_ptr<YieldTermStructure>& termStructure);
 
         Real operator()(const PathType& path) const;
+        //! calibrates on the paths passed so far
         virtual void calibrate();
+        //! calibrates on paths regenerated for each exercise time
+        /*! \param newPathGenerator must return, at each call, a new
+                   generator drawing the same sequence of paths.
+            \param samples number of samples; each of them yields two
+                   paths when antithetic variates are used.
+        */
+        template <class PathGenerator>
+        void calibrate(
+            const boost::function<boost::shared_ptr<PathGenerator>()>&
+                                                         newPathGenerator,
+            Size samples,
+            bool antitheticVariate = false);
 
       protected:
         bool  calibrationPhase_;
@@ -80,8 +184,22 @@ namespace QuantLib {
 
         mutable std::vector<PathType> paths_;
         const   std::vector<boost::function1<Real, StateType> > v_;
+
+      private:
+        // discounts the value of a path to the i-th time and
+        // exercises if the estimated continuation value is lower
+        Real rollBack(const PathType& path, Size i, Real price) const;
+        template <class PathSource>
+        void regress(PathSource& paths);
+        const Size len_;
     };
 
+    template <class PathType>
+    const Size LongstaffSchwartzPathPricer<PathType>::calibrationBlock;
+
+    template <class PathType>
+    const Size LongstaffSchwartzPathPricer<PathType>::calibrationChunk;
+
     template <class PathType> inline
     LongstaffSchwartzPathPricer<PathType>::LongstaffSchwartzPathPricer(
         const TimeGrid& times,
@@ -92,7 +210,8 @@ namespace QuantLib {
       pathPricer_(pathPricer),
       coeff_     (new Array[times.size()-1]),
       dF_        (new DiscountFactor[times.size()-1]),
-      v_         (pathPricer_->basisSystem()) {
+      v_         (pathPricer_->basisSystem()),
+      len_       (times.size()) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -112,81 +231,151 @@ namespace QuantLib {
 
         const Size len = EarlyExerciseTraits<PathType>::pathLength(path);
         Real price = (*pathPricer_)(path, len-1);
-        for (Size i=len-2; i>0; --i) {
-            price*=dF_[i];
+        for (Size i=len-2; i>0; --i)
+            price = rollBack(path, i, price);
 
-            const Real exercise = (*pathPricer_)(path, i);
-            if (exercise > 0.0) {
-                const StateType regValue = pathPricer_->state(path, i);
+        return price*dF_[0];
+    }
 
-                Real continuationValue = 0.0;
-                for (Size l=0; l<v_.size(); ++l) {
-                    continuationValue += coeff_[i][l] * v_[l](regValue);
-                }
+    template <class PathType> inline
+    Real LongstaffSchwartzPathPricer<PathType>::rollBack(
+                          const PathType& path, Size i, Real price) const {
+        price *= dF_[i];
 
-                if (continuationValue < exercise) {
-                    price = exercise;
-                }
+        const Real exercise = (*pathPricer_)(path, i);
+        if (exercise > 0.0) {
+            const StateType regValue = pathPricer_->state(path, i);
+
+            Real continuationValue = 0.0;
+            for (Size l=0; l<v_.size(); ++l) {
+                continuationValue += coeff_[i][l] * v_[l](regValue);
             }
-        }
 
-        return price*dF_[0];
+            if (continuationValue < exercise) {
+                price = exercise;
+            }
+        }
+        return price;
     }
 
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
-        const Size n = paths_.size();
-        Array prices(n), exercise(n);
-        const Size len = EarlyExerciseTraits<PathType>::pathLength(paths_[0]);
-
-        for (Size i=0; i<n; ++i)
-            prices[i] = (*pathPricer_)(paths_[i], len-1);
-
-        std::vector<Real>      y;
-        std::vector<StateType> x;
-        for (Size i=len-2; i>0; --i) {
-            y.clear();
-            x.clear();
-
-            //roll back step
-            for (Size j=0; j<n; ++j) {
-                exercise[j]=(*pathPricer_)(paths_[j], i);
-
-                if (exercise[j]>0.0) {
-                    x.push_back(pathPricer_->state(paths_[j], i));
-                    y.push_back(dF_[i]*prices[j]);
+        detail::LsStoredPaths<PathType> paths(paths_);
+        regress(paths);
+
+        // remove calibration paths and release memory
+        std::vector<PathType> empty;
+        paths_.swap(empty);
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
+    template <class PathType>
+    template <class PathGenerator>
+    inline void LongstaffSchwartzPathPricer<PathType>::calibrate(
+            const boost::function<boost::shared_ptr<PathGenerator>()>&
+                                                         newPathGenerator,
+            Size samples,
+            bool antitheticVariate) {
+        detail::LsGeneratedPaths<PathGenerator> paths(newPathGenerator,
+                                                      samples,
+                                                      antitheticVariate);
+        regress(paths);
+
+        // paths passed before are not used
+        std::vector<PathType> empty;
+        paths_.swap(empty);
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
+    template <class PathType>
+    template <class PathSource>
+    inline void LongstaffSchwartzPathPricer<PathType>::regress(
+                                                        PathSource& paths) {
+        const Size n = paths.size();
+        QL_REQUIRE(n > 0, "no calibration paths given");
+
+        // value of each path at the exercise time being processed;
+        // the paths themselves are not needed across exercise times
+        Array prices(n);
+
+        std::vector<IncrementalLinearLeastSquares> partial;
+        std::vector<std::string> errors;
+
+        for (Size i=len_-2; i>0; --i) {
+
+            // a single pass over the paths rolls them back from the
+            // previous exercise time, with the coefficients found
+            // there, and regresses their values at this one.  The
+            // regression is accumulated over blocks of a fixed size,
+            // so that the result does not depend on the number of
+            // threads.
+            IncrementalLinearLeastSquares regression(v_.size());
+            paths.restart();
+            for (Size first=0; first<n; first+=calibrationChunk) {
+                const Size m = std::min(calibrationChunk, n-first);
+                paths.load(first, m);
+
+                const long blocks =
+                    long((m + calibrationBlock - 1) / calibrationBlock);
+                partial.assign(blocks,
+                               IncrementalLinearLeastSquares(v_.size()));
+                errors.assign(blocks, std::string());
+
+                #pragma omp parallel for
+                for (long b=0; b<blocks; ++b) {
+                    // exceptions must not escape the parallel region
+                    try {
+                        Array basis(v_.size());
+                        const Size begin = first + b*calibrationBlock;
+                        const Size end =
+                            std::min(begin + calibrationBlock, first + m);
+                        for (Size j=begin; j<end; ++j) {
+                            const PathType& path = paths[j];
+                            if (i == len_-2) {
+                                QL_REQUIRE(
+                                    EarlyExerciseTraits<PathType>::
+                                        pathLength(path) == len_,
+                                    "calibration path doesn't match "
+                                    "the time grid");
+                                prices[j] = (*pathPricer_)(path, len_-1);
+                            } else {
+                                prices[j] = rollBack(path, i+1, prices[j]);
+                            }
+
+                            const Real exercise = (*pathPricer_)(path, i);
+                            if (exercise > 0.0) {
+                                const StateType regValue =
+                                    pathPricer_->state(path, i);
+                                for (Size l=0; l<v_.size(); ++l)
+                                    basis[l] = v_[l](regValue);
+                                partial[b].add(basis.begin(), basis.end(),
+                                               dF_[i]*prices[j]);
+                            }
+                        }
+                    } catch (std::exception& e) {
+                        errors[b] = e.what();
+                    } catch (...) {
+                        errors[b] = "unknown error";
+                    }
                 }
+                for (long b=0; b<blocks; ++b)
+                    QL_REQUIRE(errors[b].empty(), errors[b]);
+
+                for (long b=0; b<blocks; ++b)
+                    regression.add(partial[b]);
             }
 
-            if (v_.size() <=  x.size()) {
-                coeff_[i] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+            if (v_.size() <= regression.samples()) {
+                coeff_[i] = regression.coefficients();
             }
             else {
             // if number of itm paths is smaller then the number of
             // calibration functions then early exercise if exerciseValue > 0
                 coeff_[i] = Array(v_.size(), 0.0);
             }
-
-            for (Size j=0, k=0; j<n; ++j) {
-                prices[j]*=dF_[i];
-                if (exercise[j]>0.0) {
-                    Real continuationValue = 0.0;
-                    for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i][l] * v_[l](x[k]);
-                    }
-                    if (continuationValue < exercise[j]) {
-                        prices[j] = exercise[j];
-                    }
-                    ++k;
-                }
-            }
         }
-
-        // remove calibration paths and release memory
-        std::vector<PathType> empty;
-        paths_.swap(empty);
-        // entering the calculation phase
-        calibrationPhase_ = false;
     }
 }
 
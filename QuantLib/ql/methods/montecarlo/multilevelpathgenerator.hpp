@@ -0,0 +1,178 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file multilevelpathgenerator.hpp
+    \brief Generates coupled fine and coarse paths for multilevel MC
+*/
+
+#ifndef quantlib_multilevel_path_generator_hpp
+#define quantlib_multilevel_path_generator_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/stochasticprocess.hpp>
+
+namespace QuantLib {
+
+    //! Generates a fine path and a coupled coarse path
+    /*! The fine path is evolved on the given time grid using the
+        sequence drawn from the generator.  The coarse grid is made
+        of every <tt>refinement</tt>-th point of the fine grid; the
+        coarse path is evolved on it with the Brownian increments
+        obtained by summing the fine ones over each coarse step, so
+        that both paths are driven by the same Brownian motion as
+        required by multilevel Monte Carlo.
+
+        A refinement equal to 1 disables the coarse path; this is
+        used for the coarsest level of the simulation.
+
+        \ingroup mcarlo
+    */
+    template <class GSG>
+    class MultilevelPathGenerator {
+      public:
+        typedef Sample<MultiPath> sample_type;
+        MultilevelPathGenerator(const boost::shared_ptr<StochasticProcess>&,
+                                const TimeGrid& fineGrid,
+                                Size refinement,
+                                GSG generator);
+        //! draws a new fine path and the coupled coarse path
+        const sample_type& next() const;
+        //! coarse path coupled to the last fine path
+        const sample_type& coarse() const;
+        const TimeGrid& fineGrid() const { return fineGrid_; }
+        const TimeGrid& coarseGrid() const { return coarseGrid_; }
+        Size refinement() const { return refinement_; }
+      private:
+        boost::shared_ptr<StochasticProcess> process_;
+        TimeGrid fineGrid_, coarseGrid_;
+        Size refinement_;
+        GSG generator_;
+        mutable sample_type fine_, coarse_;
+        mutable Array x_, dw_, coarseX_, coarseDw_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    MultilevelPathGenerator<GSG>::MultilevelPathGenerator(
+                   const boost::shared_ptr<StochasticProcess>& process,
+                   const TimeGrid& fineGrid,
+                   Size refinement,
+                   GSG generator)
+    : process_(process), fineGrid_(fineGrid), refinement_(refinement),
+      generator_(generator),
+      fine_(MultiPath(process->size(), fineGrid), 1.0),
+      coarse_(MultiPath(), 1.0),
+      x_(process->size()), dw_(process->factors()),
+      coarseX_(process->size()), coarseDw_(process->factors()) {
+
+        QL_REQUIRE(fineGrid.size() > 1,
+                   "no times given");
+        QL_REQUIRE(refinement > 0,
+                   "refinement must be positive");
+        QL_REQUIRE((fineGrid.size()-1) % refinement == 0,
+                   "number of fine steps (" << fineGrid.size()-1
+                   << ") is not a multiple of the refinement ("
+                   << refinement << ")");
+        QL_REQUIRE(generator_.dimension() ==
+                   process->factors()*(fineGrid.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << process->factors() << " * " << fineGrid.size()-1
+                   << ") the number of factors "
+                   << "times the number of time steps");
+
+        if (refinement_ > 1) {
+            std::vector<Time> times;
+            for (Size i=0; i<fineGrid.size(); i+=refinement_)
+                times.push_back(fineGrid[i]);
+            coarseGrid_ = TimeGrid(times.begin(), times.end());
+            coarse_ = sample_type(MultiPath(process->size(), coarseGrid_),
+                                  1.0);
+        }
+    }
+
+    template <class GSG>
+    const typename MultilevelPathGenerator<GSG>::sample_type&
+    MultilevelPathGenerator<GSG>::next() const {
+
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence_ = generator_.nextSequence();
+
+        Size m = process_->size();
+        Size n = process_->factors();
+
+        MultiPath& path = fine_.value;
+        x_ = process_->initialValues();
+        for (Size j=0; j<m; j++)
+            path[j].front() = x_[j];
+        fine_.weight = sequence_.weight;
+
+        bool coupled = (refinement_ > 1);
+        if (coupled) {
+            coarseX_ = x_;
+            for (Size j=0; j<m; j++)
+                coarse_.value[j].front() = x_[j];
+            coarse_.weight = sequence_.weight;
+            std::fill(coarseDw_.begin(), coarseDw_.end(), 0.0);
+        }
+
+        for (Size i=1; i<path.pathSize(); i++) {
+            Time t = fineGrid_[i-1], dt = fineGrid_.dt(i-1);
+            std::copy(sequence_.value.begin()+(i-1)*n,
+                      sequence_.value.begin()+i*n,
+                      dw_.begin());
+            x_ = process_->evolve(t, x_, dt, dw_);
+            for (Size j=0; j<m; j++)
+                path[j][i] = x_[j];
+
+            if (coupled) {
+                // accumulate the Brownian increment over the coarse step
+                Real sqrtDt = std::sqrt(dt);
+                for (Size f=0; f<n; f++)
+                    coarseDw_[f] += sqrtDt*dw_[f];
+                if (i % refinement_ == 0) {
+                    Size k = i/refinement_;
+                    Time coarseT = coarseGrid_[k-1];
+                    Time coarseDt = coarseGrid_.dt(k-1);
+                    coarseDw_ /= std::sqrt(coarseDt);
+                    coarseX_ = process_->evolve(coarseT, coarseX_,
+                                                coarseDt, coarseDw_);
+                    for (Size j=0; j<m; j++)
+                        coarse_.value[j][k] = coarseX_[j];
+                    std::fill(coarseDw_.begin(), coarseDw_.end(), 0.0);
+                }
+            }
+        }
+
+        return fine_;
+    }
+
+    template <class GSG>
+    inline const typename MultilevelPathGenerator<GSG>::sample_type&
+    MultilevelPathGenerator<GSG>::coarse() const {
+        QL_REQUIRE(refinement_ > 1, "no coarse path for unit refinement");
+        return coarse_;
+    }
+
+}
+
+
+#endif
@@ -28,6 +28,7 @@
 #define quantlib_multi_path_generator_hpp
 
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/batchpathgenerator.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/stochasticprocess.hpp>
 
@@ -42,6 +43,15 @@ namespace QuantLib {
         };
         \endcode
 
+        If a path block larger than one is given, the sequences for
+        that many paths are drawn at once and the paths are evolved
+        together by a BatchPathEvolver; for a StochasticProcessArray,
+        this applies the correlation to the whole block with a
+        matrix-matrix product at each time step and yields the same
+        paths as the path-by-path generation.  The returned paths
+        are then copied out of the block one at a time.  The block
+        is reduced if needed, so that it holds at most 2^18 values.
+
         \ingroup mcarlo
 
         \test the generated paths are checked against cached results
@@ -50,31 +60,52 @@ namespace QuantLib {
     class MultiPathGenerator {
       public:
         typedef Sample<MultiPath> sample_type;
+        //! path block used by default by the multi-asset engines
+        static const Size defaultPathBlock = 64;
         MultiPathGenerator(const boost::shared_ptr<StochasticProcess>&,
                            const TimeGrid&,
                            GSG generator,
-                           bool brownianBridge = false);
+                           bool brownianBridge = false,
+                           Size pathBlock = 1);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        //! underlying sequence generator
+        GSG& sequenceGenerator() { return generator_; }
+        Size pathBlock() const { return pathBlock_; }
       private:
         const sample_type& next(bool antithetic) const;
+        const sample_type& nextFromBlock(bool antithetic) const;
         bool brownianBridge_;
         boost::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        Size pathBlock_;
+        BatchPathEvolver blockEvolver_;
+        mutable PathBatch block_, antitheticBlock_;
+        mutable std::vector<Real> dw_;
+        mutable Size blockPosition_;
+        mutable bool antitheticBlockEvolved_;
     };
 
 
     // template definitions
 
+    template <class GSG>
+    const Size MultiPathGenerator<GSG>::defaultPathBlock;
+
     template <class GSG>
     MultiPathGenerator<GSG>::MultiPathGenerator(
                    const boost::shared_ptr<StochasticProcess>& process,
                    const TimeGrid& times,
                    GSG generator,
-                   bool brownianBridge)
+                   bool brownianBridge,
+                   Size pathBlock)
     : brownianBridge_(brownianBridge), process_(process),
-      generator_(generator), next_(MultiPath(process->size(), times), 1.0) {
+      generator_(generator), next_(MultiPath(process->size(), times), 1.0),
+      pathBlock_(std::max<Size>(std::min<Size>(pathBlock,
+                         (1 << 18)/(process->size()*times.size())), 1)),
+      blockEvolver_(process), blockPosition_(Null<Size>()),
+      antitheticBlockEvolved_(false) {
 
         QL_REQUIRE(generator_.dimension() ==
                    process->factors()*(times.size()-1),
@@ -85,6 +116,11 @@ namespace QuantLib {
                    << "times the number of time steps");
         QL_REQUIRE(times.size() > 1,
                    "no times given");
+
+        if (pathBlock_ > 1) {
+            block_ = PathBatch(process->size(), times, pathBlock_);
+            dw_.resize(generator_.dimension()*pathBlock_);
+        }
     }
 
     template <class GSG>
@@ -107,6 +143,10 @@ namespace QuantLib {
 
             QL_FAIL("Brownian bridge not supported");
 
+        } else if (pathBlock_ > 1) {
+
+            return nextFromBlock(antithetic);
+
         } else {
 
             typedef typename GSG::sample_type sequence_type;
@@ -150,6 +190,48 @@ namespace QuantLib {
         }
     }
 
+    template <class GSG>
+    const typename MultiPathGenerator<GSG>::sample_type&
+    MultiPathGenerator<GSG>::nextFromBlock(bool antithetic) const {
+
+        if (antithetic) {
+            QL_REQUIRE(blockPosition_ != Null<Size>(),
+                       "no path generated yet");
+            // the variates of the block are kept in dw_, so that the
+            // antithetic block only needs to be evolved again once
+            if (!antitheticBlockEvolved_) {
+                if (antitheticBlock_.pathNumber() == 0)
+                    antitheticBlock_ = block_;
+                blockEvolver_.evolve(dw_, true, antitheticBlock_);
+                antitheticBlockEvolved_ = true;
+            }
+            antitheticBlock_.extract(blockPosition_, next_.value);
+            next_.weight = block_.weight(blockPosition_);
+            return next_;
+        }
+
+        if (blockPosition_ == Null<Size>() ||
+            blockPosition_+1 == pathBlock_) {
+            typedef typename GSG::sample_type sequence_type;
+            Size dimension = generator_.dimension();
+            for (Size k=0; k<pathBlock_; ++k) {
+                const sequence_type& sequence_ = generator_.nextSequence();
+                block_.weight(k) = sequence_.weight;
+                for (Size d=0; d<dimension; ++d)
+                    dw_[d*pathBlock_+k] = sequence_.value[d];
+            }
+            blockEvolver_.evolve(dw_, false, block_);
+            antitheticBlockEvolved_ = false;
+            blockPosition_ = 0;
+        } else {
+            ++blockPosition_;
+        }
+
+        block_.extract(blockPosition_, next_.value);
+        next_.weight = block_.weight(blockPosition_);
+        return next_;
+    }
+
 }
 
 #endif
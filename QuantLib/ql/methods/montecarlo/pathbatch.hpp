@@ -0,0 +1,137 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file pathbatch.hpp
+    \brief Batch of single- or multi-asset paths in a contiguous buffer
+*/
+
+#ifndef quantlib_montecarlo_path_batch_hpp
+#define quantlib_montecarlo_path_batch_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Batch of paths sharing the same time grid
+    /*! The values of all paths in the batch are stored in a single
+        buffer laid out as (time, asset, path); that is, the values
+        of a given asset at a given time are contiguous across the
+        paths of the batch.  This allows evolution kernels to sweep
+        a whole batch one time step at a time.
+
+        \ingroup mcarlo
+
+        \note as for Path, the initial asset values are stored as the
+              first time point.
+    */
+    class PathBatch {
+      public:
+        PathBatch() : assets_(0), paths_(0) {}
+        PathBatch(Size nAsset,
+                  const TimeGrid& timeGrid,
+                  Size nPaths);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return assets_; }
+        Size pathSize() const { return timeGrid_.size(); }
+        Size pathNumber() const { return paths_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+        //! \name read/write access to components
+        //@{
+        //! value of the j-th asset at the i-th time on the k-th path
+        Real operator()(Size i, Size j, Size k) const;
+        Real& operator()(Size i, Size j, Size k);
+        //! values of the j-th asset at the i-th time across the batch
+        const Real* slice(Size i, Size j) const;
+        Real* slice(Size i, Size j);
+        Real weight(Size k) const { return weights_[k]; }
+        Real& weight(Size k) { return weights_[k]; }
+        //@}
+        //! \name conversion
+        //@{
+        //! copies the k-th path of a single-asset batch
+        void extract(Size k, Path& path) const;
+        //! copies the k-th path of the batch
+        void extract(Size k, MultiPath& path) const;
+        //@}
+      private:
+        TimeGrid timeGrid_;
+        Size assets_, paths_;
+        std::vector<Real> values_;
+        std::vector<Real> weights_;
+    };
+
+
+    // inline definitions
+
+    inline PathBatch::PathBatch(Size nAsset,
+                                const TimeGrid& timeGrid,
+                                Size nPaths)
+    : timeGrid_(timeGrid), assets_(nAsset), paths_(nPaths),
+      values_(timeGrid.size()*nAsset*nPaths, 0.0), weights_(nPaths, 1.0) {
+        QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+        QL_REQUIRE(nPaths > 0, "number of paths must be positive");
+    }
+
+    inline Real PathBatch::operator()(Size i, Size j, Size k) const {
+        return values_[(i*assets_+j)*paths_+k];
+    }
+
+    inline Real& PathBatch::operator()(Size i, Size j, Size k) {
+        return values_[(i*assets_+j)*paths_+k];
+    }
+
+    inline const Real* PathBatch::slice(Size i, Size j) const {
+        return &values_[(i*assets_+j)*paths_];
+    }
+
+    inline Real* PathBatch::slice(Size i, Size j) {
+        return &values_[(i*assets_+j)*paths_];
+    }
+
+    inline void PathBatch::extract(Size k, Path& path) const {
+        QL_REQUIRE(assets_ == 1,
+                   "single-asset path requested from a batch of "
+                   << assets_ << " assets");
+        QL_REQUIRE(path.length() == timeGrid_.size(),
+                   "path length (" << path.length()
+                   << ") differs from time-grid size ("
+                   << timeGrid_.size() << ")");
+        for (Size i=0; i<timeGrid_.size(); ++i)
+            path[i] = values_[i*paths_+k];
+    }
+
+    inline void PathBatch::extract(Size k, MultiPath& path) const {
+        QL_REQUIRE(path.assetNumber() == assets_,
+                   "number of assets (" << path.assetNumber()
+                   << ") differs from batch (" << assets_ << ")");
+        QL_REQUIRE(path.pathSize() == timeGrid_.size(),
+                   "path length (" << path.pathSize()
+                   << ") differs from time-grid size ("
+                   << timeGrid_.size() << ")");
+        for (Size i=0; i<timeGrid_.size(); ++i)
+            for (Size j=0; j<assets_; ++j)
+                path[j][i] = values_[(i*assets_+j)*paths_+k];
+    }
+
+}
+
+
+#endif
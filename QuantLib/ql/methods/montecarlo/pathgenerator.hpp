@@ -61,6 +61,8 @@ namespace QuantLib {
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        //! underlying sequence generator
+        GSG& sequenceGenerator() { return generator_; }
       private:
         const sample_type& next(bool antithetic) const;
         bool brownianBridge_;
@@ -122,4 +122,52 @@ namespace QuantLib {
         }
     }
 
+
+    ParallelAccountingEngine::ParallelAccountingEngine(
+             const std::vector<boost::shared_ptr<MarketModelEvolver> >& evolvers,
+             const Clone<MarketModelMultiProduct>& product,
+             Real initialNumeraireValue)
+    : evolvers_(evolvers), usedPaths_(evolvers.size(), 0),
+      numberProducts_(product->numberOfProducts()), totalPaths_(0) {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        for (Size i=0; i<evolvers.size(); ++i)
+            engines_.push_back(boost::shared_ptr<AccountingEngine>(
+                 new AccountingEngine(evolvers[i], product,
+                                      initialNumeraireValue)));
+    }
+
+    void ParallelAccountingEngine::multiplePathValues(
+                                                 SequenceStatisticsInc& stats,
+                                                 Size numberOfPaths) {
+        const long workers = engines_.size();
+        std::vector<std::vector<Real> > values(
+                          numberOfPaths, std::vector<Real>(numberProducts_));
+        std::vector<Real> weights(numberOfPaths);
+        std::vector<std::string> errors(workers);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (long w=0; w<workers; ++w) {
+            Size begin = w*numberOfPaths/workers,
+                 end = (w+1)*numberOfPaths/workers;
+            try {
+                // skip the paths generated by the other workers
+                evolvers_[w]->skipPaths(totalPaths_ + begin - usedPaths_[w]);
+                for (Size i=begin; i<end; ++i)
+                    weights[i] = engines_[w]->singlePathValues(values[i]);
+                usedPaths_[w] = totalPaths_ + end;
+            } catch (std::exception& e) {
+                errors[w] = e.what();
+            } catch (...) {
+                errors[w] = "unknown error";
+            }
+        }
+
+        for (long w=0; w<workers; ++w)
+            QL_REQUIRE(errors[w].empty(), errors[w]);
+
+        for (Size i=0; i<numberOfPaths; ++i)
+            stats.add(values[i], weights[i]);
+        totalPaths_ += numberOfPaths;
+    }
+
 }
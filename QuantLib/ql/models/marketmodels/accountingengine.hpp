@@ -49,6 +49,7 @@ namespace QuantLib {
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
+        friend class ParallelAccountingEngine;
         Real singlePathValues(std::vector<Real>& values);
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
@@ -66,6 +67,37 @@ namespace QuantLib {
 
     };
 
+    //! Accounting engine distributing the paths over several evolvers
+    /*! Each evolver is used by a separate AccountingEngine with its
+        own copy of the product, and the engines are run in parallel
+        when OpenMP is enabled.  The paths of each call are split in
+        contiguous blocks, and each evolver skips to the start of its
+        block; thus, if the evolvers are built in the same way (e.g.,
+        from the same Brownian-generator factory) the results equal
+        those of a single AccountingEngine, whatever the number of
+        evolvers.
+
+        \pre the evolvers must not share any state, and must not have
+             generated any path before being passed to the engine.
+
+        \note the values of all paths of a call are stored before being
+              added to the statistics in path order.
+    */
+    class ParallelAccountingEngine {
+      public:
+        ParallelAccountingEngine(
+             const std::vector<boost::shared_ptr<MarketModelEvolver> >& evolvers,
+             const Clone<MarketModelMultiProduct>& product,
+             Real initialNumeraireValue);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        std::vector<boost::shared_ptr<AccountingEngine> > engines_;
+        std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers_;
+        std::vector<Size> usedPaths_;
+        Size numberProducts_, totalPaths_;
+    };
+
 }
 
 #endif
@@ -37,6 +37,18 @@ namespace QuantLib {
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
+        //! discards the next n paths
+        /*! The default implementation draws the paths and ignores
+            them; generators able to skip ahead should override it.
+        */
+        virtual void skipPaths(Size n) {
+            std::vector<Real> output(numberOfFactors());
+            for (Size i=0; i<n; ++i) {
+                nextPath();
+                for (Size j=0; j<numberOfSteps(); ++j)
+                    nextStep(output);
+            }
+        }
     };
 
     class BrownianGeneratorFactory {
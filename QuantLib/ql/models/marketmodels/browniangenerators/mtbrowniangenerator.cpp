@@ -56,6 +56,12 @@ namespace QuantLib {
 
     Size MTBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    void MTBrownianGenerator::skipPaths(Size n) {
+        for (Size i=0; i<n; ++i)
+            generator_.nextSequence();
+        lastStep_ = 0;
+    }
+
 
     MTBrownianGeneratorFactory::MTBrownianGeneratorFactory(unsigned long seed)
     : seed_(seed) {}
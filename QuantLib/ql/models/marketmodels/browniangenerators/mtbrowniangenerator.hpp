@@ -51,6 +51,8 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+        //! skips the uniform draws without transforming them
+        void skipPaths(Size n);
       private:
         Size factors_, steps_;
         Size lastStep_;
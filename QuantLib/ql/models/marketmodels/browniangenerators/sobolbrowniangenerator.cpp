@@ -118,7 +118,8 @@ namespace QuantLib {
                  InverseCumulativeNormal()),
       bridge_(steps), lastStep_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
-      bridgedVariates_(factors, std::vector<Real>(steps)) {
+      bridgedVariates_(factors, std::vector<Real>(steps)),
+      seed_(seed), integers_(integers), drawnPaths_(0) {
 
         switch (ordering_) {
           case Factors:
@@ -153,6 +154,7 @@ namespace QuantLib {
                               bridgedVariates_[i].begin());
         }
         lastStep_ = 0;
+        ++drawnPaths_;
         return sample.weight;
     }
     
@@ -208,6 +210,17 @@ namespace QuantLib {
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    void SobolBrownianGenerator::skipPaths(Size n) {
+        if (n == 0)
+            return;
+        SobolRsg rsg(factors_*steps_, seed_, integers_);
+        drawnPaths_ += n;
+        rsg.skipTo(drawnPaths_);
+        generator_ = InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal>(
+                                             rsg, InverseCumulativeNormal());
+        lastStep_ = 0;
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
@@ -59,6 +59,8 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+        //! skips ahead in the underlying Sobol sequence
+        void skipPaths(Size n);
         
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
@@ -74,6 +76,9 @@ namespace QuantLib {
         Size lastStep_;
         std::vector<std::vector<Size> > orderedIndices_;
         std::vector<std::vector<Real> > bridgedVariates_;
+        unsigned long seed_;
+        SobolRsg::DirectionIntegers integers_;
+        unsigned long drawnPaths_;
     };
 
     class SobolBrownianGeneratorFactory : public BrownianGeneratorFactory {
@@ -349,5 +349,75 @@ namespace QuantLib {
         return numeraireUnits/principalInNumerairePortfolio;
     }
 
-}
 
+    ParallelUpperBoundEngine::ParallelUpperBoundEngine(
+                   const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                                     evolvers,
+                   const std::vector<std::vector<
+                       boost::shared_ptr<MarketModelEvolver> > >& innerEvolvers,
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy,
+                   Real initialNumeraireValue)
+    : evolvers_(evolvers), innerEvolvers_(innerEvolvers),
+      usedPaths_(evolvers.size(), 0), usedInnerPaths_(evolvers.size(), 0),
+      totalPaths_(0), totalInnerPaths_(0) {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        QL_REQUIRE(innerEvolvers.size() == evolvers.size(),
+                   "number of inner evolver sets ("
+                   << innerEvolvers.size()
+                   << ") does not match number of evolvers ("
+                   << evolvers.size() << ")");
+        for (Size i=0; i<evolvers.size(); ++i)
+            engines_.push_back(boost::shared_ptr<UpperBoundEngine>(
+                 new UpperBoundEngine(evolvers[i], innerEvolvers[i],
+                                      underlying, rebate,
+                                      hedge, hedgeRebate, hedgeStrategy,
+                                      initialNumeraireValue)));
+    }
+
+
+    void ParallelUpperBoundEngine::multiplePathValues(Statistics& stats,
+                                                      Size outerPaths,
+                                                      Size innerPaths) {
+        const long workers = engines_.size();
+        std::vector<std::pair<Real,Real> > results(outerPaths);
+        std::vector<std::string> errors(workers);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (long w=0; w<workers; ++w) {
+            Size begin = w*outerPaths/workers,
+                 end = (w+1)*outerPaths/workers;
+            try {
+                // skip the paths generated by the other workers; each
+                // outer path uses every inner evolver for innerPaths paths
+                evolvers_[w]->skipPaths(totalPaths_ + begin - usedPaths_[w]);
+                Size innerSkip =
+                    totalInnerPaths_ + begin*innerPaths - usedInnerPaths_[w];
+                for (Size j=0; j<innerEvolvers_[w].size(); ++j)
+                    innerEvolvers_[w][j]->skipPaths(innerSkip);
+
+                for (Size i=begin; i<end; ++i)
+                    results[i] = engines_[w]->singlePathValue(innerPaths);
+
+                usedPaths_[w] = totalPaths_ + end;
+                usedInnerPaths_[w] = totalInnerPaths_ + end*innerPaths;
+            } catch (std::exception& e) {
+                errors[w] = e.what();
+            } catch (...) {
+                errors[w] = "unknown error";
+            }
+        }
+
+        for (long w=0; w<workers; ++w)
+            QL_REQUIRE(errors[w].empty(), errors[w]);
+
+        for (Size i=0; i<outerPaths; ++i)
+            stats.add(results[i].first, results[i].second);
+        totalPaths_ += outerPaths;
+        totalInnerPaths_ += outerPaths*innerPaths;
+    }
+
+}
@@ -80,6 +80,44 @@ namespace QuantLib {
         std::vector<MarketModelDiscounter> discounters_;
     };
 
+    //! Upper-bound %engine distributing the outer paths over several evolvers
+    /*! Each outer evolver, together with its own set of inner
+        evolvers, is used by a separate UpperBoundEngine with its own
+        copy of the products, and the engines are run in parallel
+        when OpenMP is enabled.  The outer paths of each call are
+        split in contiguous blocks, and all evolvers skip to the start
+        of their block; thus, if the evolvers are built in the same
+        way for every worker, the results equal those of a single
+        UpperBoundEngine, whatever the number of workers.
+
+        \pre the evolvers must not share any state, and must not have
+             generated any path before being passed to the engine.
+    */
+    class ParallelUpperBoundEngine {
+      public:
+        ParallelUpperBoundEngine(
+                   const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                                     evolvers,
+                   const std::vector<std::vector<
+                       boost::shared_ptr<MarketModelEvolver> > >& innerEvolvers,
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy,
+                   Real initialNumeraireValue);
+        void multiplePathValues(Statistics& stats,
+                                Size outerPaths,
+                                Size innerPaths);
+      private:
+        std::vector<boost::shared_ptr<UpperBoundEngine> > engines_;
+        std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers_;
+        std::vector<std::vector<boost::shared_ptr<MarketModelEvolver> > >
+                                                               innerEvolvers_;
+        std::vector<Size> usedPaths_, usedInnerPaths_;
+        Size totalPaths_, totalInnerPaths_;
+    };
+
 }
 
 #endif
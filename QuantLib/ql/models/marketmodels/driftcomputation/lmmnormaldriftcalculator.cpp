@@ -159,4 +159,109 @@ namespace QuantLib {
         }
     }
 
+    void LMMNormalDriftCalculator::compute(const Matrix& fwds,
+                                           Matrix& drifts) const {
+        QL_REQUIRE(fwds.rows()==numberOfRates_, "numberOfRates <> dim");
+        QL_REQUIRE(drifts.rows()==numberOfRates_ &&
+                   drifts.columns()==fwds.columns(),
+                   "drifts size <> forwards size");
+
+        if (isFullFactor_)
+            computePlain(fwds, drifts);
+        else
+            computeReduced(fwds, drifts);
+    }
+
+    void LMMNormalDriftCalculator::computePlain(const Matrix& forwards,
+                                                Matrix& drifts) const {
+
+        // Same algorithm as the single-path version, with the
+        // innermost loops running across paths.
+        Size n = forwards.columns();
+        if (tmpPaths_.columns() != n)
+            tmpPaths_ = Matrix(numberOfRates_, n, 0.0);
+
+        Size i, j, p;
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator f = forwards.row_begin(i);
+            Matrix::row_iterator tmp = tmpPaths_.row_begin(i);
+            for (p=0; p<n; ++p)
+                tmp[p] = 1.0/(oneOverTaus_[i]+f[p]);
+        }
+
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Matrix::row_iterator d = drifts.row_begin(i);
+            std::fill(d, d+n, 0.0);
+            for (j=downs_[i]; j<ups_[i]; ++j) {
+                Real c = C_[i][j];
+                Matrix::const_row_iterator tmp = tmpPaths_.row_begin(j);
+                for (p=0; p<n; ++p)
+                    d[p] += tmp[p]*c;
+            }
+            if (numeraire_>i+1) {
+                for (p=0; p<n; ++p)
+                    d[p] = -d[p];
+            }
+        }
+    }
+
+    void LMMNormalDriftCalculator::computeReduced(const Matrix& forwards,
+                                                  Matrix& drifts) const {
+
+        // Same algorithm as the single-path version, with the
+        // innermost loops running across paths; only the running
+        // sums e_r are needed, so they are kept for one rate at a time.
+        Size n = forwards.columns();
+        if (tmpPaths_.columns() != n)
+            tmpPaths_ = Matrix(numberOfRates_, n, 0.0);
+        if (ePaths_.columns() != n)
+            ePaths_ = Matrix(numberOfFactors_, n, 0.0);
+
+        Size r, p;
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator f = forwards.row_begin(i);
+            Matrix::row_iterator tmp = tmpPaths_.row_begin(i);
+            for (p=0; p<n; ++p)
+                tmp[p] = 1.0/(oneOverTaus_[i]+f[p]);
+        }
+
+        // 1st step: the drift corresponding to the numeraire is zero
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        // 2nd step: move backward from N-2 (included) back to alive
+        std::fill(ePaths_.begin(), ePaths_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Matrix::row_iterator d = drifts.row_begin(i);
+            Matrix::const_row_iterator tmp = tmpPaths_.row_begin(i+1);
+            std::fill(d, d+n, 0.0);
+            for (r=0; r<numberOfFactors_; ++r) {
+                Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                Matrix::row_iterator e = ePaths_.row_begin(r);
+                for (p=0; p<n; ++p) {
+                    e[p] += tmp[p] * a;
+                    d[p] -= e[p]*b;
+                }
+            }
+        }
+
+        // 3rd step: move forward from N (included) up to n (excluded)
+        std::fill(ePaths_.begin(), ePaths_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Matrix::row_iterator d = drifts.row_begin(i);
+            Matrix::const_row_iterator tmp = tmpPaths_.row_begin(i);
+            std::fill(d, d+n, 0.0);
+            for (r=0; r<numberOfFactors_; ++r) {
+                Real a = pseudo_[i][r];
+                Matrix::row_iterator e = ePaths_.row_begin(r);
+                for (p=0; p<n; ++p) {
+                    e[p] += tmp[p] * a;
+                    d[p] += e[p]*a;
+                }
+            }
+        }
+    }
+
 }
@@ -65,6 +65,21 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! \name Multi-path interface
+
+            Forwards and drifts are laid out with one row per rate
+            and one column per path, so that the inner loops run
+            across paths on contiguous memory.
+        */
+        //@{
+        void compute(const Matrix& fwds,
+                     Matrix& drifts) const;
+        void computePlain(const Matrix& fwds,
+                          Matrix& drifts) const;
+        void computeReduced(const Matrix& fwds,
+                            Matrix& drifts) const;
+        //@}
+
 
       private:
         Size numberOfRates_, numberOfFactors_;
@@ -75,6 +90,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix tmpPaths_, ePaths_;
         std::vector<Size> downs_, ups_;
     };
 
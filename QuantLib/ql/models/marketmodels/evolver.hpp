@@ -42,6 +42,18 @@ namespace QuantLib {
         virtual Size currentStep() const = 0;
         virtual const CurveState& currentState() const = 0;
         virtual void setInitialState(const CurveState&) = 0;
+        //! discards the next n paths
+        /*! The default implementation evolves the paths and ignores
+            the results; evolvers driven by a BrownianGenerator
+            forward the call to it instead.
+        */
+        virtual void skipPaths(Size n) {
+            for (Size i=0; i<n; ++i) {
+                startNewPath();
+                while (currentStep() < numeraires().size())
+                    advanceStep();
+            }
+        }
     };
 
 }
@@ -0,0 +1,70 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/models/marketmodels/evolvers/evolverpathblock.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+
+namespace QuantLib {
+
+    EvolverPathBlock::EvolverPathBlock(Size paths,
+                                       Size steps,
+                                       Size factors,
+                                       Size rates)
+    : paths_(0), current_(0), pathWeights_(paths),
+      stepWeights_(steps, paths), brownians_(steps, Matrix(factors, paths)),
+      rates_(steps, Matrix(rates, paths)), brownian_(factors) {
+        QL_REQUIRE(paths > 0, "at least one path per block required");
+    }
+
+    void EvolverPathBlock::draw(BrownianGenerator& generator) {
+        Size paths = pathWeights_.size();
+        for (Size p=0; p<paths; ++p) {
+            pathWeights_[p] = generator.nextPath();
+            for (Size s=0; s<brownians_.size(); ++s) {
+                stepWeights_[s][p] = generator.nextStep(brownian_);
+                for (Size f=0; f<brownian_.size(); ++f)
+                    brownians_[s][f][p] = brownian_[f];
+            }
+        }
+        paths_ = paths;
+        current_ = 0;
+    }
+
+    Real EvolverPathBlock::nextPath() {
+        QL_REQUIRE(current_ < paths_, "no paths left in block");
+        return pathWeights_[current_++];
+    }
+
+    Size EvolverPathBlock::skip(Size n) {
+        Size available = std::min(n, paths_-current_);
+        current_ += available;
+        return n - available;
+    }
+
+    Real EvolverPathBlock::stepWeight(Size step) const {
+        return stepWeights_[step][current_-1];
+    }
+
+    void EvolverPathBlock::currentRates(Size step,
+                                        std::vector<Real>& rates) const {
+        const Matrix& m = rates_[step];
+        for (Size i=0; i<m.rows(); ++i)
+            rates[i] = m[i][current_-1];
+    }
+
+}
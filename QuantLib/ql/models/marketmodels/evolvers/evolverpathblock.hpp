@@ -0,0 +1,81 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file evolverpathblock.hpp
+    \brief storage for a block of market-model paths evolved together
+*/
+
+#ifndef quantlib_evolver_path_block_hpp
+#define quantlib_evolver_path_block_hpp
+
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class BrownianGenerator;
+
+    //! storage for a block of paths evolved together
+    /*! Evolvers working in multi-path mode draw the Brownian
+        increments of a whole block of paths, evolve all of them at
+        once and then return them one at a time through the usual
+        MarketModelEvolver interface.  Increments and rates are
+        stored with one column per path, so that the evolution
+        kernels can run their inner loops across paths.
+
+        The increments are drawn path by path in the same order as
+        single-path evolution would, so that both modes consume the
+        generator in the same way.
+    */
+    class EvolverPathBlock {
+      public:
+        EvolverPathBlock(Size paths,
+                         Size steps,
+                         Size factors,
+                         Size rates);
+        //! draws the Brownian increments for the next block of paths
+        void draw(BrownianGenerator& generator);
+        //! moves to the next path in the block and returns its weight
+        Real nextPath();
+        /*! discards up to \p n paths still in the block and returns
+            the number of paths that are left to skip.
+        */
+        Size skip(Size n);
+        //! whether all the drawn paths were returned
+        bool exhausted() const { return current_ == paths_; }
+        //! number of paths in the block
+        Size size() const { return paths_; }
+        //! increments for the given step (factors x paths)
+        const Matrix& brownians(Size step) const { return brownians_[step]; }
+        //! rates at the end of the given step (rates x paths)
+        Matrix& rates(Size step) { return rates_[step]; }
+        //! weight of the given step on the current path
+        Real stepWeight(Size step) const;
+        //! rates at the end of the given step on the current path
+        void currentRates(Size step, std::vector<Real>& rates) const;
+      private:
+        Size paths_, current_;
+        std::vector<Real> pathWeights_;
+        Matrix stepWeights_;
+        std::vector<Matrix> brownians_, rates_;
+        std::vector<Real> brownian_;
+    };
+
+}
+
+#endif
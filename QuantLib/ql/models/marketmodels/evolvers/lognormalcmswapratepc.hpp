@@ -48,6 +48,7 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        void skipPaths(Size n);
         //@}
       private:
         void setCMSwapRates(const std::vector<Real>& swapRates);
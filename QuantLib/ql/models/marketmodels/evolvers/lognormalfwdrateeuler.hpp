@@ -46,6 +46,7 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        void skipPaths(Size n);
         //@}
 
         //! accessor methods useful for doing pathwise vegas
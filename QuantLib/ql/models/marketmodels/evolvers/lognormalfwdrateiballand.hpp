@@ -45,6 +45,7 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        void skipPaths(Size n);
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
@@ -30,7 +30,8 @@ namespace QuantLib {
                            const boost::shared_ptr<MarketModel>& marketModel,
                            const BrownianGeneratorFactory& factory,
                            const std::vector<Size>& numeraires,
-                           Size initialStep)
+                           Size initialStep,
+                           Size pathBlock)
     : marketModel_(marketModel),
       numeraires_(numeraires),
       initialStep_(initialStep),
@@ -74,6 +75,15 @@ namespace QuantLib {
             fixedDrifts_.push_back(fixed);
         }
 
+        if (pathBlock > 1) {
+            block_ = boost::shared_ptr<EvolverPathBlock>(
+                new EvolverPathBlock(pathBlock, steps-initialStep_,
+                                     numberOfFactors_, numberOfRates_));
+            blockLogForwards_ = blockForwards_ =
+                blockDrifts1_ = blockG_ =
+                Matrix(numberOfRates_, pathBlock);
+        }
+
         setForwards(marketModel_->initialRates());
     }
 
@@ -89,6 +99,9 @@ namespace QuantLib {
             initialLogForwards_[i] = std::log(forwards[i] +
                                               displacements_[i]);
         calculators_[initialStep_].compute(forwards, initialDrifts_);
+        // paths already drawn are evolved again from the new state
+        if (block_ && !block_->exhausted())
+            evolveBlock();
     }
 
     void LogNormalFwdRateIpc::setInitialState(const CurveState& cs) {
@@ -97,13 +110,34 @@ namespace QuantLib {
 
     Real LogNormalFwdRateIpc::startNewPath() {
         currentStep_ = initialStep_;
+        if (block_) {
+            if (block_->exhausted()) {
+                block_->draw(*generator_);
+                evolveBlock();
+            }
+            return block_->nextPath();
+        }
         std::copy(initialLogForwards_.begin(), initialLogForwards_.end(),
                   logForwards_.begin());
         return generator_->nextPath();
     }
 
+    void LogNormalFwdRateIpc::skipPaths(Size n) {
+        if (block_)
+            n = block_->skip(n);
+        generator_->skipPaths(n);
+    }
+
     Real LogNormalFwdRateIpc::advanceStep()
     {
+        if (block_) {
+            Size step = currentStep_-initialStep_;
+            block_->currentRates(step, forwards_);
+            curveState_.setOnForwardRates(forwards_);
+            ++currentStep_;
+            return block_->stepWeight(step);
+        }
+
         // we're going from T1 to T2:
 
         // a) compute drifts D1 at T1;
@@ -151,4 +185,65 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void LogNormalFwdRateIpc::evolveBlock() {
+        // same steps as advanceStep(), applied to all the paths in
+        // the block; rates are stored as rows, paths as columns
+        Size n = block_->size(), steps = fixedDrifts_.size();
+        Size p;
+        std::vector<Real> drifts2(n), diffusion(n);
+        for (Size i=0; i<numberOfRates_; ++i) {
+            std::fill(blockLogForwards_.row_begin(i),
+                      blockLogForwards_.row_end(i), initialLogForwards_[i]);
+            std::fill(blockForwards_.row_begin(i),
+                      blockForwards_.row_end(i),
+                      std::exp(initialLogForwards_[i]) - displacements_[i]);
+            std::fill(blockDrifts1_.row_begin(i),
+                      blockDrifts1_.row_end(i), initialDrifts_[i]);
+        }
+
+        for (Size j=initialStep_; j<steps; ++j) {
+            // a) compute drifts D1 at T1;
+            if (j > initialStep_)
+                calculators_[j].computePlain(blockForwards_, blockDrifts1_);
+
+            const Matrix& brownians = block_->brownians(j-initialStep_);
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            const Matrix& C = marketModel_->covariance(j);
+            const std::vector<Real>& fixedDrift = fixedDrifts_[j];
+
+            Integer alive = alive_[j];
+            for (Integer i=numberOfRates_-1; i>=alive; --i) {
+                std::fill(drifts2.begin(), drifts2.end(), 0.0);
+                for (Size k=i+1; k<numberOfRates_; ++k) {
+                    Real c = C[i][k];
+                    Matrix::const_row_iterator g = blockG_.row_begin(k);
+                    for (p=0; p<n; ++p)
+                        drifts2[p] -= g[p]*c;
+                }
+                std::fill(diffusion.begin(), diffusion.end(), 0.0);
+                for (Size f=0; f<numberOfFactors_; ++f) {
+                    Real a = A[i][f];
+                    Matrix::const_row_iterator w = brownians.row_begin(f);
+                    for (p=0; p<n; ++p)
+                        diffusion[p] += a*w[p];
+                }
+                Matrix::row_iterator logF = blockLogForwards_.row_begin(i);
+                Matrix::row_iterator F = blockForwards_.row_begin(i);
+                Matrix::row_iterator g = blockG_.row_begin(i);
+                Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+                Real tau = rateTaus_[i], displacement = displacements_[i];
+                for (p=0; p<n; ++p) {
+                    logF[p] += 0.5*(d1[p]+drifts2[p]) + fixedDrift[i];
+                    logF[p] += diffusion[p];
+                    F[p] = std::exp(logF[p]) - displacement;
+                    g[p] = tau*(F[p]+displacement)/(1.0+tau*F[p]);
+                }
+            }
+
+            Matrix& forwards = block_->rates(j-initialStep_);
+            std::copy(blockForwards_.begin(), blockForwards_.end(),
+                      forwards.begin());
+        }
+    }
+
 }
@@ -23,6 +23,7 @@
 
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/models/marketmodels/evolvers/evolverpathblock.hpp>
 
 namespace QuantLib {
 
@@ -32,12 +33,16 @@ namespace QuantLib {
     class LMMDriftCalculator;
 
     //! Iterative Predictor-Corrector
+    /*! When \p pathBlock is greater than one, blocks of paths are
+        evolved together as in LogNormalFwdRatePc.
+    */
     class LogNormalFwdRateIpc : public MarketModelEvolver {
       public:
         LogNormalFwdRateIpc(const boost::shared_ptr<MarketModel>&,
                             const BrownianGeneratorFactory&,
                             const std::vector<Size>& numeraires,
-                            Size initialStep = 0);
+                            Size initialStep = 0,
+                            Size pathBlock = 1);
         //! \name MarketModel interface
         //@{
         const std::vector<Size>& numeraires() const;
@@ -46,9 +51,11 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        void skipPaths(Size n);
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
+        void evolveBlock();
         // inputs
         boost::shared_ptr<MarketModel> marketModel_;
         std::vector<Size> numeraires_;
@@ -68,6 +75,9 @@ namespace QuantLib {
         //std::vector<Matrix> C_;
         // helper classes
         std::vector<LMMDriftCalculator> calculators_;
+        // multi-path mode
+        boost::shared_ptr<EvolverPathBlock> block_;
+        Matrix blockLogForwards_, blockForwards_, blockDrifts1_, blockG_;
     };
 
 }
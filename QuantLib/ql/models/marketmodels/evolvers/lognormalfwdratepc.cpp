@@ -30,7 +30,8 @@ namespace QuantLib {
                            const boost::shared_ptr<MarketModel>& marketModel,
                            const BrownianGeneratorFactory& factory,
                            const std::vector<Size>& numeraires,
-                           Size initialStep)
+                           Size initialStep,
+                           Size pathBlock)
     : marketModel_(marketModel),
       numeraires_(numeraires),
       initialStep_(initialStep),
@@ -73,6 +74,15 @@ namespace QuantLib {
             fixedDrifts_.push_back(fixed);
         }
 
+        if (pathBlock > 1) {
+            block_ = boost::shared_ptr<EvolverPathBlock>(
+                new EvolverPathBlock(pathBlock, steps-initialStep_,
+                                     numberOfFactors_, numberOfRates_));
+            blockLogForwards_ = blockForwards_ =
+                blockDrifts1_ = blockDrifts2_ =
+                Matrix(numberOfRates_, pathBlock);
+        }
+
         setForwards(marketModel_->initialRates());
     }
 
@@ -88,6 +98,9 @@ namespace QuantLib {
              initialLogForwards_[i] = std::log(forwards[i] +
                                                displacements_[i]);
         calculators_[initialStep_].compute(forwards, initialDrifts_);
+        // paths already drawn are evolved again from the new state
+        if (block_ && !block_->exhausted())
+            evolveBlock();
     }
 
     void LogNormalFwdRatePc::setInitialState(const CurveState& cs) {
@@ -96,13 +109,34 @@ namespace QuantLib {
 
     Real LogNormalFwdRatePc::startNewPath() {
         currentStep_ = initialStep_;
+        if (block_) {
+            if (block_->exhausted()) {
+                block_->draw(*generator_);
+                evolveBlock();
+            }
+            return block_->nextPath();
+        }
         std::copy(initialLogForwards_.begin(), initialLogForwards_.end(),
                   logForwards_.begin());
         return generator_->nextPath();
     }
 
+    void LogNormalFwdRatePc::skipPaths(Size n) {
+        if (block_)
+            n = block_->skip(n);
+        generator_->skipPaths(n);
+    }
+
     Real LogNormalFwdRatePc::advanceStep()
     {
+        if (block_) {
+            Size step = currentStep_-initialStep_;
+            block_->currentRates(step, forwards_);
+            curveState_.setOnForwardRates(forwards_);
+            ++currentStep_;
+            return block_->stepWeight(step);
+        }
+
         // we're going from T1 to T2
 
         // a) compute drifts D1 at T1;
@@ -152,4 +186,71 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void LogNormalFwdRatePc::evolveBlock() {
+        // same steps as advanceStep(), applied to all the paths in
+        // the block; rates are stored as rows, paths as columns
+        Size n = block_->size(), steps = fixedDrifts_.size();
+        Size i, p;
+        std::vector<Real> diffusion(n);
+        for (i=0; i<numberOfRates_; ++i) {
+            std::fill(blockLogForwards_.row_begin(i),
+                      blockLogForwards_.row_end(i), initialLogForwards_[i]);
+            std::fill(blockForwards_.row_begin(i),
+                      blockForwards_.row_end(i),
+                      std::exp(initialLogForwards_[i]) - displacements_[i]);
+            std::fill(blockDrifts1_.row_begin(i),
+                      blockDrifts1_.row_end(i), initialDrifts_[i]);
+        }
+
+        for (Size j=initialStep_; j<steps; ++j) {
+            Size alive = alive_[j];
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            const Matrix& brownians = block_->brownians(j-initialStep_);
+            Matrix& forwards = block_->rates(j-initialStep_);
+            const std::vector<Real>& fixedDrift = fixedDrifts_[j];
+
+            // a) compute drifts D1 at T1;
+            if (j > initialStep_)
+                calculators_[j].compute(blockForwards_, blockDrifts1_);
+
+            // b) evolve forwards up to T2 using D1;
+            for (i=alive; i<numberOfRates_; ++i) {
+                Matrix::row_iterator logF = blockLogForwards_.row_begin(i);
+                Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+                for (p=0; p<n; ++p)
+                    logF[p] += d1[p] + fixedDrift[i];
+                std::fill(diffusion.begin(), diffusion.end(), 0.0);
+                for (Size f=0; f<numberOfFactors_; ++f) {
+                    Real a = A[i][f];
+                    Matrix::const_row_iterator w = brownians.row_begin(f);
+                    for (p=0; p<n; ++p)
+                        diffusion[p] += a*w[p];
+                }
+                for (p=0; p<n; ++p)
+                    logF[p] += diffusion[p];
+                Matrix::row_iterator F = blockForwards_.row_begin(i);
+                for (p=0; p<n; ++p)
+                    F[p] = std::exp(logF[p]) - displacements_[i];
+            }
+
+            // c) recompute drifts D2 using the predicted forwards;
+            calculators_[j].compute(blockForwards_, blockDrifts2_);
+
+            // d) correct forwards using both drifts
+            for (i=alive; i<numberOfRates_; ++i) {
+                Matrix::row_iterator logF = blockLogForwards_.row_begin(i);
+                Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+                Matrix::const_row_iterator d2 = blockDrifts2_.row_begin(i);
+                Matrix::row_iterator F = blockForwards_.row_begin(i);
+                for (p=0; p<n; ++p) {
+                    logF[p] += (d2[p]-d1[p])/2.0;
+                    F[p] = std::exp(logF[p]) - displacements_[i];
+                }
+            }
+
+            std::copy(blockForwards_.begin(), blockForwards_.end(),
+                      forwards.begin());
+        }
+    }
+
 }
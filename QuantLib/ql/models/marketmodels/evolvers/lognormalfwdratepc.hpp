@@ -24,6 +24,7 @@
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/models/marketmodels/evolvers/evolverpathblock.hpp>
 
 namespace QuantLib {
 
@@ -32,12 +33,19 @@ namespace QuantLib {
     class BrownianGeneratorFactory;
 
     //! Predictor-Corrector
+    /*! When \p pathBlock is greater than one, the evolver works in
+        multi-path mode: blocks of paths are evolved together, with
+        drift computations and predictor-corrector steps vectorized
+        across paths, and then returned one at a time.  Results are
+        the same as in single-path mode.
+    */
     class LogNormalFwdRatePc : public MarketModelEvolver {
       public:
         LogNormalFwdRatePc(const boost::shared_ptr<MarketModel>&,
                            const BrownianGeneratorFactory&,
                            const std::vector<Size>& numeraires,
-                           Size initialStep = 0);
+                           Size initialStep = 0,
+                           Size pathBlock = 1);
         //! \name MarketModel interface
         //@{
         const std::vector<Size>& numeraires() const;
@@ -46,9 +54,11 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        void skipPaths(Size n);
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
+        void evolveBlock();
         // inputs
         boost::shared_ptr<MarketModel> marketModel_;
         std::vector<Size> numeraires_;
@@ -66,6 +76,9 @@ namespace QuantLib {
         std::vector<Size> alive_;
         // helper classes
         std::vector<LMMDriftCalculator> calculators_;
+        // multi-path mode
+        boost::shared_ptr<EvolverPathBlock> block_;
+        Matrix blockLogForwards_, blockForwards_, blockDrifts1_, blockDrifts2_;
     };
 
 }
@@ -30,7 +30,8 @@ namespace QuantLib {
                            const boost::shared_ptr<MarketModel>& marketModel,
                            const BrownianGeneratorFactory& factory,
                            const std::vector<Size>& numeraires,
-                           Size initialStep)
+                           Size initialStep,
+                           Size pathBlock)
     : marketModel_(marketModel),
       numeraires_(numeraires),
       initialStep_(initialStep),
@@ -69,6 +70,14 @@ namespace QuantLib {
             */
         }
 
+        if (pathBlock > 1) {
+            block_ = boost::shared_ptr<EvolverPathBlock>(
+                new EvolverPathBlock(pathBlock, steps-initialStep_,
+                                     numberOfFactors_, numberOfRates_));
+            blockForwards_ = blockDrifts1_ = blockDrifts2_ =
+                Matrix(numberOfRates_, pathBlock);
+        }
+
         setForwards(marketModel_->initialRates());
     }
 
@@ -82,6 +91,9 @@ namespace QuantLib {
                    "mismatch between forwards and rateTimes");
         for (Size i=0; i<numberOfRates_; ++i)
         calculators_[initialStep_].compute(forwards, initialDrifts_);
+        // paths already drawn are evolved again from the new state
+        if (block_ && !block_->exhausted())
+            evolveBlock();
     }
 
     void NormalFwdRatePc::setInitialState(const CurveState& cs) {
@@ -90,13 +102,34 @@ namespace QuantLib {
 
     Real NormalFwdRatePc::startNewPath() {
         currentStep_ = initialStep_;
+        if (block_) {
+            if (block_->exhausted()) {
+                block_->draw(*generator_);
+                evolveBlock();
+            }
+            return block_->nextPath();
+        }
         std::copy(initialForwards_.begin(), initialForwards_.end(),
                   forwards_.begin());
         return generator_->nextPath();
     }
 
+    void NormalFwdRatePc::skipPaths(Size n) {
+        if (block_)
+            n = block_->skip(n);
+        generator_->skipPaths(n);
+    }
+
     Real NormalFwdRatePc::advanceStep()
     {
+        if (block_) {
+            Size step = currentStep_-initialStep_;
+            block_->currentRates(step, forwards_);
+            curveState_.setOnForwardRates(forwards_);
+            ++currentStep_;
+            return block_->stepWeight(step);
+        }
+
         // we're going from T1 to T2
 
         // a) compute drifts D1 at T1;
@@ -143,4 +176,61 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void NormalFwdRatePc::evolveBlock() {
+        // same steps as advanceStep(), applied to all the paths in
+        // the block; rates are stored as rows, paths as columns
+        Size n = block_->size(), steps = calculators_.size();
+        Size i, p;
+        std::vector<Real> diffusion(n);
+        for (i=0; i<numberOfRates_; ++i) {
+            std::fill(blockForwards_.row_begin(i),
+                      blockForwards_.row_end(i), initialForwards_[i]);
+            std::fill(blockDrifts1_.row_begin(i),
+                      blockDrifts1_.row_end(i), initialDrifts_[i]);
+        }
+
+        for (Size j=initialStep_; j<steps; ++j) {
+            Size alive = alive_[j];
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            const Matrix& brownians = block_->brownians(j-initialStep_);
+
+            // a) compute drifts D1 at T1;
+            if (j > initialStep_)
+                calculators_[j].compute(blockForwards_, blockDrifts1_);
+
+            // b) evolve forwards up to T2 using D1;
+            for (i=alive; i<numberOfRates_; ++i) {
+                Matrix::row_iterator F = blockForwards_.row_begin(i);
+                Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+                for (p=0; p<n; ++p)
+                    F[p] += d1[p];
+                std::fill(diffusion.begin(), diffusion.end(), 0.0);
+                for (Size f=0; f<numberOfFactors_; ++f) {
+                    Real a = A[i][f];
+                    Matrix::const_row_iterator w = brownians.row_begin(f);
+                    for (p=0; p<n; ++p)
+                        diffusion[p] += a*w[p];
+                }
+                for (p=0; p<n; ++p)
+                    F[p] += diffusion[p];
+            }
+
+            // c) recompute drifts D2 using the predicted forwards;
+            calculators_[j].compute(blockForwards_, blockDrifts2_);
+
+            // d) correct forwards using both drifts
+            for (i=alive; i<numberOfRates_; ++i) {
+                Matrix::row_iterator F = blockForwards_.row_begin(i);
+                Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+                Matrix::const_row_iterator d2 = blockDrifts2_.row_begin(i);
+                for (p=0; p<n; ++p)
+                    F[p] += (d2[p]-d1[p])/2.0;
+            }
+
+            Matrix& forwards = block_->rates(j-initialStep_);
+            std::copy(blockForwards_.begin(), blockForwards_.end(),
+                      forwards.begin());
+        }
+    }
+
 }
@@ -125,6 +125,10 @@ namespace QuantLib {
         return  generator_->nextPath();
     }
 
+    void SVDDFwdRatePc::skipPaths(Size n) {
+        generator_->skipPaths(n);
+    }
+
     Real SVDDFwdRatePc::advanceStep()
     {
         // we're going from T1 to T2
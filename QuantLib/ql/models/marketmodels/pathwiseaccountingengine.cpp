@@ -23,10 +23,101 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/pathwisegreeks/vegabumpcluster.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
+    namespace {
+
+        // elementary results are ordered, for each product, as value,
+        // deltas and vegas for each step, rate and factor; the vegas
+        // for the given bumps are linear combinations of the latter.
+        // Post linear combinations, errors are not meaningful so
+        // s.e.s are not computed for vegas.
+        void combineVegas(const std::vector<Real>& allMeans,
+                          const std::vector<Real>& allErrors,
+                          const std::vector<std::vector<Matrix> >& vegaBumps,
+                          Size numberProducts, Size numberRates,
+                          Size numberSteps, Size factors,
+                          std::vector<Real>& means,
+                          std::vector<Real>& errors) {
+            Size numberBumps = vegaBumps[0].size();
+            Size outDataPerProduct = 1+numberRates+numberBumps;
+            Size inDataPerProduct = 1+numberRates+numberSteps*numberRates*factors;
+
+            means.resize(outDataPerProduct*numberProducts);
+            errors.resize(outDataPerProduct*numberProducts);
+
+            for (Size p=0; p < numberProducts; ++p)
+            {
+                for (Size i=0; i < 1 + numberRates; ++i)
+                {
+                    means[i+p*outDataPerProduct] = allMeans[i+p*inDataPerProduct];
+                    errors[i+p*outDataPerProduct] = allErrors[i+p*inDataPerProduct];
+                }
+
+                for (Size bump=0; bump<numberBumps; ++bump)
+                {
+                    Real thisVega=0.0;
+
+                    for (Size t=0; t < numberSteps; ++t)
+                        for (Size r=0; r < numberRates; ++r)
+                            for (Size f=0; f < factors; ++f)
+                                thisVega+= vegaBumps[t][bump][r][f]*allMeans[p*inDataPerProduct+1+numberRates+t*numberRates*factors+r*factors+f];
+
+                    means[p*outDataPerProduct+1+numberRates+bump] = thisVega;
+                }
+            }
+        }
+
+        // same as above, with unit bumps on the elements of each cluster
+        void combineVegas(const std::vector<Real>& allMeans,
+                          const std::vector<Real>& allErrors,
+                          const VegaBumpCollection& vegaBumps,
+                          Size numberProducts, Size numberRates,
+                          Size numberSteps, Size factors,
+                          std::vector<Real>& means,
+                          std::vector<Real>& errors) {
+            const std::vector<VegaBumpCluster>& clusters = vegaBumps.allBumps();
+            Size numberBumps = clusters.size();
+            Size outDataPerProduct = 1+numberRates+numberBumps;
+            Size inDataPerProduct = 1+numberRates+numberSteps*numberRates*factors;
+
+            means.resize(outDataPerProduct*numberProducts);
+            errors.resize(outDataPerProduct*numberProducts);
+
+            for (Size p=0; p < numberProducts; ++p)
+            {
+                for (Size i=0; i < 1 + numberRates; ++i)
+                {
+                    means[i+p*outDataPerProduct] = allMeans[i+p*inDataPerProduct];
+                    errors[i+p*outDataPerProduct] = allErrors[i+p*inDataPerProduct];
+                }
+
+                for (Size bump=0; bump<numberBumps; ++bump)
+                {
+                    const VegaBumpCluster& c = clusters[bump];
+                    QL_REQUIRE(c.stepEnd() <= numberSteps &&
+                               c.rateEnd() <= numberRates &&
+                               c.factorEnd() <= factors,
+                               "vega bump cluster " << bump <<
+                               " not compatible with the market model");
+                    Real thisVega=0.0;
+
+                    for (Size t=c.stepBegin(); t < c.stepEnd(); ++t)
+                        for (Size r=c.rateBegin(); r < c.rateEnd(); ++r)
+                            for (Size f=c.factorBegin(); f < c.factorEnd(); ++f)
+                                thisVega+= allMeans[p*inDataPerProduct+1+numberRates+t*numberRates*factors+r*factors+f];
+
+                    means[p*outDataPerProduct+1+numberRates+bump] = thisVega;
+                }
+            }
+        }
+
+    }
+
     PathwiseAccountingEngine::PathwiseAccountingEngine(const boost::shared_ptr<LogNormalFwdRateEuler>& evolver, // method relies heavily on LMM Euler
         const Clone<MarketModelPathwiseMultiProduct>& product,
         const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
@@ -120,7 +211,7 @@ namespace QuantLib {
     Real PathwiseAccountingEngine::singlePathValues(std::vector<Real>& values)
     {
 
-        const std::vector<Real> initialForwards_(pseudoRootStructure_->initialRates());
+        const std::vector<Real>& initialForwards_(pseudoRootStructure_->initialRates());
         currentForwards_ = initialForwards_;
         // clear accumulation variables
         for (Size i=0; i < numberProducts_; ++i)
@@ -1160,37 +1251,179 @@ namespace QuantLib {
 
             multiplePathValuesElementary(allMeans,allErrors,numberOfPaths);
 
-            Size outDataPerProduct = 1+numberRates_+numberBumps_;
-            Size inDataPerProduct = 1+numberRates_+numberElementaryVegas_;
+            combineVegas(allMeans, allErrors, vegaBumps_,
+                         numberProducts_, numberRates_, numberSteps_, factors_,
+                         means, errors);
 
-            means.resize((1+numberRates_+numberBumps_)*numberProducts_);
-            errors.resize((1+numberRates_+numberBumps_)*numberProducts_); // post linear combinations, errors are not meaningful so don't attempt to compute s.e.s for vegas
+        } // end of method
 
-            for (Size p=0; p < numberProducts_; ++p)
-            {
-                for (Size i=0; i < 1 + numberRates_; ++i)
-                {
-                      means[i+p*outDataPerProduct] = allMeans[i+p*inDataPerProduct];
-                      errors[i+p*outDataPerProduct] = allErrors[i+p*inDataPerProduct];
-                }
 
-               for (Size bump=0; bump<numberBumps_; ++bump)
-                {
-                    Real thisVega=0.0;
+    ParallelPathwiseAccountingEngine::ParallelPathwiseAccountingEngine(
+             const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+             const Clone<MarketModelPathwiseMultiProduct>& product,
+             const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+             Real initialNumeraireValue)
+    : evolvers_(evolvers), blockStats_(evolvers.size()),
+      usedPaths_(evolvers.size(), 0),
+      dimension_(product->numberOfProducts()*
+                 (pseudoRootStructure->numberOfRates()+1)),
+      totalPaths_(0) {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        for (Size i=0; i<evolvers.size(); ++i)
+            engines_.push_back(boost::shared_ptr<PathwiseAccountingEngine>(
+                 new PathwiseAccountingEngine(evolvers[i], product,
+                                              pseudoRootStructure,
+                                              initialNumeraireValue)));
+    }
 
+    void ParallelPathwiseAccountingEngine::multiplePathValues(
+                                                 SequenceStatisticsInc& stats,
+                                                 Size numberOfPaths) {
+        const long workers = engines_.size();
+        std::vector<std::string> errors(workers);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (long w=0; w<workers; ++w) {
+            Size begin = w*numberOfPaths/workers,
+                 end = (w+1)*numberOfPaths/workers;
+            try {
+                blockStats_[w].reset(dimension_);
+                // skip the paths generated by the other workers
+                evolvers_[w]->skipPaths(totalPaths_ + begin - usedPaths_[w]);
+                engines_[w]->multiplePathValues(blockStats_[w], end-begin);
+                usedPaths_[w] = totalPaths_ + end;
+            } catch (std::exception& e) {
+                errors[w] = e.what();
+            } catch (...) {
+                errors[w] = "unknown error";
+            }
+        }
 
-                    for (Size t=0; t < numberSteps_; ++t)
-                        for (Size r=0; r < numberRates_; ++r)
-                            for (Size f=0; f < factors_; ++f)
-                                thisVega+= vegaBumps_[t][bump][r][f]*allMeans[p*inDataPerProduct+1+numberRates_+t*numberRates_*factors_+r*factors_+f];
+        for (long w=0; w<workers; ++w)
+            QL_REQUIRE(errors[w].empty(), errors[w]);
+
+        for (long w=0; w<workers; ++w)
+            stats.merge(blockStats_[w]);
+        totalPaths_ += numberOfPaths;
+    }
 
 
-                    means[p*outDataPerProduct+1+numberRates_+bump] = thisVega;
-               }
-                    
+    ParallelPathwiseVegasOuterAccountingEngine::ParallelPathwiseVegasOuterAccountingEngine(
+             const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+             const Clone<MarketModelPathwiseMultiProduct>& product,
+             const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+             const std::vector<std::vector<Matrix> >& vegaBumps,
+             Real initialNumeraireValue)
+    : evolvers_(evolvers), vegaBumps_(vegaBumps),
+      numberProducts_(product->numberOfProducts()),
+      numberRates_(pseudoRootStructure->numberOfRates()),
+      numberSteps_(pseudoRootStructure->numberOfSteps()),
+      factors_(pseudoRootStructure->numberOfFactors()),
+      usedPaths_(evolvers.size(), 0), totalPaths_(0) {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        Size size = numberProducts_*
+            (1+numberRates_+numberSteps_*numberRates_*factors_);
+        for (Size i=0; i<evolvers.size(); ++i) {
+            engines_.push_back(
+                boost::shared_ptr<PathwiseVegasOuterAccountingEngine>(
+                    new PathwiseVegasOuterAccountingEngine(
+                                         evolvers[i], product,
+                                         pseudoRootStructure, vegaBumps,
+                                         initialNumeraireValue)));
+            values_.push_back(std::vector<Real>(size));
+            sums_.push_back(std::vector<Real>(size));
+            sumsqs_.push_back(std::vector<Real>(size));
+        }
+    }
+
+    void ParallelPathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(
+                                                   std::vector<Real>& means,
+                                                   std::vector<Real>& errors,
+                                                   Size numberOfPaths) {
+        const long workers = engines_.size();
+        std::vector<std::string> failures(workers);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (long w=0; w<workers; ++w) {
+            Size begin = w*numberOfPaths/workers,
+                 end = (w+1)*numberOfPaths/workers;
+            try {
+                std::vector<Real>& values = values_[w];
+                std::vector<Real>& sums = sums_[w];
+                std::vector<Real>& sumsqs = sumsqs_[w];
+                std::fill(sums.begin(), sums.end(), 0.0);
+                std::fill(sumsqs.begin(), sumsqs.end(), 0.0);
+                // skip the paths generated by the other workers
+                evolvers_[w]->skipPaths(totalPaths_ + begin - usedPaths_[w]);
+                for (Size i=begin; i<end; ++i) {
+                    engines_[w]->singlePathValues(values);
+                    for (Size j=0; j<values.size(); ++j) {
+                        sums[j] += values[j];
+                        sumsqs[j] += values[j]*values[j];
+                    }
+                }
+                usedPaths_[w] = totalPaths_ + end;
+            } catch (std::exception& e) {
+                failures[w] = e.what();
+            } catch (...) {
+                failures[w] = "unknown error";
             }
+        }
 
-        } // end of method
+        for (long w=0; w<workers; ++w)
+            QL_REQUIRE(failures[w].empty(), failures[w]);
+        totalPaths_ += numberOfPaths;
+
+        Size size = values_[0].size();
+        elementaryMeans_.resize(size);
+        elementaryErrors_.resize(size);
+        for (Size j=0; j<size; ++j) {
+            Real sum = 0.0, sumsq = 0.0;
+            for (long w=0; w<workers; ++w) {
+                sum += sums_[w][j];
+                sumsq += sumsqs_[w][j];
+            }
+            elementaryMeans_[j] = sum/numberOfPaths;
+            Real meanSq = sumsq/numberOfPaths;
+            // rounding might make it slightly negative
+            Real variance = std::max(
+                meanSq - elementaryMeans_[j]*elementaryMeans_[j], 0.0);
+            elementaryErrors_[j] = std::sqrt(variance/numberOfPaths);
+        }
+        means = elementaryMeans_;
+        errors = elementaryErrors_;
+    }
+
+    void ParallelPathwiseVegasOuterAccountingEngine::multiplePathValues(
+                                                   std::vector<Real>& means,
+                                                   std::vector<Real>& errors,
+                                                   Size numberOfPaths) {
+        std::vector<Real> allMeans, allErrors;
+        multiplePathValuesElementary(allMeans, allErrors, numberOfPaths);
+        vegas(vegaBumps_, means, errors);
+    }
+
+    void ParallelPathwiseVegasOuterAccountingEngine::vegas(
+                        const std::vector<std::vector<Matrix> >& vegaBumps,
+                        std::vector<Real>& means,
+                        std::vector<Real>& errors) const {
+        QL_REQUIRE(!elementaryMeans_.empty(), "no paths simulated");
+        QL_REQUIRE(vegaBumps.size() == numberSteps_,
+                   "we need precisely one vector of vega bumps for each step.");
+        combineVegas(elementaryMeans_, elementaryErrors_, vegaBumps,
+                     numberProducts_, numberRates_, numberSteps_, factors_,
+                     means, errors);
+    }
+
+    void ParallelPathwiseVegasOuterAccountingEngine::vegas(
+                        const VegaBumpCollection& vegaBumps,
+                        std::vector<Real>& means,
+                        std::vector<Real>& errors) const {
+        QL_REQUIRE(!elementaryMeans_.empty(), "no paths simulated");
+        combineVegas(elementaryMeans_, elementaryErrors_, vegaBumps,
+                     numberProducts_, numberRates_, numberSteps_, factors_,
+                     means, errors);
+    }
 
 } // end of namespace
 
@@ -35,6 +35,7 @@ namespace QuantLib {
 
     class LogNormalFwdRateEuler;
     class MarketModel;
+    class VegaBumpCollection;
 
 
     //! Engine collecting cash flows along a market-model simulation for doing pathwise computation of Deltas
@@ -97,6 +98,36 @@ namespace QuantLib {
 
     };
 
+    //! Pathwise-delta engine distributing the paths over several evolvers
+    /*! Each evolver is used by a separate PathwiseAccountingEngine,
+        with its own copy of the product and its own workspace, and
+        the engines are run in parallel when OpenMP is enabled.  As in
+        ParallelAccountingEngine, the paths of each call are split in
+        contiguous blocks and each evolver skips to the start of its
+        block.  Each engine collects its block in separate statistics,
+        which are merged in block order; thus, the results equal those
+        of a single PathwiseAccountingEngine up to rounding.
+
+        \pre the evolvers must not share any state, and must not have
+             generated any path before being passed to the engine.
+    */
+    class ParallelPathwiseAccountingEngine {
+      public:
+        ParallelPathwiseAccountingEngine(
+             const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+             const Clone<MarketModelPathwiseMultiProduct>& product,
+             const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+             Real initialNumeraireValue);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        std::vector<boost::shared_ptr<PathwiseAccountingEngine> > engines_;
+        std::vector<boost::shared_ptr<LogNormalFwdRateEuler> > evolvers_;
+        std::vector<SequenceStatisticsInc> blockStats_;
+        std::vector<Size> usedPaths_;
+        Size dimension_, totalPaths_;
+    };
+
 
    //! Engine collecting cash flows along a market-model simulation for doing pathwise computation of Deltas and vegas
     // using Giles--Glasserman smoking adjoints method
@@ -209,6 +240,7 @@ namespace QuantLib {
                                 Size numberOfPaths);
 
       private:
+        friend class ParallelPathwiseVegasOuterAccountingEngine;
           Real singlePathValues(std::vector<Real>& values);
 
         boost::shared_ptr<LogNormalFwdRateEuler> evolver_;
@@ -272,6 +304,65 @@ namespace QuantLib {
 */
     };
 
+    //! Pathwise-vega engine distributing the paths over several evolvers
+    /*! Each evolver is used by a separate
+        PathwiseVegasOuterAccountingEngine, with its own copy of the
+        product and its own workspace (including the Jacobians of the
+        rates with respect to the pseudo-root elements) which is
+        reused for all paths; the engines are run in parallel when
+        OpenMP is enabled.  Paths are split as in
+        ParallelPathwiseAccountingEngine, and the sums collected for
+        each block are added in block order.
+
+        Since vegas are linear combinations of the elementary vegas,
+        the latter are kept after each call; vegas with respect to
+        other bumps, or directly to a collection of vega-bump
+        clusters, can then be obtained without simulating again.
+
+        \pre the evolvers must not share any state, and must not have
+             generated any path before being passed to the engine.
+    */
+    class ParallelPathwiseVegasOuterAccountingEngine {
+      public:
+        ParallelPathwiseVegasOuterAccountingEngine(
+             const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+             const Clone<MarketModelPathwiseMultiProduct>& product,
+             const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+             const std::vector<std::vector<Matrix> >& vegaBumps,
+             Real initialNumeraireValue);
+
+        //! Use to get vegas with respect to VegaBumps
+        void multiplePathValues(std::vector<Real>& means,
+                                std::vector<Real>& errors,
+                                Size numberOfPaths);
+
+        //! Use to get vegas with respect to pseudo-root-elements
+        void multiplePathValuesElementary(std::vector<Real>& means,
+                                          std::vector<Real>& errors,
+                                          Size numberOfPaths);
+
+        //! vegas with respect to the given bumps for the last paths
+        void vegas(const std::vector<std::vector<Matrix> >& vegaBumps,
+                   std::vector<Real>& means,
+                   std::vector<Real>& errors) const;
+
+        //! vegas with respect to the given clusters for the last paths
+        void vegas(const VegaBumpCollection& vegaBumps,
+                   std::vector<Real>& means,
+                   std::vector<Real>& errors) const;
+      private:
+        std::vector<boost::shared_ptr<PathwiseVegasOuterAccountingEngine> > engines_;
+        std::vector<boost::shared_ptr<LogNormalFwdRateEuler> > evolvers_;
+        std::vector<std::vector<Matrix> > vegaBumps_;
+        Size numberProducts_, numberRates_, numberSteps_, factors_;
+        // workspace, one for each engine
+        std::vector<std::vector<Real> > values_, sums_, sumsqs_;
+        std::vector<Size> usedPaths_;
+        Size totalPaths_;
+        // elementary results of the last call
+        std::vector<Real> elementaryMeans_, elementaryErrors_;
+    };
+
 }
 
 #endif
@@ -0,0 +1,180 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file mlmc_discr_arith_av_price.hpp
+    \brief Multilevel Monte Carlo engine for discrete arithmetic average price Asian
+*/
+
+#ifndef quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+#define quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+
+#include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo engine for discrete arithmetic average price Asian
+    /*! The coarsest level evolves the underlying between fixing
+        dates in a single step; each further level refines the steps
+        by the given factor, which reduces the discretization bias
+        of processes that cannot be evolved exactly, e.g., with
+        local volatility.  Levels and samples are added until the
+        required root-mean-square error is reached.  See
+        MultilevelMcSimulation for details.
+
+        \ingroup asianengines
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCDiscreteArithmeticAPEngine
+        : public DiscreteAveragingAsianOption::engine,
+          public MultilevelMcSimulation<SingleVariate,RNG,S> {
+      public:
+        typedef typename MultilevelMcSimulation<SingleVariate,RNG,S>
+            ::path_pricer_type path_pricer_type;
+        MLMCDiscreteArithmeticAPEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Real requiredTolerance,
+             Size maxSamples = Null<Size>(),
+             BigNatural seed = 0,
+             Size refinement = 4,
+             Size minLevels = 3,
+             Size maxLevels = 8,
+             Size initialSamples = 1000);
+        void calculate() const {
+            MultilevelMcSimulation<SingleVariate,RNG,S>::calculate(
+                                            requiredTolerance_, maxSamples_);
+            results_.value = this->mean();
+            results_.errorEstimate = this->errorEstimate();
+            results_.additionalResults["levels"] = this->levels();
+            results_.additionalResults["biasEstimate"] =
+                this->biasEstimate();
+        }
+      protected:
+        // MultilevelMcSimulation implementation
+        boost::shared_ptr<StochasticProcess> process() const {
+            return process_;
+        }
+        TimeGrid timeGrid() const;
+        boost::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const;
+        // data members
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size maxSamples_;
+        Real requiredTolerance_;
+    };
+
+
+    //! path pricer working on the fixing dates of a refined path
+    /*! The path simulated on a level grid is sampled on the nodes of
+        the fixing grid, which are every given number of nodes, and
+        passed to the underlying pricer.
+    */
+    class FixingSubsamplingPathPricer : public PathPricer<Path> {
+      public:
+        FixingSubsamplingPathPricer(
+                        const boost::shared_ptr<PathPricer<Path> >& pricer,
+                        const TimeGrid& fixingGrid,
+                        Size subSteps)
+        : pricer_(pricer), path_(fixingGrid), subSteps_(subSteps) {}
+        Real operator()(const Path& path) const {
+            QL_REQUIRE(path.length() == (path_.length()-1)*subSteps_+1,
+                       "path length (" << path.length()
+                       << ") does not match the fixing grid");
+            for (Size i=0; i<path_.length(); i++)
+                path_[i] = path[i*subSteps_];
+            return (*pricer_)(path_);
+        }
+      private:
+        boost::shared_ptr<PathPricer<Path> > pricer_;
+        mutable Path path_;
+        Size subSteps_;
+    };
+
+
+    // inline definitions
+
+    template <class RNG, class S>
+    inline
+    MLMCDiscreteArithmeticAPEngine<RNG,S>::MLMCDiscreteArithmeticAPEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Real requiredTolerance,
+             Size maxSamples,
+             BigNatural seed,
+             Size refinement,
+             Size minLevels,
+             Size maxLevels,
+             Size initialSamples)
+    : MultilevelMcSimulation<SingleVariate,RNG,S>(refinement, minLevels,
+                                                  maxLevels, initialSamples,
+                                                  seed),
+      process_(process), maxSamples_(maxSamples),
+      requiredTolerance_(requiredTolerance) {
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCDiscreteArithmeticAPEngine<RNG,S>::timeGrid() const {
+
+        Date referenceDate = process_->riskFreeRate()->referenceDate();
+        DayCounter voldc = process_->blackVolatility()->dayCounter();
+        std::vector<Time> fixingTimes;
+        for (Size i=0; i<arguments_.fixingDates.size(); i++) {
+            if (arguments_.fixingDates[i]>=referenceDate) {
+                Time t = voldc.yearFraction(referenceDate,
+                    arguments_.fixingDates[i]);
+                fixingTimes.push_back(t);
+            }
+        }
+
+        return TimeGrid(fixingTimes.begin(), fixingTimes.end());
+    }
+
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<
+        typename MLMCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>
+    MLMCDiscreteArithmeticAPEngine<RNG,S>::pathPricer(
+                                                const TimeGrid& grid) const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        boost::shared_ptr<EuropeanExercise> exercise =
+            boost::dynamic_pointer_cast<EuropeanExercise>(
+                this->arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        TimeGrid fixingGrid = timeGrid();
+        boost::shared_ptr<path_pricer_type> pricer(
+            new ArithmeticAPOPathPricer(
+                    payoff->optionType(),
+                    payoff->strike(),
+                    process_->riskFreeRate()->discount(fixingGrid.back()),
+                    arguments_.runningAccumulator,
+                    arguments_.pastFixings));
+        Size subSteps = (grid.size()-1)/(fixingGrid.size()-1);
+        return boost::shared_ptr<path_pricer_type>(
+            new FixingSubsamplingPathPricer(pricer, fixingGrid, subSteps));
+    }
+
+}
+
+
+#endif
@@ -248,4 +248,80 @@ namespace QuantLib {
         }
     }
 
+
+    ConditionalBarrierPathPricer::ConditionalBarrierPathPricer(
+                    Barrier::Type barrierType,
+                    Real barrier,
+                    Real rebate,
+                    Option::Type type,
+                    Real strike,
+                    const std::vector<DiscountFactor>& discounts,
+                    const boost::shared_ptr<StochasticProcess1D>& diffProcess)
+    : barrierType_(barrierType), barrier_(barrier),
+      rebate_(rebate), diffProcess_(diffProcess),
+      payoff_(type, strike), discounts_(discounts) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(barrier>0.0,
+                   "barrier less/equal zero not allowed");
+    }
+
+
+    Real ConditionalBarrierPathPricer::operator()(const Path& path) const {
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        bool isDown;
+        switch (barrierType_) {
+          case Barrier::DownIn:
+          case Barrier::DownOut:
+            isDown = true;
+            break;
+          case Barrier::UpIn:
+          case Barrier::UpOut:
+            isDown = false;
+            break;
+          default:
+            QL_FAIL("unknown barrier type");
+        }
+
+        const TimeGrid& timeGrid = path.timeGrid();
+        // probability of not having crossed the barrier yet, and
+        // discounted rebates paid at the crossing for knock-outs
+        Real survival = 1.0, knockOutRebate = 0.0;
+        for (Size i = 0; i < n-1 && survival > 0.0; i++) {
+            Real x = isDown ? std::log(path[i]/barrier_)
+                            : std::log(barrier_/path[i]);
+            Real y = isDown ? std::log(path[i+1]/barrier_)
+                            : std::log(barrier_/path[i+1]);
+            Real crossing;
+            if (x <= 0.0 || y <= 0.0) {
+                crossing = 1.0;
+            } else {
+                // terminal or initial vol?
+                Volatility vol = diffProcess_->diffusion(timeGrid[i],
+                                                         path[i]);
+                Real variance = vol*vol*timeGrid.dt(i);
+                crossing = variance > 0.0 ?
+                    std::exp(-2.0*x*y/variance) :
+                    0.0;
+            }
+            knockOutRebate += survival*crossing*rebate_*discounts_[i+1];
+            survival *= 1.0 - crossing;
+        }
+
+        Real payoff = payoff_(path.back()) * discounts_.back();
+        switch (barrierType_) {
+          case Barrier::UpIn:
+          case Barrier::DownIn:
+            return (1.0-survival)*payoff
+                + survival*rebate_*discounts_.back();
+          case Barrier::UpOut:
+          case Barrier::DownOut:
+            return survival*payoff + knockOutRebate;
+          default:
+            QL_FAIL("unknown barrier type");
+        }
+    }
+
 }
@@ -178,6 +178,35 @@ namespace QuantLib {
     };
 
 
+    //! path pricer using the barrier-crossing probability
+    /*! Instead of sampling the minimum or maximum of the Brownian
+        bridge between two path nodes, the payoff is weighted by the
+        probability, conditional on the nodes, that the bridge does
+        not cross the barrier.  The resulting value is a smooth
+        function of the path and needs no further random numbers,
+        which makes it suitable for multilevel Monte Carlo.
+    */
+    class ConditionalBarrierPathPricer : public PathPricer<Path> {
+      public:
+        ConditionalBarrierPathPricer(
+                    Barrier::Type barrierType,
+                    Real barrier,
+                    Real rebate,
+                    Option::Type type,
+                    Real strike,
+                    const std::vector<DiscountFactor>& discounts,
+                    const boost::shared_ptr<StochasticProcess1D>& diffProcess);
+        Real operator()(const Path& path) const;
+      private:
+        Barrier::Type barrierType_;
+        Real barrier_;
+        Real rebate_;
+        boost::shared_ptr<StochasticProcess1D> diffProcess_;
+        PlainVanillaPayoff payoff_;
+        std::vector<DiscountFactor> discounts_;
+    };
+
+
 
     // template definitions
 
@@ -0,0 +1,157 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file mlmcbarrierengine.hpp
+    \brief Multilevel Monte Carlo barrier option engine
+*/
+
+#ifndef quantlib_mlmc_barrier_engine_hpp
+#define quantlib_mlmc_barrier_engine_hpp
+
+#include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo pricing engine for barrier options
+    /*! If biased, the barrier is monitored on the simulation grid
+        of each level.  Otherwise, each path is weighted by the
+        probability that the Brownian bridge between its nodes does
+        not cross the barrier (see ConditionalBarrierPathPricer);
+        this uses no random numbers besides the path ones, so the
+        paths on consecutive levels stay coupled.  Levels and
+        samples are added until the required root-mean-square error
+        is reached.  See MultilevelMcSimulation for details.
+
+        \ingroup barrierengines
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCBarrierEngine
+        : public BarrierOption::engine,
+          public MultilevelMcSimulation<SingleVariate,RNG,S> {
+      public:
+        typedef typename MultilevelMcSimulation<SingleVariate,RNG,S>
+            ::path_pricer_type path_pricer_type;
+        MLMCBarrierEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps,
+             Real requiredTolerance,
+             bool isBiased,
+             Size maxSamples = Null<Size>(),
+             BigNatural seed = 0,
+             Size refinement = 4,
+             Size minLevels = 3,
+             Size maxLevels = 8,
+             Size initialSamples = 1000);
+        void calculate() const {
+            Real spot = process_->x0();
+            QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
+            QL_REQUIRE(!triggered(spot), "barrier touched");
+            MultilevelMcSimulation<SingleVariate,RNG,S>::calculate(
+                                            requiredTolerance_, maxSamples_);
+            results_.value = this->mean();
+            results_.errorEstimate = this->errorEstimate();
+            results_.additionalResults["levels"] = this->levels();
+            results_.additionalResults["biasEstimate"] =
+                this->biasEstimate();
+        }
+      protected:
+        // MultilevelMcSimulation implementation
+        boost::shared_ptr<StochasticProcess> process() const {
+            return process_;
+        }
+        TimeGrid timeGrid() const;
+        boost::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const;
+        // data members
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size timeSteps_, maxSamples_;
+        Real requiredTolerance_;
+        bool isBiased_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S>
+    inline MLMCBarrierEngine<RNG,S>::MLMCBarrierEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps,
+             Real requiredTolerance,
+             bool isBiased,
+             Size maxSamples,
+             BigNatural seed,
+             Size refinement,
+             Size minLevels,
+             Size maxLevels,
+             Size initialSamples)
+    : MultilevelMcSimulation<SingleVariate,RNG,S>(refinement, minLevels,
+                                                  maxLevels, initialSamples,
+                                                  seed),
+      process_(process), timeSteps_(timeSteps), maxSamples_(maxSamples),
+      requiredTolerance_(requiredTolerance), isBiased_(isBiased) {
+        QL_REQUIRE(timeSteps > 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCBarrierEngine<RNG,S>::timeGrid() const {
+        Time residualTime = process_->time(arguments_.exercise->lastDate());
+        return TimeGrid(residualTime, timeSteps_);
+    }
+
+    template <class RNG, class S>
+    inline boost::shared_ptr<
+        typename MLMCBarrierEngine<RNG,S>::path_pricer_type>
+    MLMCBarrierEngine<RNG,S>::pathPricer(const TimeGrid& grid) const {
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        std::vector<DiscountFactor> discounts(grid.size());
+        for (Size i=0; i<grid.size(); i++)
+            discounts[i] = process_->riskFreeRate()->discount(grid[i]);
+
+        if (isBiased_) {
+            return boost::shared_ptr<path_pricer_type>(
+                new BiasedBarrierPathPricer(
+                       arguments_.barrierType,
+                       arguments_.barrier,
+                       arguments_.rebate,
+                       payoff->optionType(),
+                       payoff->strike(),
+                       discounts));
+        } else {
+            return boost::shared_ptr<path_pricer_type>(
+                new ConditionalBarrierPathPricer(
+                    arguments_.barrierType,
+                    arguments_.barrier,
+                    arguments_.rebate,
+                    payoff->optionType(),
+                    payoff->strike(),
+                    discounts,
+                    process_));
+        }
+    }
+
+}
+
+
+#endif
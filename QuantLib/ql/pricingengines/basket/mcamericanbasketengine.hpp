@@ -38,7 +38,11 @@
 namespace QuantLib {
 
     //! least-square Monte Carlo engine
-    /*! \warning This method is intrinsically weak for out-of-the-money
+    /*! Paths are generated in blocks of the given size, so that the
+        correlation is applied to many paths at once; see
+        MultiPathGenerator.  The block doesn't change the results.
+
+        \warning This method is intrinsically weak for out-of-the-money
                  options.
 
         \ingroup basketengines
@@ -48,6 +52,9 @@ namespace QuantLib {
         : public MCLongstaffSchwartzEngine<BasketOption::engine,
                                            MultiVariate,RNG> {
       public:
+        typedef typename MCLongstaffSchwartzEngine<BasketOption::engine,
+                                                   MultiVariate,RNG>::
+            path_generator_type path_generator_type;
         MCAmericanBasketEngine(const boost::shared_ptr<StochasticProcessArray>&,
                                Size timeSteps,
                                Size timeStepsPerYear,
@@ -57,7 +64,9 @@ namespace QuantLib {
                                Real requiredTolerance,
                                Size maxSamples,
                                BigNatural seed,
-                               Size nCalibrationSamples = Null<Size>());
+                               Size nCalibrationSamples = Null<Size>(),
+                               Size pathBlock =
+                                   path_generator_type::defaultPathBlock);
       protected:
         boost::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> >
             lsmPathPricer() const;
@@ -80,12 +89,14 @@ namespace QuantLib {
         MakeMCAmericanBasketEngine& withMaxSamples(Size samples);
         MakeMCAmericanBasketEngine& withSeed(BigNatural seed);
         MakeMCAmericanBasketEngine& withCalibrationSamples(Size samples);
+        MakeMCAmericanBasketEngine& withPathBlock(Size paths);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
         boost::shared_ptr<StochasticProcessArray> process_;
         bool brownianBridge_, antithetic_;
         Size steps_, stepsPerYear_, samples_, maxSamples_, calibrationSamples_;
+        Size pathBlock_;
         Real tolerance_;
         BigNatural seed_;
     };
@@ -126,7 +137,8 @@ namespace QuantLib {
                    Real requiredTolerance,
                    Size maxSamples,
                    BigNatural seed,
-                   Size nCalibrationSamples)
+                   Size nCalibrationSamples,
+                   Size pathBlock)
         : MCLongstaffSchwartzEngine<BasketOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -138,7 +150,8 @@ namespace QuantLib {
                                                       requiredTolerance,
                                                       maxSamples,
                                                       seed,
-                                                      nCalibrationSamples) {}
+                                                      nCalibrationSamples,
+                                                      pathBlock) {}
 
     template <class RNG>
     inline boost::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> >
@@ -181,6 +194,8 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       calibrationSamples_(Null<Size>()),
+      pathBlock_(MCAmericanBasketEngine<RNG>::path_generator_type
+                                                   ::defaultPathBlock),
       tolerance_(Null<Real>()), seed_(0) {}
 
     template <class RNG>
@@ -253,6 +268,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withPathBlock(Size paths) {
+        pathBlock_ = paths;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanBasketEngine<RNG>::operator
@@ -271,7 +293,8 @@ namespace QuantLib {
                                         tolerance_,
                                         maxSamples_,
                                         seed_,
-                                        calibrationSamples_));
+                                        calibrationSamples_,
+                                        pathBlock_));
     }
 
 }
@@ -34,7 +34,11 @@
 namespace QuantLib {
 
     //! Pricing engine for European basket options using Monte Carlo simulation
-    /*! \ingroup basketengines
+    /*! Paths are generated in blocks of the given size, so that the
+        correlation is applied to many paths at once; see
+        MultiPathGenerator.  The block doesn't change the results.
+
+        \ingroup basketengines
 
         \test the correctness of the returned value is tested by
               reproducing results available in literature.
@@ -58,7 +62,9 @@ namespace QuantLib {
                                Size requiredSamples,
                                Real requiredTolerance,
                                Size maxSamples,
-                               BigNatural seed);
+                               BigNatural seed,
+                               Size pathBlock =
+                                   path_generator_type::defaultPathBlock);
         void calculate() const {
             McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
                                                         requiredSamples_,
@@ -86,7 +92,8 @@ namespace QuantLib {
 
             return boost::shared_ptr<path_generator_type>(
                          new path_generator_type(processes_,
-                                                 grid, gen, brownianBridge_));
+                                                 grid, gen, brownianBridge_,
+                                                 pathBlock_));
         }
         boost::shared_ptr<path_pricer_type> pathPricer() const;
         // data members
@@ -97,6 +104,7 @@ namespace QuantLib {
         Real requiredTolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size pathBlock_;
     };
 
 
@@ -115,12 +123,13 @@ namespace QuantLib {
         MakeMCEuropeanBasketEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanBasketEngine& withMaxSamples(Size samples);
         MakeMCEuropeanBasketEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanBasketEngine& withPathBlock(Size paths);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
         boost::shared_ptr<StochasticProcessArray> process_;
         bool brownianBridge_, antithetic_;
-        Size steps_, stepsPerYear_, samples_, maxSamples_;
+        Size steps_, stepsPerYear_, samples_, maxSamples_, pathBlock_;
         Real tolerance_;
         BigNatural seed_;
     };
@@ -149,13 +158,14 @@ namespace QuantLib {
                    Size requiredSamples,
                    Real requiredTolerance,
                    Size maxSamples,
-                   BigNatural seed)
+                   BigNatural seed,
+                   Size pathBlock)
     : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false),
       processes_(processes), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
       requiredTolerance_(requiredTolerance),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed), pathBlock_(pathBlock) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -214,6 +224,8 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
+      pathBlock_(MCEuropeanBasketEngine<RNG,S>::path_generator_type
+                                                   ::defaultPathBlock),
       tolerance_(Null<Real>()), seed_(0) {}
 
     template <class RNG, class S>
@@ -279,6 +291,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanBasketEngine<RNG,S>&
+    MakeMCEuropeanBasketEngine<RNG,S>::withPathBlock(Size paths) {
+        pathBlock_ = paths;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanBasketEngine<RNG,S>::operator
@@ -295,7 +314,8 @@ namespace QuantLib {
                                           antithetic_,
                                           samples_, tolerance_,
                                           maxSamples_,
-                                          seed_));
+                                          seed_,
+                                          pathBlock_));
     }
 
 }
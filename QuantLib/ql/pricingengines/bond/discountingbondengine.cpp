@@ -20,14 +20,17 @@
 
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/termstructures/bootstrapsensitivities.hpp>
 
 namespace QuantLib {
 
     DiscountingBondEngine::DiscountingBondEngine(
                              const Handle<YieldTermStructure>& discountCurve,
-                             boost::optional<bool> includeSettlementDateFlows)
+                             boost::optional<bool> includeSettlementDateFlows,
+                             bool computeQuoteSensitivities)
     : discountCurve_(discountCurve),
-      includeSettlementDateFlows_(includeSettlementDateFlows) {
+      includeSettlementDateFlows_(includeSettlementDateFlows),
+      computeQuoteSensitivities_(computeQuoteSensitivities) {
         registerWith(discountCurve_);
     }
 
@@ -63,6 +66,23 @@ namespace QuantLib {
                                arguments_.settlementDate,
                                arguments_.settlementDate);
         }
+
+        if (computeQuoteSensitivities_) {
+            const BootstrapSensitivities* curve =
+                dynamic_cast<const BootstrapSensitivities*>(
+                                        discountCurve_.currentLink().get());
+            QL_REQUIRE(curve, "discount curve does not provide "
+                              "sensitivities to its quotes");
+            std::vector<Real> nodeSensitivities;
+            addNpvSensitivities(arguments_.cashflows, 1.0,
+                                discountCurve_.currentLink(),
+                                includeRefDateFlows,
+                                results_.valuationDate,
+                                results_.valuationDate,
+                                nodeSensitivities);
+            results_.additionalResults["quoteSensitivities"] =
+                curve->quoteSensitivities(nodeSensitivities);
+        }
     }
 
 }
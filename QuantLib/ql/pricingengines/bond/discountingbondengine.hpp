@@ -31,12 +31,18 @@
 
 namespace QuantLib {
 
+    /*! If required, the engine also returns the derivatives of the NPV
+        with respect to the quotes the discount curve was bootstrapped
+        on, as a std::vector<Real> additional result named
+        "quoteSensitivities"; see BootstrapSensitivities.
+    */
     class DiscountingBondEngine : public Bond::engine {
       public:
         DiscountingBondEngine(
               const Handle<YieldTermStructure>& discountCurve =
                                                 Handle<YieldTermStructure>(),
-              boost::optional<bool> includeSettlementDateFlows = boost::none);
+              boost::optional<bool> includeSettlementDateFlows = boost::none,
+              bool computeQuoteSensitivities = false);
         void calculate() const;
         Handle<YieldTermStructure> discountCurve() const {
             return discountCurve_;
@@ -44,6 +50,7 @@ namespace QuantLib {
       private:
         Handle<YieldTermStructure> discountCurve_;
         boost::optional<bool> includeSettlementDateFlows_;
+        bool computeQuoteSensitivities_;
     };
 
 }
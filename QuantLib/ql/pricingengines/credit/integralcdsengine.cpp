@@ -39,6 +39,104 @@ namespace QuantLib {
         registerWith(discountCurve_);
     }
 
+    void IntegralCdsEngine::update() {
+        periodData_.clear();
+        CreditDefaultSwap::engine::update();
+    }
+
+    bool IntegralCdsEngine::periodDataIsValid(
+                                     const Date& today,
+                                     const Date& settlementDate) const {
+        return !periodData_.empty()
+            && today == cachedToday_
+            && settlementDate == cachedSettlementDate_
+            && probability_->referenceDate() == cachedReferenceDate_
+            && arguments_.protectionStart == cachedProtectionStart_
+            && arguments_.notional == cachedNotional_
+            && arguments_.settlesAccrual == cachedSettlesAccrual_
+            && arguments_.paysAtDefaultTime == cachedPaysAtDefaultTime_
+            && arguments_.claim == cachedClaim_
+            && arguments_.leg == cachedLeg_;
+    }
+
+    void IntegralCdsEngine::resetPeriodData(
+                                     const Date& today,
+                                     const Date& settlementDate) const {
+        periodData_ = std::vector<PeriodData>(arguments_.leg.size());
+        cachedLeg_ = arguments_.leg;
+        cachedClaim_ = arguments_.claim;
+        cachedToday_ = today;
+        cachedSettlementDate_ = settlementDate;
+        cachedProtectionStart_ = arguments_.protectionStart;
+        cachedReferenceDate_ = probability_->referenceDate();
+        cachedNotional_ = arguments_.notional;
+        cachedSettlesAccrual_ = arguments_.settlesAccrual;
+        cachedPaysAtDefaultTime_ = arguments_.paysAtDefaultTime;
+    }
+
+    const IntegralCdsEngine::PeriodData&
+    IntegralCdsEngine::periodData(Size i) const {
+        PeriodData& data = periodData_[i];
+        if (data.initialized)
+            return data;
+
+        boost::shared_ptr<FixedRateCoupon> coupon =
+            boost::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
+
+        Date paymentDate = coupon->date(),
+             startDate = (i == 0 ? arguments_.protectionStart :
+                                   coupon->accrualStartDate()),
+             endDate = coupon->accrualEndDate();
+        Date effectiveStartDate =
+            (startDate <= cachedToday_ && cachedToday_ <= endDate) ?
+            cachedToday_ : startDate;
+        Real couponAmount = coupon->amount();
+
+        DiscountFactor endDiscount = discountCurve_->discount(paymentDate);
+        data.paymentTime = probability_->timeFromReference(paymentDate);
+        data.survivalWeight = couponAmount * endDiscount;
+
+        data.times.clear();
+        data.accrualWeights.clear();
+        data.claimWeights.clear();
+
+        Period step = integrationStep_;
+        Date d0 = effectiveStartDate;
+        Date d1 = std::min(d0 + step, endDate);
+        data.times.push_back(probability_->timeFromReference(d0));
+        do {
+            DiscountFactor B =
+                arguments_.paysAtDefaultTime ?
+                discountCurve_->discount(d1) :
+                endDiscount;
+
+            data.times.push_back(probability_->timeFromReference(d1));
+
+            // accrual...
+            Real accrual = 0.0;
+            if (arguments_.settlesAccrual) {
+                if (arguments_.paysAtDefaultTime)
+                    accrual = coupon->accruedAmount(d1) * B;
+                else
+                    accrual = couponAmount * B;
+            }
+            data.accrualWeights.push_back(accrual);
+
+            // ...and claim.
+            Real claim = arguments_.claim->amount(d1,
+                                                  arguments_.notional,
+                                                  recoveryRate_);
+            data.claimWeights.push_back(claim * B);
+
+            // setup for next time around the loop
+            d0 = d1;
+            d1 = std::min(d0 + step, endDate);
+        } while (d0 < endDate);
+
+        data.initialized = true;
+        return data;
+    }
+
     void IntegralCdsEngine::calculate() const {
         QL_REQUIRE(integrationStep_ != Period(),
                    "null period set");
@@ -69,6 +167,12 @@ namespace QuantLib {
         results_.upfrontNPV = upfPVO1 * arguments_.upfrontPayment->amount();
 		results_.upfrontPV01 = upfPVO1;
 
+        if (!periodDataIsValid(today, settlementDate))
+            resetPeriodData(today, settlementDate);
+
+        // In order to avoid a few switches, we calculate the NPV
+        // of both legs as a positive quantity. We'll give them
+        // the right sign at the end.
         results_.couponLegNPV = 0.0;
         results_.defaultLegNPV = 0.0;
         for (Size i=0; i<arguments_.leg.size(); ++i) {
@@ -76,68 +180,26 @@ namespace QuantLib {
                                                includeSettlementDateFlows_))
                 continue;
 
-            boost::shared_ptr<FixedRateCoupon> coupon =
-                boost::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
-
-            // In order to avoid a few switches, we calculate the NPV
-            // of both legs as a positive quantity. We'll give them
-            // the right sign at the end.
-
-            Date paymentDate = coupon->date(),
-                 startDate = (i == 0 ? arguments_.protectionStart :
-                                       coupon->accrualStartDate()),
-                 endDate = coupon->accrualEndDate();
-            Date effectiveStartDate =
-                (startDate <= today && today <= endDate) ? today : startDate;
-            Date defaultDate = // mid-point
-                effectiveStartDate + (endDate-effectiveStartDate)/2;
-            Real couponAmount = coupon->amount();
+            const PeriodData& data = periodData(i);
 
-            Probability S = probability_->survivalProbability(paymentDate);
+            Probability S =
+                probability_->survivalProbability(data.paymentTime);
 
             // On one side, we add the fixed rate payments in case of
             // survival.
-            results_.couponLegNPV +=
-                S * couponAmount * discountCurve_->discount(paymentDate);
+            results_.couponLegNPV += S * data.survivalWeight;
 
             // On the other side, we add the payment (and possibly the
             // accrual) in case of default.
-
-            Period step = integrationStep_;
-            Date d0 = effectiveStartDate;
-            Date d1 = std::min(d0 + step, endDate);
-            Probability P0 = probability_->defaultProbability(d0);
-            DiscountFactor endDiscount = discountCurve_->discount(paymentDate);
-            do {
-                DiscountFactor B =
-                    arguments_.paysAtDefaultTime ?
-                    discountCurve_->discount(d1) :
-                    endDiscount;
-
-                Probability P1 = probability_->defaultProbability(d1);
+            Probability P0 = probability_->defaultProbability(data.times[0]);
+            for (Size j=1; j<data.times.size(); ++j) {
+                Probability P1 =
+                    probability_->defaultProbability(data.times[j]);
                 Probability dP = P1 - P0;
-
-                // accrual...
-                if (arguments_.settlesAccrual) {
-                    if (arguments_.paysAtDefaultTime)
-                        results_.couponLegNPV +=
-                            coupon->accruedAmount(d1) * B * dP;
-                    else
-                        results_.couponLegNPV +=
-                            couponAmount * B * dP;
-                }
-
-                // ...and claim.
-                Real claim = arguments_.claim->amount(d1,
-                                                      arguments_.notional,
-                                                      recoveryRate_);
-                results_.defaultLegNPV += claim * B * dP;
-
-                // setup for next time around the loop
+                results_.couponLegNPV += data.accrualWeights[j-1] * dP;
+                results_.defaultLegNPV += data.claimWeights[j-1] * dP;
                 P0 = P1;
-                d0 = d1;
-                d1 = std::min(d0 + step, endDate);
-            } while (d0 < endDate);
+            }
         }
 
         Real upfrontSign = 1.0;
@@ -29,6 +29,12 @@
 
 namespace QuantLib {
 
+    /*! As in MidPointCdsEngine, the integration grid of each coupon
+        period and the corresponding discounted accruals and claims
+        are calculated once and reused until the engine is notified
+        or the swap being priced changes; subsequent calculations
+        only evaluate default probabilities on the stored grid.
+    */
     class IntegralCdsEngine : public CreditDefaultSwap::engine {
       public:
         IntegralCdsEngine(
@@ -38,12 +44,35 @@ namespace QuantLib {
               const Handle<YieldTermStructure>& discountCurve,
               boost::optional<bool> includeSettlementDateFlows = boost::none);
         void calculate() const;
+        void update();
       private:
+        struct PeriodData {
+            PeriodData() : initialized(false) {}
+            bool initialized;
+            Time paymentTime;
+            Real survivalWeight;
+            // integration grid, starting at the effective start date
+            std::vector<Time> times;
+            std::vector<Real> accrualWeights, claimWeights;
+        };
+        bool periodDataIsValid(const Date& today,
+                               const Date& settlementDate) const;
+        void resetPeriodData(const Date& today,
+                             const Date& settlementDate) const;
+        const PeriodData& periodData(Size i) const;
         Period integrationStep_;
         Handle<DefaultProbabilityTermStructure> probability_;
         Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
         boost::optional<bool> includeSettlementDateFlows_;
+        // cached period data and the inputs they were calculated for
+        mutable std::vector<PeriodData> periodData_;
+        mutable Leg cachedLeg_;
+        mutable boost::shared_ptr<Claim> cachedClaim_;
+        mutable Date cachedToday_, cachedSettlementDate_;
+        mutable Date cachedProtectionStart_, cachedReferenceDate_;
+        mutable Real cachedNotional_;
+        mutable bool cachedSettlesAccrual_, cachedPaysAtDefaultTime_;
     };
 
 }
@@ -38,6 +38,89 @@ namespace QuantLib {
         registerWith(discountCurve_);
     }
 
+    void MidPointCdsEngine::update() {
+        periodData_.clear();
+        CreditDefaultSwap::engine::update();
+    }
+
+    bool MidPointCdsEngine::periodDataIsValid(
+                                     const Date& today,
+                                     const Date& settlementDate) const {
+        return !periodData_.empty()
+            && today == cachedToday_
+            && settlementDate == cachedSettlementDate_
+            && probability_->referenceDate() == cachedReferenceDate_
+            && arguments_.protectionStart == cachedProtectionStart_
+            && arguments_.notional == cachedNotional_
+            && arguments_.settlesAccrual == cachedSettlesAccrual_
+            && arguments_.paysAtDefaultTime == cachedPaysAtDefaultTime_
+            && arguments_.claim == cachedClaim_
+            && arguments_.leg == cachedLeg_;
+    }
+
+    void MidPointCdsEngine::resetPeriodData(
+                                     const Date& today,
+                                     const Date& settlementDate) const {
+        periodData_ = std::vector<PeriodData>(arguments_.leg.size());
+        cachedLeg_ = arguments_.leg;
+        cachedClaim_ = arguments_.claim;
+        cachedToday_ = today;
+        cachedSettlementDate_ = settlementDate;
+        cachedProtectionStart_ = arguments_.protectionStart;
+        cachedReferenceDate_ = probability_->referenceDate();
+        cachedNotional_ = arguments_.notional;
+        cachedSettlesAccrual_ = arguments_.settlesAccrual;
+        cachedPaysAtDefaultTime_ = arguments_.paysAtDefaultTime;
+    }
+
+    const MidPointCdsEngine::PeriodData&
+    MidPointCdsEngine::periodData(Size i) const {
+        PeriodData& data = periodData_[i];
+        if (data.initialized)
+            return data;
+
+        boost::shared_ptr<FixedRateCoupon> coupon =
+            boost::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
+
+        Date paymentDate = coupon->date(),
+             startDate = coupon->accrualStartDate(),
+             endDate = coupon->accrualEndDate();
+        // this is the only point where it might not coincide
+        if (i==0)
+            startDate = arguments_.protectionStart;
+        Date effectiveStartDate =
+            (startDate <= cachedToday_ && cachedToday_ <= endDate) ?
+            cachedToday_ : startDate;
+        Date defaultDate = // mid-point
+            effectiveStartDate + (endDate-effectiveStartDate)/2;
+
+        data.paymentTime = probability_->timeFromReference(paymentDate);
+        data.startTime = probability_->timeFromReference(effectiveStartDate);
+        data.endTime = probability_->timeFromReference(endDate);
+
+        DiscountFactor paymentDiscount = discountCurve_->discount(paymentDate);
+        data.survivalWeight = coupon->amount() * paymentDiscount;
+
+        Real claim = arguments_.claim->amount(defaultDate,
+                                              arguments_.notional,
+                                              recoveryRate_);
+        if (arguments_.paysAtDefaultTime) {
+            DiscountFactor defaultDiscount =
+                discountCurve_->discount(defaultDate);
+            data.accrualWeight = arguments_.settlesAccrual ?
+                coupon->accruedAmount(defaultDate) * defaultDiscount : 0.0;
+            data.claimWeight = claim * defaultDiscount;
+        } else {
+            // pays at the end
+            data.accrualWeight = arguments_.settlesAccrual ?
+                data.survivalWeight : 0.0;
+            data.claimWeight = claim * paymentDiscount;
+        }
+
+        data.initialized = true;
+        return data;
+    }
+
     void MidPointCdsEngine::calculate() const {
         QL_REQUIRE(!discountCurve_.empty(),
                    "no discount term structure set");
@@ -68,6 +151,12 @@ namespace QuantLib {
 		results_.upfrontNPV = upfPVO1 * arguments_.upfrontPayment->amount();
 		results_.upfrontPV01 = upfPVO1;
 
+        if (!periodDataIsValid(today, settlementDate))
+            resetPeriodData(today, settlementDate);
+
+        // In order to avoid a few switches, we calculate the NPV
+        // of both legs as a positive quantity. We'll give them
+        // the right sign at the end.
         results_.couponLegNPV  = 0.0;
         results_.defaultLegNPV = 0.0;
         for (Size i=0; i<arguments_.leg.size(); ++i) {
@@ -75,59 +164,19 @@ namespace QuantLib {
                                                includeSettlementDateFlows_))
                 continue;
 
-            boost::shared_ptr<FixedRateCoupon> coupon =
-                boost::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
-
-            // In order to avoid a few switches, we calculate the NPV
-            // of both legs as a positive quantity. We'll give them
-            // the right sign at the end.
-
-            Date paymentDate = coupon->date(),
-                 startDate = coupon->accrualStartDate(),
-                 endDate = coupon->accrualEndDate();
-            // this is the only point where it might not coincide
-            if (i==0)
-                startDate = arguments_.protectionStart;
-            Date effectiveStartDate =
-                (startDate <= today && today <= endDate) ? today : startDate;
-            Date defaultDate = // mid-point
-                effectiveStartDate + (endDate-effectiveStartDate)/2;
-
-            Probability S = probability_->survivalProbability(paymentDate);
-            Probability P = probability_->defaultProbability(
-                                                effectiveStartDate,
-                                                endDate);
+            const PeriodData& data = periodData(i);
+
+            Probability S =
+                probability_->survivalProbability(data.paymentTime);
+            Probability P = probability_->defaultProbability(data.startTime,
+                                                             data.endTime);
 
             // on one side, we add the fixed rate payments in case of
-            // survival...
+            // survival, possibly including accrual in case of default;
             results_.couponLegNPV +=
-                S * coupon->amount() *
-                discountCurve_->discount(paymentDate);
-            // ...possibly including accrual in case of default.
-            if (arguments_.settlesAccrual) {
-                if (arguments_.paysAtDefaultTime) {
-                    results_.couponLegNPV +=
-                        P * coupon->accruedAmount(defaultDate) *
-                        discountCurve_->discount(defaultDate);
-                } else {
-                    // pays at the end
-                    results_.couponLegNPV +=
-                        P * coupon->amount() *
-                        discountCurve_->discount(paymentDate);
-                }
-            }
-
+                S * data.survivalWeight + P * data.accrualWeight;
             // on the other side, we add the payment in case of default.
-            Real claim = arguments_.claim->amount(defaultDate,
-                                                  arguments_.notional,
-                                                  recoveryRate_);
-            if (arguments_.paysAtDefaultTime) {
-                results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(defaultDate);
-            } else {
-                results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(paymentDate);
-            }
+            results_.defaultLegNPV += P * data.claimWeight;
         }
 
         Real upfrontSign = 1.0;
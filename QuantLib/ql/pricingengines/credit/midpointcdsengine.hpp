@@ -30,6 +30,16 @@
 
 namespace QuantLib {
 
+    /*! The date-dependent part of each coupon period (default date,
+        accrued amount and claim at default, discount factors and
+        times on the default-probability curve) is stored the first
+        time the period is priced and reused by subsequent
+        calculations, so that only the survival probabilities are
+        evaluated when the default curve alone changes---as it does
+        between solver iterations while a default curve is being
+        bootstrapped.  The stored data are discarded whenever the
+        engine is notified or the swap being priced changes.
+    */
     class MidPointCdsEngine : public CreditDefaultSwap::engine {
       public:
         MidPointCdsEngine(
@@ -38,11 +48,31 @@ namespace QuantLib {
               const Handle<YieldTermStructure>& discountCurve,
               boost::optional<bool> includeSettlementDateFlows = boost::none);
         void calculate() const;
+        void update();
       private:
+        struct PeriodData {
+            PeriodData() : initialized(false) {}
+            bool initialized;
+            Time paymentTime, startTime, endTime;
+            Real survivalWeight, accrualWeight, claimWeight;
+        };
+        bool periodDataIsValid(const Date& today,
+                               const Date& settlementDate) const;
+        void resetPeriodData(const Date& today,
+                             const Date& settlementDate) const;
+        const PeriodData& periodData(Size i) const;
         Handle<DefaultProbabilityTermStructure> probability_;
         Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
         boost::optional<bool> includeSettlementDateFlows_;
+        // cached period data and the inputs they were calculated for
+        mutable std::vector<PeriodData> periodData_;
+        mutable Leg cachedLeg_;
+        mutable boost::shared_ptr<Claim> cachedClaim_;
+        mutable Date cachedToday_, cachedSettlementDate_;
+        mutable Date cachedProtectionStart_, cachedReferenceDate_;
+        mutable Real cachedNotional_;
+        mutable bool cachedSettlesAccrual_, cachedPaysAtDefaultTime_;
     };
 
 }
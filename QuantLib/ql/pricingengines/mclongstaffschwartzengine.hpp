@@ -30,6 +30,36 @@
 
 namespace QuantLib {
 
+    namespace detail {
+
+        template <class GSG>
+        inline PathGenerator<GSG>* newLsPathGenerator(
+                          const boost::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& grid,
+                          const GSG& generator,
+                          bool brownianBridge,
+                          Size pathBlock,
+                          const PathGenerator<GSG>*) {
+            QL_REQUIRE(pathBlock == 1,
+                       "path blocks not supported for single-variate paths");
+            return new PathGenerator<GSG>(process, grid, generator,
+                                          brownianBridge);
+        }
+
+        template <class GSG>
+        inline MultiPathGenerator<GSG>* newLsPathGenerator(
+                          const boost::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& grid,
+                          const GSG& generator,
+                          bool brownianBridge,
+                          Size pathBlock,
+                          const MultiPathGenerator<GSG>*) {
+            return new MultiPathGenerator<GSG>(process, grid, generator,
+                                               brownianBridge, pathBlock);
+        }
+
+    }
+
     //! Longstaff-Schwarz Monte Carlo engine for early exercise options
     /*! References:
 
@@ -37,6 +67,14 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        Multi-variate paths can be generated in blocks of the given
+        size (see MultiPathGenerator); single-variate ones can't.
+
+        Up to maxStoredCalibrationPaths calibration paths are stored.
+        Beyond that, they are generated again for each exercise time
+        instead, which bounds memory at the cost of one path
+        generation per exercise time (see LongstaffSchwartzPathPricer).
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -52,6 +90,8 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename McSimulation<MC,RNG,S>::path_generator_type
             path_generator_type;
+        //! calibration paths beyond which they are no longer stored
+        static const Size maxStoredCalibrationPaths = 65536;
 
         MCLongstaffSchwartzEngine(
             const boost::shared_ptr<StochasticProcess>& process,
@@ -64,7 +104,8 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples = Null<Size>());
+            Size nCalibrationSamples = Null<Size>(),
+            Size pathBlock = 1);
 
         void calculate() const;
 
@@ -85,11 +126,17 @@ namespace QuantLib {
         const Size maxSamples_;
         const Size seed_;
         const Size nCalibrationSamples_;
+        const Size pathBlock_;
 
         mutable boost::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
             pathPricer_;
     };
 
+    template <class GenericEngine, template <class> class MC,
+              class RNG, class S>
+    const Size MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::
+        maxStoredCalibrationPaths;
+
     template <class GenericEngine, template <class> class MC,
               class RNG, class S>
     inline MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::
@@ -104,7 +151,8 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples)
+            Size nCalibrationSamples,
+            Size pathBlock)
     : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate),
       process_            (process),
       timeSteps_          (timeSteps),
@@ -115,7 +163,8 @@ namespace QuantLib {
       maxSamples_         (maxSamples),
       seed_               (seed),
       nCalibrationSamples_( (nCalibrationSamples == Null<Size>())
-                            ? 2048 : nCalibrationSamples) {
+                            ? 2048 : nCalibrationSamples),
+      pathBlock_          (pathBlock) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -147,13 +196,27 @@ namespace QuantLib {
     inline
     void MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::calculate() const {
         pathPricer_ = this->lsmPathPricer();
-        this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                          new MonteCarloModel<MC,RNG,S>
-                              (pathGenerator(), pathPricer_,
-                               stats_type(), this->antitheticVariate_));
 
-        this->mcModel_->addSamples(nCalibrationSamples_);
-        this->pathPricer_->calibrate();
+        Size calibrationPaths = this->antitheticVariate_ ?
+                                2*nCalibrationSamples_ :
+                                nCalibrationSamples_;
+        if (calibrationPaths <= maxStoredCalibrationPaths) {
+            this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                              new MonteCarloModel<MC,RNG,S>
+                                  (pathGenerator(), pathPricer_,
+                                   stats_type(), this->antitheticVariate_));
+
+            this->mcModel_->addSamples(nCalibrationSamples_);
+            this->pathPricer_->calibrate();
+        } else {
+            // too many paths to store; they are drawn again for each
+            // exercise time
+            this->pathPricer_->calibrate(
+                boost::function<boost::shared_ptr<path_generator_type>()>(
+                    boost::bind(&MCLongstaffSchwartzEngine::pathGenerator,
+                                this)),
+                nCalibrationSamples_, this->antitheticVariate_);
+        }
 
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
                                           requiredSamples_,
@@ -193,9 +256,11 @@ namespace QuantLib {
         TimeGrid grid = this->timeGrid();
         typename RNG::rsg_type generator =
             RNG::make_sequence_generator(dimensions*(grid.size()-1),seed_);
+        const path_generator_type* tag = 0;
         return boost::shared_ptr<path_generator_type>(
-                   new path_generator_type(process_,
-                                           grid, generator, brownianBridge_));
+                   detail::newLsPathGenerator(process_, grid, generator,
+                                              brownianBridge_, pathBlock_,
+                                              tag));
     }
 
 }
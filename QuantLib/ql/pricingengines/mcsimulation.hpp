@@ -28,14 +28,49 @@
 
 #include <ql/grid.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <string>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // traits without independent randomizations
+        template <class RNG>
+        struct McRandomization {
+            static Size replications() { return 0; }
+            template <class PG>
+            static void randomize(PG&, BigNatural) {
+                QL_FAIL("random-number traits do not allow randomization");
+            }
+        };
+
+        template <class URSG, class IC>
+        struct McRandomization<GenericRandomizedLowDiscrepancy<URSG,IC> > {
+            typedef GenericRandomizedLowDiscrepancy<URSG,IC> traits;
+            static Size replications() { return traits::replications; }
+            template <class PG>
+            static void randomize(PG& generator, BigNatural randomization) {
+                traits::randomize(generator.sequenceGenerator(),
+                                  randomization);
+            }
+        };
+
+    }
+
     //! base class for Monte Carlo engines
     /*! Eventually this class might offer greeks methods.  Deriving a
         class from McSimulation gives an easy way to write a Monte
         Carlo engine.
 
+        When randomized quasi-Monte Carlo traits are used (see
+        GenericRandomizedLowDiscrepancy) a number of independent
+        randomizations of the sequence are simulated in parallel,
+        each with the same number of samples, and the sample
+        accumulator collects their averages; its mean is the
+        estimate and its error estimate gives a confidence interval
+        for the quasi-Monte Carlo result.
+
         See McVanillaEngine as an example.
     */
 
@@ -97,6 +132,13 @@ namespace QuantLib {
         
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+      private:
+        boost::shared_ptr<MonteCarloModel<MC,RNG,S> > monteCarloModel(
+                                     result_type controlVariateValue,
+                                     BigNatural randomization) const;
+        void addReplicationSamples(Size samples) const;
+        mutable std::vector<boost::shared_ptr<MonteCarloModel<MC,RNG,S> > >
+                                                               replications_;
     };
 
 
@@ -106,6 +148,32 @@ namespace QuantLib {
         McSimulation<MC,RNG,S>::value(Real tolerance,
                                               Size maxSamples,
                                               Size minSamples) const {
+        if (!replications_.empty()) {
+            // the number of samples per replication is doubled, so
+            // that the points used are nets of the sequence
+            Size n = replications_.size();
+            Size samples = replications_.front()->sampleAccumulator().samples();
+            if (samples == 0) {
+                samples = 1;
+                while (samples*n < minSamples)
+                    samples *= 2;
+                addReplicationSamples(samples);
+            }
+            result_type error(mcModel_->sampleAccumulator().errorEstimate());
+            while (maxError(error) > tolerance) {
+                QL_REQUIRE((samples+1)*n <= maxSamples,
+                           "max number of samples (" << maxSamples
+                           << ") reached, while error (" << error
+                           << ") is still above tolerance ("
+                           << tolerance << ")");
+                samples = std::min(2*samples, maxSamples/n);
+                addReplicationSamples(samples);
+                error = result_type(
+                             mcModel_->sampleAccumulator().errorEstimate());
+            }
+            return result_type(mcModel_->sampleAccumulator().mean());
+        }
+
         Size sampleNumber =
             mcModel_->sampleAccumulator().samples();
         if (sampleNumber<minSamples) {
@@ -143,6 +211,19 @@ namespace QuantLib {
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::valueWithSamples(Size samples) const {
 
+        if (!replications_.empty()) {
+            Size n = replications_.size();
+            Size sampleNumber =
+                replications_.front()->sampleAccumulator().samples();
+            Size required = (samples+n-1)/n;
+            QL_REQUIRE(required>=sampleNumber,
+                       "number of already simulated samples ("
+                       << sampleNumber*n << ") greater than requested "
+                       "samples (" << samples << ")");
+            addReplicationSamples(required);
+            return result_type(mcModel_->sampleAccumulator().mean());
+        }
+
         Size sampleNumber = mcModel_->sampleAccumulator().samples();
 
         QL_REQUIRE(samples>=sampleNumber,
@@ -165,12 +246,56 @@ namespace QuantLib {
                    "neither tolerance nor number of samples set");
 
         //! Initialize the one-factor Monte Carlo
+        result_type controlVariateValue = Null<result_type>();
         if (this->controlVariate_) {
-
-            result_type controlVariateValue = this->controlVariateValue();
+            controlVariateValue = this->controlVariateValue();
             QL_REQUIRE(controlVariateValue != Null<result_type>(),
                        "engine does not provide "
                        "control-variation price");
+        }
+
+        replications_.clear();
+        Size replications = detail::McRandomization<RNG>::replications();
+        if (replications > 0) {
+            for (Size i=0; i<replications; ++i)
+                replications_.push_back(
+                            monteCarloModel(controlVariateValue, i));
+            // the model only stores the results of the replications
+            this->mcModel_ =
+                boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                    new MonteCarloModel<MC,RNG,S>(
+                           boost::shared_ptr<path_generator_type>(),
+                           boost::shared_ptr<path_pricer_type>(), S(),
+                           this->antitheticVariate_));
+        } else {
+            this->mcModel_ = monteCarloModel(controlVariateValue,
+                                             Null<BigNatural>());
+        }
+
+        if (requiredTolerance != Null<Real>()) {
+            if (maxSamples != Null<Size>())
+                this->value(requiredTolerance, maxSamples);
+            else
+                this->value(requiredTolerance);
+        } else {
+            this->valueWithSamples(requiredSamples);
+        }
+
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline boost::shared_ptr<MonteCarloModel<MC,RNG,S> >
+    McSimulation<MC,RNG,S>::monteCarloModel(
+                                      result_type controlVariateValue,
+                                      BigNatural randomization) const {
+
+        boost::shared_ptr<path_generator_type> generator =
+            this->pathGenerator();
+        if (randomization != Null<BigNatural>())
+            detail::McRandomization<RNG>::randomize(*generator,
+                                                    randomization);
+
+        if (this->controlVariate_) {
 
             boost::shared_ptr<path_pricer_type> controlPP =
                 this->controlPathPricer();
@@ -180,30 +305,59 @@ namespace QuantLib {
 
             boost::shared_ptr<path_generator_type> controlPG = 
                 this->controlPathGenerator();
+            if (controlPG && randomization != Null<BigNatural>())
+                detail::McRandomization<RNG>::randomize(*controlPG,
+                                                        randomization);
 
-            this->mcModel_ =
-                boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+            return boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                     new MonteCarloModel<MC,RNG,S>(
-                           pathGenerator(), this->pathPricer(), stats_type(),
+                           generator, this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
                            controlVariateValue, controlPG));
         } else {
-            this->mcModel_ =
-                boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+            return boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                     new MonteCarloModel<MC,RNG,S>(
-                           pathGenerator(), this->pathPricer(), S(),
+                           generator, this->pathPricer(), S(),
                            this->antitheticVariate_));
         }
+    }
 
-        if (requiredTolerance != Null<Real>()) {
-            if (maxSamples != Null<Size>())
-                this->value(requiredTolerance, maxSamples);
-            else
-                this->value(requiredTolerance);
-        } else {
-            this->valueWithSamples(requiredSamples);
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::addReplicationSamples(
+                                                       Size samples) const {
+        long n = replications_.size();
+        std::vector<Size> nextBatch(n);
+        for (long i=0; i<n; ++i)
+            nextBatch[i] =
+                samples - replications_[i]->sampleAccumulator().samples();
+
+        // the first replication runs alone, so that data cached lazily
+        // by the process are not initialized concurrently
+        replications_[0]->addSamples(nextBatch[0]);
+
+        std::vector<std::string> errors(n);
+        #pragma omp parallel for
+        for (long i=1; i<n; ++i) {
+            try {
+                replications_[i]->addSamples(nextBatch[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
         }
-
+        for (long i=1; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(), errors[i]);
+
+        S accumulator;
+        for (long i=0; i<n; ++i)
+            accumulator.add(replications_[i]->sampleAccumulator().mean());
+        this->mcModel_ =
+            boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                new MonteCarloModel<MC,RNG,S>(
+                       boost::shared_ptr<path_generator_type>(),
+                       boost::shared_ptr<path_pricer_type>(), accumulator,
+                       this->antitheticVariate_));
     }
 
     template <template <class> class MC, class RNG, class S>
@@ -0,0 +1,383 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file mlmcsimulation.hpp
+    \brief framework for multilevel Monte Carlo engines
+*/
+
+#ifndef quantlib_multilevel_montecarlo_engine_hpp
+#define quantlib_multilevel_montecarlo_engine_hpp
+
+#include <ql/methods/montecarlo/multilevelpathgenerator.hpp>
+#include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/math/statistics/statistics.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        inline const Path& mlmcPath(const MultiPath& path, const Path*) {
+            return path[0];
+        }
+
+        inline const MultiPath& mlmcPath(const MultiPath& path,
+                                         const MultiPath*) {
+            return path;
+        }
+
+    }
+
+    //! base class for multilevel Monte Carlo engines
+    /*! Implements the multilevel Monte Carlo method described in
+        M.B. Giles, "Multilevel Monte Carlo path simulation",
+        Operations Research, 56(3), pp. 607-617, 2008.
+
+        The value on the finest grid is written as the value on the
+        coarsest one plus a telescoping sum of corrections.  Level
+        \f$ l \f$ uses the coarsest grid with each step split into
+        \f$ M^l \f$ sub-steps, \f$ M \f$ being the refinement factor;
+        its correction is estimated by pricing a path on the level
+        grid together with a path on the previous level grid driven
+        by the same Brownian increments (see MultilevelPathGenerator)
+        so that its variance decreases as the grid is refined.
+
+        Given a required root-mean-square error \f$ \epsilon \f$,
+        levels are added until the estimated discretization bias
+        falls below \f$ \epsilon/\sqrt{2} \f$, and samples are
+        allocated among levels as
+        \f$ N_l \propto \sqrt{V_l/C_l} \f$ so that the statistical
+        error falls below \f$ \epsilon/\sqrt{2} \f$ at minimal cost;
+        \f$ V_l \f$ is the estimated variance of the correction and
+        \f$ C_l \f$ the number of evolution steps needed to sample
+        it.  The bias is estimated from the last corrections
+        assuming first-order weak convergence, as for the Euler
+        scheme.
+
+        Deriving a class from MultilevelMcSimulation gives an easy
+        way to write a multilevel engine; see
+        MLMCEuropeanHestonEngine as an example.
+    */
+    template <template <class> class MC, class RNG, class S = Statistics>
+    class MultilevelMcSimulation {
+      public:
+        typedef typename MC<RNG>::path_type path_type;
+        typedef typename MC<RNG>::path_pricer_type path_pricer_type;
+        typedef MultilevelPathGenerator<typename RNG::rsg_type>
+            path_generator_type;
+        typedef S stats_type;
+
+        virtual ~MultilevelMcSimulation() {}
+        /*! add levels and samples until the required RMSE is reached;
+            not available for RNG policies not allowing error estimates,
+            which must use valueWithSamples instead.
+        */
+        Real value(Real tolerance,
+                   Size maxSamples = QL_MAX_INTEGER) const;
+        //! simulate a fixed number of samples on each level
+        Real valueWithSamples(const std::vector<Size>& samples) const;
+        //! estimate using the samples simulated so far
+        Real mean() const;
+        //! statistical error estimated using the samples simulated so far
+        Real errorEstimate() const;
+        //! estimated discretization bias of the finest level
+        Real biasEstimate() const;
+        //! number of levels simulated so far
+        Size levels() const { return stats_.size(); }
+        //! accumulators for the corrections on each level
+        const std::vector<stats_type>& levelAccumulators() const {
+            return stats_;
+        }
+        //! cost of a sample on each level, as number of evolution steps
+        const std::vector<Real>& levelCosts() const { return costs_; }
+        //! basic calculate method provided to inherited pricing engines
+        void calculate(Real requiredTolerance,
+                       Size maxSamples) const;
+      protected:
+        MultilevelMcSimulation(Size refinement,
+                               Size minLevels,
+                               Size maxLevels,
+                               Size initialSamples,
+                               BigNatural seed);
+        virtual boost::shared_ptr<StochasticProcess> process() const = 0;
+        //! time grid of the coarsest level
+        virtual TimeGrid timeGrid() const = 0;
+        //! path pricer for paths on the given level grid
+        virtual boost::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const = 0;
+
+        Size refinement_, minLevels_, maxLevels_, initialSamples_;
+        BigNatural seed_;
+      private:
+        TimeGrid levelGrid(Size level) const;
+        void addLevel() const;
+        void addSamples(Size level, Size samples) const;
+
+        mutable TimeGrid grid_;
+        mutable MersenneTwisterUniformRng seedGenerator_;
+        mutable std::vector<stats_type> stats_;
+        mutable std::vector<Real> costs_;
+        mutable std::vector<boost::shared_ptr<path_generator_type> >
+                                                                generators_;
+        mutable std::vector<boost::shared_ptr<path_pricer_type> >
+                                                finePricers_, coarsePricers_;
+    };
+
+
+    // inline definitions
+
+    template <template <class> class MC, class RNG, class S>
+    inline MultilevelMcSimulation<MC,RNG,S>::MultilevelMcSimulation(
+                                                        Size refinement,
+                                                        Size minLevels,
+                                                        Size maxLevels,
+                                                        Size initialSamples,
+                                                        BigNatural seed)
+    : refinement_(refinement), minLevels_(minLevels), maxLevels_(maxLevels),
+      initialSamples_(initialSamples), seed_(seed) {
+        QL_REQUIRE(refinement > 1,
+                   "refinement must be greater than 1, "
+                   << refinement << " not allowed");
+        QL_REQUIRE(minLevels >= 2,
+                   "at least two levels are needed to estimate the bias, "
+                   << minLevels << " not allowed");
+        QL_REQUIRE(maxLevels >= minLevels,
+                   "max number of levels (" << maxLevels
+                   << ") less than min number of levels ("
+                   << minLevels << ")");
+        QL_REQUIRE(initialSamples >= 2,
+                   "at least two initial samples are needed, "
+                   << initialSamples << " not allowed");
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline TimeGrid MultilevelMcSimulation<MC,RNG,S>::levelGrid(
+                                                         Size level) const {
+        Size subSteps = 1;
+        for (Size l=0; l<level; l++)
+            subSteps *= refinement_;
+
+        std::vector<Time> times(1, grid_.front());
+        for (Size i=1; i<grid_.size(); i++) {
+            Time dt = grid_.dt(i-1)/subSteps;
+            for (Size j=1; j<subSteps; j++)
+                times.push_back(grid_[i-1] + j*dt);
+            times.push_back(grid_[i]);
+        }
+        return TimeGrid(times.begin(), times.end());
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultilevelMcSimulation<MC,RNG,S>::addLevel() const {
+        Size level = stats_.size();
+        TimeGrid grid = levelGrid(level);
+        Size steps = grid.size()-1;
+        boost::shared_ptr<StochasticProcess> process = this->process();
+
+        typename RNG::rsg_type generator =
+            RNG::make_sequence_generator(process->factors()*steps,
+                                         seedGenerator_.nextInt32());
+        generators_.push_back(boost::shared_ptr<path_generator_type>(
+            new path_generator_type(process, grid,
+                                    level == 0 ? 1 : refinement_,
+                                    generator)));
+
+        finePricers_.push_back(pathPricer(grid));
+        if (level == 0) {
+            coarsePricers_.push_back(boost::shared_ptr<path_pricer_type>());
+            costs_.push_back(Real(steps));
+        } else {
+            coarsePricers_.push_back(pathPricer(levelGrid(level-1)));
+            costs_.push_back(Real(steps + steps/refinement_));
+        }
+        stats_.push_back(stats_type());
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultilevelMcSimulation<MC,RNG,S>::addSamples(
+                                                       Size level,
+                                                       Size samples) const {
+        const path_generator_type& generator = *generators_[level];
+        const path_pricer_type& finePricer = *finePricers_[level];
+        const path_type* tag = 0;
+        for (Size i=0; i<samples; i++) {
+            const typename path_generator_type::sample_type& path =
+                generator.next();
+            Real correction = finePricer(detail::mlmcPath(path.value, tag));
+            if (level > 0)
+                correction -= (*coarsePricers_[level])(
+                               detail::mlmcPath(generator.coarse().value, tag));
+            stats_[level].add(correction, path.weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Real MultilevelMcSimulation<MC,RNG,S>::mean() const {
+        Real sum = 0.0;
+        for (Size l=0; l<stats_.size(); l++)
+            sum += stats_[l].mean();
+        return sum;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Real MultilevelMcSimulation<MC,RNG,S>::value(
+                                                     Real tolerance,
+                                                     Size maxSamples) const {
+        QL_REQUIRE(tolerance > 0.0,
+                   "tolerance must be positive, "
+                   << tolerance << " not allowed");
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+
+        while (stats_.size() < minLevels_)
+            addLevel();
+
+        std::vector<Size> extraSamples(stats_.size());
+        for (Size l=0; l<stats_.size(); l++)
+            if (stats_[l].samples() < initialSamples_)
+                extraSamples[l] = initialSamples_ - stats_[l].samples();
+
+        // half of the mean square error is allowed for the
+        // statistical error and half for the discretization bias
+        const Real variance = tolerance*tolerance/2.0;
+        for (;;) {
+            Size sampleNumber = 0;
+            for (Size l=0; l<stats_.size(); l++)
+                sampleNumber += stats_[l].samples() + extraSamples[l];
+            QL_REQUIRE(sampleNumber <= maxSamples,
+                       "max number of samples (" << maxSamples
+                       << ") reached, while error (" << errorEstimate()
+                       << ") is still above tolerance (" << tolerance << ")");
+
+            for (Size l=0; l<stats_.size(); l++)
+                if (extraSamples[l] > 0)
+                    addSamples(l, extraSamples[l]);
+
+            // optimal number of samples on each level
+            Real sum = 0.0;
+            for (Size l=0; l<stats_.size(); l++)
+                sum += std::sqrt(stats_[l].variance()*costs_[l]);
+            bool converged = true;
+            for (Size l=0; l<stats_.size(); l++) {
+                Real optimal = std::ceil(
+                    std::sqrt(stats_[l].variance()/costs_[l])*sum/variance);
+                Size samples = stats_[l].samples();
+                if (optimal > Real(samples)) {
+                    extraSamples[l] = Size(optimal) - samples;
+                    converged = false;
+                } else {
+                    extraSamples[l] = 0;
+                }
+            }
+            if (!converged)
+                continue;
+
+            Real bias = biasEstimate();
+            if (bias <= std::sqrt(variance))
+                break;
+
+            QL_REQUIRE(stats_.size() < maxLevels_,
+                       "max number of levels (" << maxLevels_
+                       << ") reached, while bias (" << bias
+                       << ") is still above tolerance ("
+                       << std::sqrt(variance) << ")");
+            addLevel();
+            extraSamples.push_back(initialSamples_);
+        }
+
+        return mean();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Real MultilevelMcSimulation<MC,RNG,S>::valueWithSamples(
+                                    const std::vector<Size>& samples) const {
+        QL_REQUIRE(samples.size() >= stats_.size(),
+                   "number of levels given (" << samples.size()
+                   << ") less than the simulated ones ("
+                   << stats_.size() << ")");
+        QL_REQUIRE(samples.size() <= maxLevels_,
+                   "number of levels given (" << samples.size()
+                   << ") greater than max number of levels ("
+                   << maxLevels_ << ")");
+
+        while (stats_.size() < samples.size())
+            addLevel();
+
+        for (Size l=0; l<samples.size(); l++) {
+            Size sampleNumber = stats_[l].samples();
+            QL_REQUIRE(samples[l] >= sampleNumber,
+                       "number of already simulated samples ("
+                       << sampleNumber << ") greater than requested "
+                       "samples (" << samples[l] << ") on level " << l);
+            addSamples(l, samples[l]-sampleNumber);
+        }
+
+        return mean();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Real MultilevelMcSimulation<MC,RNG,S>::errorEstimate() const {
+        Real error = 0.0;
+        for (Size l=0; l<stats_.size(); l++) {
+            Real e = stats_[l].errorEstimate();
+            error += e*e;
+        }
+        return std::sqrt(error);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Real MultilevelMcSimulation<MC,RNG,S>::biasEstimate() const {
+        QL_REQUIRE(stats_.size() >= 2,
+                   "at least two levels are needed to estimate the bias");
+        // first-order weak convergence: the corrections decrease by
+        // a factor M per level and the remaining bias is their sum
+        Size last = stats_.size()-1;
+        Real correction = std::fabs(stats_[last].mean());
+        if (last > 1)
+            correction = std::max(correction,
+                                  std::fabs(stats_[last-1].mean())
+                                  / refinement_);
+        return correction/(refinement_-1);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultilevelMcSimulation<MC,RNG,S>::calculate(
+                                                 Real requiredTolerance,
+                                                 Size maxSamples) const {
+        QL_REQUIRE(requiredTolerance != Null<Real>(),
+                   "tolerance not set");
+
+        grid_ = timeGrid();
+        seedGenerator_ = MersenneTwisterUniformRng(seed_);
+        stats_.clear();
+        costs_.clear();
+        generators_.clear();
+        finePricers_.clear();
+        coarsePricers_.clear();
+
+        if (maxSamples != Null<Size>())
+            value(requiredTolerance, maxSamples);
+        else
+            value(requiredTolerance);
+    }
+
+}
+
+
+#endif
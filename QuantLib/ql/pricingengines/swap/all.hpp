@@ -3,5 +3,6 @@
 
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swap/discretizedswap.hpp>
+#include <ql/pricingengines/swap/portfoliodiscountingswapengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 
@@ -20,6 +20,7 @@
 
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/termstructures/bootstrapsensitivities.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 namespace QuantLib {
@@ -28,10 +29,12 @@ namespace QuantLib {
                             const Handle<YieldTermStructure>& discountCurve,
                             boost::optional<bool> includeSettlementDateFlows,
                             Date settlementDate,
-                            Date npvDate)
+                            Date npvDate,
+                            bool computeQuoteSensitivities)
     : discountCurve_(discountCurve),
       includeSettlementDateFlows_(includeSettlementDateFlows),
-      settlementDate_(settlementDate), npvDate_(npvDate) {
+      settlementDate_(settlementDate), npvDate_(npvDate),
+      computeQuoteSensitivities_(computeQuoteSensitivities) {
         registerWith(discountCurve_);
     }
 
@@ -109,6 +112,23 @@ namespace QuantLib {
             }
             results_.value += results_.legNPV[i];
         }
+
+        if (computeQuoteSensitivities_) {
+            const BootstrapSensitivities* curve =
+                dynamic_cast<const BootstrapSensitivities*>(
+                                        discountCurve_.currentLink().get());
+            QL_REQUIRE(curve, "discount curve does not provide "
+                              "sensitivities to its quotes");
+            std::vector<Real> nodeSensitivities;
+            for (Size i=0; i<arguments_.legs.size(); ++i)
+                addNpvSensitivities(arguments_.legs[i], arguments_.payer[i],
+                                    discountCurve_.currentLink(),
+                                    includeRefDateFlows, settlementDate,
+                                    results_.valuationDate,
+                                    nodeSensitivities);
+            results_.additionalResults["quoteSensitivities"] =
+                curve->quoteSensitivities(nodeSensitivities);
+        }
     }
 
 }
@@ -31,6 +31,13 @@
 
 namespace QuantLib {
 
+    /*! If required, the engine also returns the derivatives of the NPV
+        with respect to the quotes the discount curve was bootstrapped
+        on, as a std::vector<Real> additional result named
+        "quoteSensitivities"; see BootstrapSensitivities and
+        addNpvSensitivities().  The derivatives of Ibor coupons
+        forecast on the same curve are included as well.
+    */
     class DiscountingSwapEngine : public Swap::engine {
       public:
         DiscountingSwapEngine(
@@ -38,7 +45,8 @@ namespace QuantLib {
                                                  Handle<YieldTermStructure>(),
                boost::optional<bool> includeSettlementDateFlows = boost::none,
                Date settlementDate = Date(),
-               Date npvDate = Date());
+               Date npvDate = Date(),
+               bool computeQuoteSensitivities = false);
         void calculate() const;
         Handle<YieldTermStructure> discountCurve() const {
             return discountCurve_;
@@ -47,6 +55,7 @@ namespace QuantLib {
         Handle<YieldTermStructure> discountCurve_;
         boost::optional<bool> includeSettlementDateFlows_;
         Date settlementDate_, npvDate_;
+        bool computeQuoteSensitivities_;
     };
 
 }
@@ -0,0 +1,187 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/swap/portfoliodiscountingswapengine.hpp>
+#include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    PortfolioDiscountingSwapEngine::PortfolioDiscountingSwapEngine(
+                            const Handle<YieldTermStructure>& discountCurve,
+                            boost::optional<bool> includeSettlementDateFlows,
+                            Date settlementDate,
+                            Date npvDate)
+    : discountCurve_(discountCurve),
+      includeSettlementDateFlows_(includeSettlementDateFlows),
+      settlementDate_(settlementDate), npvDate_(npvDate) {
+        registerWith(discountCurve_);
+    }
+
+    void PortfolioDiscountingSwapEngine::update() {
+        dates_.clear();
+        discounts_.clear();
+        Swap::engine::update();
+    }
+
+    void PortfolioDiscountingSwapEngine::prefetch(
+                   const std::vector<boost::shared_ptr<Swap> >& swaps) const {
+        QL_REQUIRE(!discountCurve_.empty(),
+                   "discounting term structure handle is empty");
+
+        Date refDate = discountCurve_->referenceDate();
+        // dates beyond the curve range are left to the single swaps,
+        // so that they fail individually as with the plain engine
+        Date maxDate = discountCurve_->allowsExtrapolation() ?
+                       Date::maxDate() : discountCurve_->maxDate();
+
+        std::vector<Date> dates;
+        dates.push_back(npvDate_ == Date() ? refDate : npvDate_);
+        for (Size i=0; i<swaps.size(); ++i) {
+            for (Size j=0; j<swaps[i]->numberOfLegs(); ++j) {
+                const Leg& leg = swaps[i]->leg(j);
+                if (leg.empty())
+                    continue;
+                for (Size k=0; k<leg.size(); ++k)
+                    dates.push_back(leg[k]->date());
+                dates.push_back(CashFlows::startDate(leg));
+                dates.push_back(CashFlows::maturityDate(leg));
+            }
+        }
+
+        std::sort(dates.begin(), dates.end());
+        dates.erase(std::unique(dates.begin(), dates.end()), dates.end());
+        dates.erase(dates.begin(),
+                    std::lower_bound(dates.begin(), dates.end(), refDate));
+        dates.erase(std::upper_bound(dates.begin(), dates.end(), maxDate),
+                    dates.end());
+
+        std::vector<Time> times =
+            discountCurve_->dayCounter().yearFractions(refDate, dates);
+        std::vector<DiscountFactor> discounts(dates.size());
+        for (Size i=0; i<dates.size(); ++i)
+            discounts[i] = discountCurve_->discount(times[i]);
+
+        referenceDate_ = refDate;
+        dates_.swap(dates);
+        discounts_.swap(discounts);
+    }
+
+    DiscountFactor PortfolioDiscountingSwapEngine::discount(
+                                                    const Date& d) const {
+        std::vector<Date>::const_iterator i =
+            std::lower_bound(dates_.begin(), dates_.end(), d);
+        if (i != dates_.end() && *i == d)
+            return discounts_[i - dates_.begin()];
+        else
+            return discountCurve_->discount(d);
+    }
+
+    void PortfolioDiscountingSwapEngine::calculate() const {
+        QL_REQUIRE(!discountCurve_.empty(),
+                   "discounting term structure handle is empty");
+
+        results_.value = 0.0;
+        results_.errorEstimate = Null<Real>();
+
+        Date refDate = discountCurve_->referenceDate();
+
+        // the table is stale if the reference date moved without
+        // the curve notifying us
+        if (refDate != referenceDate_) {
+            dates_.clear();
+            discounts_.clear();
+        }
+
+        Date settlementDate = settlementDate_;
+        if (settlementDate_==Date()) {
+            settlementDate = refDate;
+        } else {
+            QL_REQUIRE(settlementDate>=refDate,
+                       "settlement date (" << settlementDate << ") before "
+                       "discount curve reference date (" << refDate << ")");
+        }
+
+        results_.valuationDate = npvDate_;
+        if (npvDate_==Date()) {
+            results_.valuationDate = refDate;
+        } else {
+            QL_REQUIRE(npvDate_>=refDate,
+                       "npv date (" << npvDate_  << ") before "
+                       "discount curve reference date (" << refDate << ")");
+        }
+        results_.npvDateDiscount = discount(results_.valuationDate);
+
+        Size n = arguments_.legs.size();
+        results_.legNPV.resize(n);
+        results_.legBPS.resize(n);
+        results_.startDiscounts.resize(n);
+        results_.endDiscounts.resize(n);
+
+        bool includeRefDateFlows =
+            includeSettlementDateFlows_ ?
+            *includeSettlementDateFlows_ :
+            Settings::instance().includeReferenceDateEvents();
+
+        static const Spread basisPoint = 1.0e-4;
+
+        for (Size i=0; i<n; ++i) {
+            try {
+                const Leg& leg = arguments_.legs[i];
+                Real npv = 0.0, bps = 0.0;
+                for (Size j=0; j<leg.size(); ++j) {
+                    const CashFlow& cf = *leg[j];
+                    if (cf.hasOccurred(settlementDate, includeRefDateFlows) ||
+                        cf.tradingExCoupon(settlementDate))
+                        continue;
+                    DiscountFactor df = discount(cf.date());
+                    npv += cf.amount() * df;
+                    if (const Coupon* cp = dynamic_cast<const Coupon*>(&cf))
+                        bps += cp->nominal() * cp->accrualPeriod() * df;
+                }
+                results_.legNPV[i] =
+                    arguments_.payer[i] * npv / results_.npvDateDiscount;
+                results_.legBPS[i] = arguments_.payer[i] *
+                    basisPoint * bps / results_.npvDateDiscount;
+
+                if (!leg.empty()) {
+                    Date d1 = CashFlows::startDate(leg);
+                    if (d1>=refDate)
+                        results_.startDiscounts[i] = discount(d1);
+                    else
+                        results_.startDiscounts[i] = Null<DiscountFactor>();
+
+                    Date d2 = CashFlows::maturityDate(leg);
+                    if (d2>=refDate)
+                        results_.endDiscounts[i] = discount(d2);
+                    else
+                        results_.endDiscounts[i] = Null<DiscountFactor>();
+                } else {
+                    results_.startDiscounts[i] = Null<DiscountFactor>();
+                    results_.endDiscounts[i] = Null<DiscountFactor>();
+                }
+
+            } catch (std::exception &e) {
+                QL_FAIL(io::ordinal(i+1) << " leg: " << e.what());
+            }
+            results_.value += results_.legNPV[i];
+        }
+    }
+
+}
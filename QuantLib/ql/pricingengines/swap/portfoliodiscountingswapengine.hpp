@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file portfoliodiscountingswapengine.hpp
+    \brief discounting swap engine for portfolios sharing a curve
+*/
+
+#ifndef quantlib_portfolio_discounting_swap_engine_hpp
+#define quantlib_portfolio_discounting_swap_engine_hpp
+
+#include <ql/instruments/swap.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/handle.hpp>
+
+namespace QuantLib {
+
+    //! Discounting engine for portfolios of swaps
+    /*! This engine gives the same results as DiscountingSwapEngine,
+        but it is meant to be shared by many swaps discounted on the
+        same curve.  Before the swaps are priced, prefetch() gathers
+        the payment dates of all of them, removes duplicates and
+        evaluates the discount curve once per unique date, with a
+        single batch calculation of the corresponding times; the
+        swaps then look up their discount factors in the resulting
+        table.  Dates that were not prefetched are discounted on the
+        curve directly.
+
+        The table is discarded whenever the discount curve notifies
+        the engine, e.g., when it is relinked or its quotes change,
+        so prefetch() should be called again before repricing the
+        portfolio.
+    */
+    class PortfolioDiscountingSwapEngine : public Swap::engine {
+      public:
+        PortfolioDiscountingSwapEngine(
+               const Handle<YieldTermStructure>& discountCurve =
+                                                 Handle<YieldTermStructure>(),
+               boost::optional<bool> includeSettlementDateFlows = boost::none,
+               Date settlementDate = Date(),
+               Date npvDate = Date());
+        void calculate() const;
+        void update();
+        Handle<YieldTermStructure> discountCurve() const {
+            return discountCurve_;
+        }
+        //! evaluates the discount factors needed by the given swaps
+        void prefetch(
+                 const std::vector<boost::shared_ptr<Swap> >& swaps) const;
+        //! number of discount factors currently stored
+        Size prefetchedDates() const { return dates_.size(); }
+      private:
+        DiscountFactor discount(const Date& d) const;
+        Handle<YieldTermStructure> discountCurve_;
+        boost::optional<bool> includeSettlementDateFlows_;
+        Date settlementDate_, npvDate_;
+        mutable Date referenceDate_;
+        mutable std::vector<Date> dates_;
+        mutable std::vector<DiscountFactor> discounts_;
+    };
+
+}
+
+#endif
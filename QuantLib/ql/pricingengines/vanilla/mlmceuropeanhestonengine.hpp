@@ -0,0 +1,135 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file mlmceuropeanhestonengine.hpp
+    \brief Multilevel Monte Carlo Heston-model engine for European options
+*/
+
+#ifndef quantlib_mlmc_european_heston_engine_hpp
+#define quantlib_mlmc_european_heston_engine_hpp
+
+#include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo Heston-model engine for European options
+    /*! The option is priced by evolving the process on a grid with
+        the given number of steps, refined by the given factor on
+        each further level; levels and samples are added until the
+        required root-mean-square error is reached.  See
+        MultilevelMcSimulation for details.
+
+        \ingroup vanillaengines
+
+        \test the returned value is checked against the analytic
+              Heston engine.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCEuropeanHestonEngine
+        : public VanillaOption::engine,
+          public MultilevelMcSimulation<MultiVariate,RNG,S> {
+      public:
+        typedef typename MultilevelMcSimulation<MultiVariate,RNG,S>
+            ::path_pricer_type path_pricer_type;
+        MLMCEuropeanHestonEngine(
+                    const boost::shared_ptr<HestonProcess>& process,
+                    Size timeSteps,
+                    Real requiredTolerance,
+                    Size maxSamples = Null<Size>(),
+                    BigNatural seed = 0,
+                    Size refinement = 4,
+                    Size minLevels = 3,
+                    Size maxLevels = 8,
+                    Size initialSamples = 1000);
+        void calculate() const {
+            MultilevelMcSimulation<MultiVariate,RNG,S>::calculate(
+                                            requiredTolerance_, maxSamples_);
+            results_.value = this->mean();
+            results_.errorEstimate = this->errorEstimate();
+            results_.additionalResults["levels"] = this->levels();
+            results_.additionalResults["biasEstimate"] =
+                this->biasEstimate();
+        }
+      protected:
+        // MultilevelMcSimulation implementation
+        boost::shared_ptr<StochasticProcess> process() const {
+            return process_;
+        }
+        TimeGrid timeGrid() const;
+        boost::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const;
+        // data members
+        boost::shared_ptr<HestonProcess> process_;
+        Size timeSteps_, maxSamples_;
+        Real requiredTolerance_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S>
+    inline MLMCEuropeanHestonEngine<RNG,S>::MLMCEuropeanHestonEngine(
+                    const boost::shared_ptr<HestonProcess>& process,
+                    Size timeSteps,
+                    Real requiredTolerance,
+                    Size maxSamples,
+                    BigNatural seed,
+                    Size refinement,
+                    Size minLevels,
+                    Size maxLevels,
+                    Size initialSamples)
+    : MultilevelMcSimulation<MultiVariate,RNG,S>(refinement, minLevels,
+                                                 maxLevels, initialSamples,
+                                                 seed),
+      process_(process), timeSteps_(timeSteps), maxSamples_(maxSamples),
+      requiredTolerance_(requiredTolerance) {
+        QL_REQUIRE(timeSteps > 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCEuropeanHestonEngine<RNG,S>::timeGrid() const {
+        Time residualTime = process_->time(arguments_.exercise->lastDate());
+        return TimeGrid(residualTime, timeSteps_);
+    }
+
+    template <class RNG, class S>
+    inline boost::shared_ptr<
+        typename MLMCEuropeanHestonEngine<RNG,S>::path_pricer_type>
+    MLMCEuropeanHestonEngine<RNG,S>::pathPricer(const TimeGrid& grid) const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff(
+                  boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                    arguments_.payoff));
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return boost::shared_ptr<path_pricer_type>(
+                   new EuropeanHestonPathPricer(
+                                  payoff->optionType(),
+                                  payoff->strike(),
+                                  process_->riskFreeRate()->discount(
+                                                               grid.back())));
+    }
+
+}
+
+
+#endif
@@ -128,4 +128,8 @@ namespace QuantLib {
         return sqrtCorrelation_ * transpose(sqrtCorrelation_);
     }
 
+    const Matrix& StochasticProcessArray::sqrtCorrelation() const {
+        return sqrtCorrelation_;
+    }
+
 }
@@ -56,6 +56,8 @@ namespace QuantLib {
         // inspectors
         const boost::shared_ptr<StochasticProcess1D>& process(Size i) const;
         Disposable<Matrix> correlation() const;
+        //! pseudo square root of the correlation applied by evolve()
+        const Matrix& sqrtCorrelation() const;
       protected:
         std::vector<boost::shared_ptr<StochasticProcess1D> > processes_;
         Matrix sqrtCorrelation_;
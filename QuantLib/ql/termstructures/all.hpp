@@ -3,6 +3,7 @@
 
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/termstructures/bootstrapsensitivities.hpp>
 #include <ql/termstructures/defaulttermstructure.hpp>
 #include <ql/termstructures/inflationtermstructure.hpp>
 #include <ql/termstructures/interpolatedcurve.hpp>
@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/bootstrapsensitivities.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/indexes/swapindex.hpp>
+#include <ql/settings.hpp>
+
+using boost::shared_ptr;
+using boost::dynamic_pointer_cast;
+
+namespace QuantLib {
+
+    namespace {
+
+        // whether the coupon rate is forecast, as in IborCoupon
+        bool isForecast(const FloatingRateCoupon& coupon) {
+            Date today = Settings::instance().evaluationDate();
+            Date fixingDate = coupon.fixingDate();
+            if (fixingDate > today)
+                return true;
+            if (fixingDate < today ||
+                Settings::instance().enforcesTodaysHistoricFixings())
+                return false;
+            try {
+                return coupon.index()->pastFixing(fixingDate) == Null<Real>();
+            } catch (Error&) {
+                return true;
+            }
+        }
+
+        // whether the coupon rate is forecast on the given curve
+        bool isForecastOn(const FloatingRateCoupon& coupon,
+                          const YieldTermStructure* curve) {
+            shared_ptr<InterestRateIndex> index = coupon.index();
+            if (shared_ptr<IborIndex> ibor =
+                                  dynamic_pointer_cast<IborIndex>(index))
+                return ibor->forwardingTermStructure().currentLink().get()
+                    == curve;
+            if (shared_ptr<SwapIndex> swap =
+                                  dynamic_pointer_cast<SwapIndex>(index))
+                return swap->forwardingTermStructure().currentLink().get()
+                    == curve ||
+                    swap->discountingTermStructure().currentLink().get()
+                    == curve;
+            return false;
+        }
+
+    }
+
+    void addNpvSensitivities(const Leg& leg,
+                             Real weight,
+                             const shared_ptr<YieldTermStructure>& curve,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate,
+                             std::vector<Real>& nodeSensitivities) {
+        const BootstrapSensitivities* sensitivities =
+            dynamic_cast<const BootstrapSensitivities*>(curve.get());
+        QL_REQUIRE(sensitivities, "discount curve does not provide "
+                                  "sensitivities to its quotes");
+
+        if (leg.empty())
+            return;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        // NPV = sum(a_i D(t_i)) / D(npvDate); the derivatives of each
+        // amount and discount factor are weighted accordingly
+        DiscountFactor npvDiscount = curve->discount(npvDate);
+        Real totalNPV = 0.0;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (leg[i]->hasOccurred(settlementDate,
+                                    includeSettlementDateFlows) ||
+                leg[i]->tradingExCoupon(settlementDate))
+                continue;
+
+            Real amount = leg[i]->amount();
+            DiscountFactor discount = curve->discount(leg[i]->date());
+            totalNPV += amount * discount;
+            sensitivities->addDiscountSensitivities(
+                leg[i]->date(), weight*amount/npvDiscount, nodeSensitivities);
+
+            shared_ptr<FloatingRateCoupon> floating =
+                dynamic_pointer_cast<FloatingRateCoupon>(leg[i]);
+            if (!floating || !isForecastOn(*floating, curve.get()) ||
+                !isForecast(*floating))
+                continue;
+
+            // amount = N T (g F + s), with the forecast fixing
+            // F = (D(d1)/D(d2) - 1)/tau
+            shared_ptr<IborCoupon> coupon =
+                dynamic_pointer_cast<IborCoupon>(floating);
+            QL_REQUIRE(coupon && !coupon->isInArrears() &&
+                       dynamic_pointer_cast<BlackIborCouponPricer>(
+                                                        coupon->pricer()),
+                       "only Ibor coupons not paid in arrears and "
+                       "priced without adjustments are supported");
+            Real fixingWeight = weight * discount/npvDiscount *
+                coupon->nominal() * coupon->accrualPeriod() *
+                coupon->gearing() / coupon->spanningTime();
+            DiscountFactor startDiscount =
+                curve->discount(coupon->fixingValueDate());
+            DiscountFactor endDiscount =
+                curve->discount(coupon->fixingEndDate());
+            sensitivities->addDiscountSensitivities(
+                coupon->fixingValueDate(), fixingWeight/endDiscount,
+                nodeSensitivities);
+            sensitivities->addDiscountSensitivities(
+                coupon->fixingEndDate(),
+                -fixingWeight*startDiscount/(endDiscount*endDiscount),
+                nodeSensitivities);
+        }
+
+        sensitivities->addDiscountSensitivities(
+            npvDate, -weight*totalNPV/(npvDiscount*npvDiscount),
+            nodeSensitivities);
+    }
+
+}
@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file bootstrapsensitivities.hpp
+    \brief interface for curves mapping sensitivities onto their quotes
+*/
+
+#ifndef quantlib_bootstrap_sensitivities_hpp
+#define quantlib_bootstrap_sensitivities_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/quote.hpp>
+#include <ql/handle.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class YieldTermStructure;
+
+    //! Bootstrapped curves returning sensitivities to their input quotes
+    /*! A bootstrapped curve is determined by the condition that each
+        of its helpers reprices its quote exactly.  Given a function
+        of the curve (e.g., the NPV of an instrument priced on it),
+        its derivatives with respect to the quotes follow from its
+        derivatives with respect to the curve nodes by solving the
+        transposed system of the bootstrap conditions.
+
+        The derivatives with respect to the nodes are accumulated in
+        reverse mode: the function adds the derivatives of each
+        discount factor it reads, weighted by the derivative of the
+        function with respect to that discount factor, and the
+        result is mapped onto the quotes in a single step.  The
+        curve is never modified in the process.
+    */
+    class BootstrapSensitivities {
+      public:
+        virtual ~BootstrapSensitivities() {}
+        //! quotes of the bootstrap helpers, in the order used below
+        virtual std::vector<Handle<Quote> > bootstrapQuotes() const = 0;
+        /*! adds the derivatives of the discount factor at the given
+            date with respect to the curve nodes, multiplied by the
+            given weight, to the passed node sensitivities; an empty
+            vector is resized as needed.
+        */
+        virtual void addDiscountSensitivities(
+                                 const Date& d,
+                                 Real weight,
+                                 std::vector<Real>& nodeSensitivities) const = 0;
+        /*! returns the derivatives with respect to the quotes
+            returned by bootstrapQuotes() of a function whose
+            derivatives with respect to the curve nodes are given.
+        */
+        virtual std::vector<Real> quoteSensitivities(
+                      const std::vector<Real>& nodeSensitivities) const = 0;
+    };
+
+    //! adds the derivatives of the NPV of a leg to the node sensitivities
+    /*! The NPV is calculated as in CashFlows::npv() and multiplied by
+        the given weight.  The amounts of Ibor coupons forecast on the
+        same curve are differentiated as well; other floating coupons
+        depending on it are not supported.
+
+        \pre the curve must implement BootstrapSensitivities.
+    */
+    void addNpvSensitivities(const Leg& leg,
+                             Real weight,
+                             const boost::shared_ptr<YieldTermStructure>&
+                                                                    curve,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate,
+                             std::vector<Real>& nodeSensitivities);
+
+}
+
+#endif
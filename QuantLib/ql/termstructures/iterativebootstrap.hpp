@@ -99,23 +99,21 @@ namespace QuantLib {
         std::vector<Date>& dates = ts_->dates_;
         std::vector<Time>& times = ts_->times_;
         dates.resize(alive_+1);
-        times.resize(alive_+1);
         errors_.resize(alive_+1);
         dates[0] = firstDate;
-        times[0] = ts_->timeFromReference(dates[0]);
         // pillar counter: i
         // helper counter: j
         for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
             const boost::shared_ptr<typename Traits::helper>& helper =
                                                         ts_->instruments_[j];
             dates[i] = helper->latestDate();
-            times[i] = ts_->timeFromReference(dates[i]);
             // check for duplicated maturity
             QL_REQUIRE(dates[i-1]!=dates[i],
                        "more than one instrument with maturity " << dates[i]);
             errors_[i] = boost::shared_ptr<BootstrapError<Curve> >(new
                 BootstrapError<Curve>(ts_, helper, i));
         }
+        times = ts_->dayCounter().yearFractions(ts_->referenceDate(), dates);
 
         // set initial guess only if the current curve cannot be used as guess
         if (!validCurve_ || ts_->data_.size()!=alive_+1) {
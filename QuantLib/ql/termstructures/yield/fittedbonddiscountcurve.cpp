@@ -25,6 +25,7 @@
 #include <ql/math/optimization/constraint.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/null.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
 
 using boost::shared_ptr;
@@ -39,9 +40,20 @@ namespace QuantLib {
         FittingCost(FittedBondDiscountCurve::FittingMethod* fittingMethod);
         Real value(const Array& x) const;
         Disposable<Array> values(const Array& x) const;
+        void gradient(Array& grad, const Array& x) const;
+        Real valueAndGradient(Array& grad, const Array& x) const;
       private:
+        Real modelPrice(const Array& x, Size i) const;
         FittedBondDiscountCurve::FittingMethod* fittingMethod_;
-        mutable vector<Size> firstCashFlow_;
+        // cash flows still to be paid, stored contiguously; the
+        // flows of the i-th bond are in [firstCashFlow_[i],
+        // firstCashFlow_[i+1])
+        vector<Size> firstCashFlow_;
+        vector<Time> cashFlowTimes_;
+        vector<Real> cashFlowAmounts_;
+        // Null<Time>() for bonds settling at the reference date
+        vector<Time> settlementTimes_;
+        vector<Real> accruedAmounts_, marketPrices_;
     };
 
 
@@ -54,12 +66,16 @@ namespace QuantLib {
                  Real accuracy,
                  Size maxEvaluations,
                  const Array& guess,
-                 Real simplexLambda)
+                 Real simplexLambda,
+                 const vector<Array>& additionalGuesses,
+                 const shared_ptr<OptimizationMethod>& optimizationMethod)
     : YieldTermStructure(settlementDays, calendar, dayCounter),
       accuracy_(accuracy),
       maxEvaluations_(maxEvaluations),
       simplexLambda_(simplexLambda),
       guessSolution_(guess),
+      additionalGuesses_(additionalGuesses),
+      optimizationMethod_(optimizationMethod),
       bondHelpers_(bondHelpers),
       fittingMethod_(fittingMethod) {
 
@@ -76,12 +92,16 @@ namespace QuantLib {
                  Real accuracy,
                  Size maxEvaluations,
                  const Array& guess,
-                 Real simplexLambda)
+                 Real simplexLambda,
+                 const vector<Array>& additionalGuesses,
+                 const shared_ptr<OptimizationMethod>& optimizationMethod)
     : YieldTermStructure(referenceDate, Calendar(), dayCounter),
       accuracy_(accuracy),
       maxEvaluations_(maxEvaluations),
       simplexLambda_(simplexLambda),
       guessSolution_(guess),
+      additionalGuesses_(additionalGuesses),
+      optimizationMethod_(optimizationMethod),
       bondHelpers_(bondHelpers),
       fittingMethod_(fittingMethod) {
 
@@ -186,9 +206,19 @@ namespace QuantLib {
         Compounding yieldComp = Compounded;
         Frequency yieldFreq = Annual;
 
+        Date refDate = curve_->referenceDate();
+        const DayCounter& dc = curve_->dayCounter();
+
         Size n = curve_->bondHelpers_.size();
         costFunction_ = shared_ptr<FittingCost>(new FittingCost(this));
-        costFunction_->firstCashFlow_.resize(n);
+        FittingCost& cost = *costFunction_;
+        cost.firstCashFlow_.resize(n+1);
+        cost.settlementTimes_.resize(n);
+        cost.accruedAmounts_.resize(n);
+        cost.marketPrices_.resize(n);
+        // pay dates are collected first so that times are
+        // calculated in a single call to the day counter
+        vector<Date> payDates;
         weights_ = Array(n);
         Real squaredSum = 0.0;
         for (Size i=0; i<curve_->bondHelpers_.size(); ++i) {
@@ -209,14 +239,26 @@ namespace QuantLib {
             weights_[i] = 1.0/dur;
             squaredSum += weights_[i]*weights_[i];
 
+            // the data used in the cost function don't depend on
+            // the fitting coefficients and can be calculated here
+            cost.firstCashFlow_[i] = payDates.size();
             const Leg& cf = bond->cashflows();
             for (Size k=0; k<cf.size(); ++k) {
                 if (!cf[k]->hasOccurred(bondSettlement, false)) {
-                    costFunction_->firstCashFlow_[i] = k;
-                    break;
+                    payDates.push_back(cf[k]->date());
+                    cost.cashFlowAmounts_.push_back(cf[k]->amount());
                 }
             }
+            cost.accruedAmounts_[i] = bond->accruedAmount(bondSettlement);
+            cost.marketPrices_[i] = cleanPrice;
+            // adjust price (NPV) for forward settlement
+            cost.settlementTimes_[i] =
+                bondSettlement != refDate ?
+                dc.yearFraction(refDate, bondSettlement) :
+                Null<Time>();
         }
+        cost.firstCashFlow_[n] = payDates.size();
+        cost.cashFlowTimes_ = dc.yearFractions(refDate, payDates);
         weights_ /= std::sqrt(squaredSum);
 
     }
@@ -232,9 +274,14 @@ namespace QuantLib {
         if (!curve_->guessSolution_.empty()) {
             x = curve_->guessSolution_;
         }
-
-        Simplex simplex(curve_->simplexLambda_);
-        Problem problem(costFunction, constraint, x);
+        vector<Array> guesses(1, x);
+        for (Size i=0; i<curve_->additionalGuesses_.size(); ++i) {
+            QL_REQUIRE(curve_->additionalGuesses_[i].size() == size(),
+                       io::ordinal(i+1) << " additional guess has size "
+                       << curve_->additionalGuesses_[i].size()
+                       << " instead of " << size());
+            guesses.push_back(curve_->additionalGuesses_[i]);
+        }
 
         Natural maxStationaryStateIterations = 100;
         Real rootEpsilon = curve_->accuracy_;
@@ -247,55 +294,139 @@ namespace QuantLib {
                                 functionEpsilon,
                                 gradientNormEpsilon);
 
-        simplex.minimize(problem,endCriteria);
-        solution_ = problem.currentValue();
+        vector<Array> solutions(guesses.size());
+        vector<Real> costValues(guesses.size());
+        vector<Integer> evaluations(guesses.size());
+        vector<std::string> errors(guesses.size());
+
+        // the cost function only reads data precalculated in init(),
+        // so that the optimizations can run concurrently as long as
+        // each of them uses its own optimization method
+        bool parallel = !curve_->optimizationMethod_;
+
+        #pragma omp parallel for if(parallel && guesses.size() > 1)
+        for (Size i=0; i<guesses.size(); ++i) {
+            // exceptions must not escape the parallel region
+            try {
+                shared_ptr<OptimizationMethod> method =
+                    curve_->optimizationMethod_ ?
+                    curve_->optimizationMethod_ :
+                    shared_ptr<OptimizationMethod>(
+                                       new Simplex(curve_->simplexLambda_));
+                Problem problem(costFunction, constraint, guesses[i]);
+                method->minimize(problem, endCriteria);
+                solutions[i] = problem.currentValue();
+                costValues[i] = problem.functionValue();
+                evaluations[i] = problem.functionEvaluation();
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
 
-        numberOfIterations_ = problem.functionEvaluation();
-        costValue_ = problem.functionValue();
+        for (Size i=0; i<guesses.size(); ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "optimization from " << io::ordinal(i+1)
+                       << " starting point failed: " << errors[i]);
+
+        // keep the best solution; all evaluations are counted
+        Size best = 0;
+        numberOfIterations_ = 0;
+        for (Size i=0; i<guesses.size(); ++i) {
+            if (costValues[i] < costValues[best])
+                best = i;
+            numberOfIterations_ += evaluations[i];
+        }
+        solution_ = solutions[best];
+        costValue_ = costValues[best];
 
         // save the results as the guess solution, in case of recalculation
         curve_->guessSolution_ = solution_;
     }
 
 
+    Disposable<Array>
+    FittedBondDiscountCurve::FittingMethod::discountFunctionGradient(
+                                                const Array& x, Time t) const {
+        Array grad(x.size()), y = x;
+        for (Size j=0; j<x.size(); ++j) {
+            Real h = 1.0e-6 * std::max(1.0, std::fabs(x[j]));
+            y[j] = x[j] + h;
+            DiscountFactor up = discountFunction(y, t);
+            y[j] = x[j] - h;
+            DiscountFactor down = discountFunction(y, t);
+            y[j] = x[j];
+            grad[j] = (up - down) / (2.0*h);
+        }
+        return grad;
+    }
+
+
     FittedBondDiscountCurve::FittingMethod::FittingCost::FittingCost(
                         FittedBondDiscountCurve::FittingMethod* fittingMethod)
     : fittingMethod_(fittingMethod) {}
 
 
-    Real FittedBondDiscountCurve::FittingMethod::FittingCost::value(
-                                                       const Array& x) const {
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::modelPrice(
+                                               const Array& x, Size i) const {
+        // CleanPrice_i = sum( cf_k * d(t_k) ) - accruedAmount
+        Real price = - accruedAmounts_[i];
+        for (Size k=firstCashFlow_[i]; k<firstCashFlow_[i+1]; ++k)
+            price += cashFlowAmounts_[k] *
+                fittingMethod_->discountFunction(x, cashFlowTimes_[k]);
 
-        Date refDate  = fittingMethod_->curve_->referenceDate();
-        const DayCounter& dc = fittingMethod_->curve_->dayCounter();
+        // adjust price (NPV) for forward settlement
+        if (settlementTimes_[i] != Null<Time>())
+            price /= fittingMethod_->discountFunction(x, settlementTimes_[i]);
+        return price;
+    }
 
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::value(
+                                                       const Array& x) const {
         Real squaredError = 0.0;
-        Size n = fittingMethod_->curve_->bondHelpers_.size();
+        Size n = marketPrices_.size();
         for (Size i=0; i<n; ++i) {
+            Real error = modelPrice(x, i) - marketPrices_[i];
+            Real weightedError = fittingMethod_->weights_[i] * error;
+            squaredError += weightedError * weightedError;
+        }
+        return squaredError;
+    }
 
-            shared_ptr<Bond> bond =
-                            fittingMethod_->curve_->bondHelpers_[i]->bond();
-            Date bondSettlement = bond->settlementDate();
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::gradient(
+                                         Array& grad, const Array& x) const {
+        valueAndGradient(grad, x);
+    }
 
-            // CleanPrice_i = sum( cf_k * d(t_k) ) - accruedAmount
-            Real modelPrice = - bond->accruedAmount(bondSettlement);
-            const Leg& cf = bond->cashflows();
-            for (Size k=firstCashFlow_[i]; k<cf.size(); ++k) {
-                Time tenor = dc.yearFraction(refDate, cf[k]->date());
-                modelPrice += cf[k]->amount() *
-                                    fittingMethod_->discountFunction(x, tenor);
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::valueAndGradient(
+                                         Array& grad, const Array& x) const {
+        grad = Array(x.size(), 0.0);
+        Real squaredError = 0.0;
+        Size n = marketPrices_.size();
+        for (Size i=0; i<n; ++i) {
+            Real price = - accruedAmounts_[i];
+            Array dPrice(x.size(), 0.0);
+            for (Size k=firstCashFlow_[i]; k<firstCashFlow_[i+1]; ++k) {
+                Time t = cashFlowTimes_[k];
+                price += cashFlowAmounts_[k] *
+                    fittingMethod_->discountFunction(x, t);
+                dPrice += cashFlowAmounts_[k] *
+                    fittingMethod_->discountFunctionGradient(x, t);
             }
-
-            // adjust price (NPV) for forward settlement
-            if (bondSettlement != refDate ) {
-                Time tenor = dc.yearFraction(refDate, bondSettlement);
-                modelPrice /= fittingMethod_->discountFunction(x, tenor);
+            if (settlementTimes_[i] != Null<Time>()) {
+                Time t = settlementTimes_[i];
+                DiscountFactor d = fittingMethod_->discountFunction(x, t);
+                price /= d;
+                // d(P/d) = (dP - (P/d) dd)/d
+                dPrice -= price *
+                    fittingMethod_->discountFunctionGradient(x, t);
+                dPrice /= d;
             }
-            Real marketPrice =
-                fittingMethod_->curve_->bondHelpers_[i]->quote()->value();
-            Real error = modelPrice - marketPrice;
-            Real weightedError = fittingMethod_->weights_[i] * error;
+            Real weight = fittingMethod_->weights_[i];
+            Real weightedError = weight * (price - marketPrices_[i]);
             squaredError += weightedError * weightedError;
+            grad += (2.0 * weightedError * weight) * dPrice;
         }
         return squaredError;
     }
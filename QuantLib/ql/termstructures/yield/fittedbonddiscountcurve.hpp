@@ -28,6 +28,7 @@
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/math/array.hpp>
+#include <ql/math/optimization/method.hpp>
 #include <ql/utilities/clone.hpp>
 
 namespace QuantLib {
@@ -51,6 +52,13 @@ namespace QuantLib {
         compares various bond discount curve fitting methodologies
         \endlink
 
+        Additional starting points can be passed to the
+        constructors; a local optimization is run from each of them
+        (in parallel if OpenMP is enabled and the default Simplex
+        method is used) and the solution with the lowest cost is
+        kept.  This reduces the risk of ending in a bad local
+        minimum.
+
         \warning The method can be slow if there are many bonds to
                  fit. Speed also depends on the particular choice of
                  fitting method chosen and its convergence properties
@@ -98,7 +106,12 @@ namespace QuantLib {
                  Real accuracy = 1.0e-10,
                  Size maxEvaluations = 10000,
                  const Array& guess = Array(),
-                 Real simplexLambda = 1.0);
+                 Real simplexLambda = 1.0,
+                 const std::vector<Array>& additionalGuesses =
+                                                      std::vector<Array>(),
+                 const boost::shared_ptr<OptimizationMethod>&
+                     optimizationMethod =
+                                  boost::shared_ptr<OptimizationMethod>());
         //! curve reference date fixed for life of curve
         FittedBondDiscountCurve(
                  const Date &referenceDate,
@@ -108,7 +121,12 @@ namespace QuantLib {
                  Real accuracy = 1.0e-10,
                  Size maxEvaluations = 10000,
                  const Array &guess = Array(),
-                 Real simplexLambda = 1.0);
+                 Real simplexLambda = 1.0,
+                 const std::vector<Array>& additionalGuesses =
+                                                      std::vector<Array>(),
+                 const boost::shared_ptr<OptimizationMethod>&
+                     optimizationMethod =
+                                  boost::shared_ptr<OptimizationMethod>());
         //! reference date based on current evaluation date
         /*! \deprecated */
         QL_DEPRECATED
@@ -163,6 +181,10 @@ namespace QuantLib {
         Real simplexLambda_;
         // a guess solution may be passed into the constructor to speed calcs
         Array guessSolution_;
+        // further starting points for the optimization
+        std::vector<Array> additionalGuesses_;
+        // if null, a Simplex is used
+        boost::shared_ptr<OptimizationMethod> optimizationMethod_;
         mutable Date maxDate_;
         std::vector<boost::shared_ptr<BondHelper> > bondHelpers_;
         Clone<FittingMethod> fittingMethod_;
@@ -210,6 +232,10 @@ namespace QuantLib {
         Integer numberOfIterations() const;
         //! final value of cost function after optimization
         Real minimumCostValue() const;
+        //! discount function for the given coefficients
+        DiscountFactor discount(const Array& x, Time t) const;
+        //! its derivatives w.r.t. the coefficients
+        Disposable<Array> discountGradient(const Array& x, Time t) const;
         //! clone of the current object
         virtual std::unique_ptr<FittingMethod> clone() const = 0;
       protected:
@@ -223,6 +249,15 @@ namespace QuantLib {
         */
         virtual DiscountFactor discountFunction(const Array& x,
                                                 Time t) const = 0;
+        //! derivatives of the discount function w.r.t. the coefficients
+        /*! The default implementation uses central finite
+            differences; derived classes should override it with the
+            analytic derivatives if available.  It is used by the
+            cost function to provide its gradient to gradient-based
+            optimization methods.
+        */
+        virtual Disposable<Array> discountFunctionGradient(const Array& x,
+                                                           Time t) const;
 
         //! constrains discount function to unity at \f$ T=0 \f$, if true
         bool constrainAtZero_;
@@ -295,6 +330,18 @@ namespace QuantLib {
         return solution_;
     }
 
+    inline DiscountFactor
+    FittedBondDiscountCurve::FittingMethod::discount(const Array& x,
+                                                     Time t) const {
+        return discountFunction(x, t);
+    }
+
+    inline Disposable<Array>
+    FittedBondDiscountCurve::FittingMethod::discountGradient(const Array& x,
+                                                             Time t) const {
+        return discountFunctionGradient(x, t);
+    }
+
 }
 
 #endif
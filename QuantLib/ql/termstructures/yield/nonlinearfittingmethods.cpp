@@ -87,6 +87,26 @@ namespace QuantLib {
         return d;
     }
 
+    Disposable<Array> NelsonSiegelFitting::discountFunctionGradient(
+                                               const Array& x, Time t) const {
+        Real kappa = x[size()-1];
+        Real e = std::exp(-kappa*t);
+        Real den = (kappa+QL_EPSILON)*(t+QL_EPSILON);
+        Real a = (1.0 - e)/den;
+        Real zeroRate = x[0] + (x[1] + x[2])*a - x[2]*e;
+        DiscountFactor d = std::exp(-zeroRate * t);
+
+        // derivatives of the zero rate
+        Real dadk = t*e/den - a/(kappa+QL_EPSILON);
+        Array grad(size());
+        grad[0] = 1.0;
+        grad[1] = a;
+        grad[2] = a - e;
+        grad[3] = (x[1] + x[2])*dadk + x[2]*t*e;
+        grad *= -t*d;
+        return grad;
+    }
+
 
     SvenssonFitting::SvenssonFitting()
     : FittedBondDiscountCurve::FittingMethod(true) {}
@@ -115,6 +135,31 @@ namespace QuantLib {
         return d;
     }
 
+    Disposable<Array> SvenssonFitting::discountFunctionGradient(
+                                               const Array& x, Time t) const {
+        Real kappa = x[size()-2];
+        Real kappa_1 = x[size()-1];
+        Real e = std::exp(-kappa*t), e_1 = std::exp(-kappa_1*t);
+        Real den = (kappa+QL_EPSILON)*(t+QL_EPSILON),
+             den_1 = (kappa_1+QL_EPSILON)*(t+QL_EPSILON);
+        Real a = (1.0 - e)/den, a_1 = (1.0 - e_1)/den_1;
+        Real zeroRate = x[0] + (x[1] + x[2])*a - x[2]*e + x[3]*(a_1 - e_1);
+        DiscountFactor d = std::exp(-zeroRate * t);
+
+        // derivatives of the zero rate
+        Real dadk = t*e/den - a/(kappa+QL_EPSILON);
+        Real da_1dk_1 = t*e_1/den_1 - a_1/(kappa_1+QL_EPSILON);
+        Array grad(size());
+        grad[0] = 1.0;
+        grad[1] = a;
+        grad[2] = a - e;
+        grad[3] = a_1 - e_1;
+        grad[4] = (x[1] + x[2])*dadk + x[2]*t*e;
+        grad[5] = x[3]*(da_1dk_1 + t*e_1);
+        grad *= -t*d;
+        return grad;
+    }
+
 
 
     CubicBSplinesFitting::CubicBSplinesFitting(const std::vector<Time>& knots,
@@ -183,6 +228,24 @@ namespace QuantLib {
         return d;
     }
 
+    Disposable<Array> CubicBSplinesFitting::discountFunctionGradient(
+                                               const Array&, Time t) const {
+        // the discount function is linear in the coefficients
+        Array grad(size_);
+        if (!constrainAtZero_) {
+            for (Size i=0; i<size_; ++i)
+                grad[i] = splines_(i,t);
+        } else {
+            const Real T = 0.0;
+            Real ratio = splines_(N_,t)/splines_(N_,T);
+            for (Size i=0; i<size_; ++i) {
+                Size j = (i < N_ ? i : i+1);
+                grad[i] = splines_(j,t) - splines_(j,T)*ratio;
+            }
+        }
+        return grad;
+    }
+
 
     SimplePolynomialFitting::SimplePolynomialFitting(Natural degree,
                                                      bool constrainAtZero)
@@ -71,6 +71,8 @@ namespace QuantLib {
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        Disposable<Array> discountFunctionGradient(const Array& x,
+                                                   Time t) const;
     };
 
 
@@ -94,6 +96,8 @@ namespace QuantLib {
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        Disposable<Array> discountFunctionGradient(const Array& x,
+                                                   Time t) const;
     };
 
 
@@ -127,6 +131,8 @@ namespace QuantLib {
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        Disposable<Array> discountFunctionGradient(const Array& x,
+                                                   Time t) const;
         BSpline splines_;
         Size size_;
         //! N_th basis function coefficient to solve for when d(0)=1
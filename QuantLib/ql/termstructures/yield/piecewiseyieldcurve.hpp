@@ -28,11 +28,61 @@
 
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
+#include <ql/termstructures/bootstrapsensitivities.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/math/interpolations/backwardflatinterpolation.hpp>
+#include <ql/math/interpolations/forwardflatinterpolation.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // how an interpolation depends on its nodes.  Sensitivities
+        // are only available for those depending linearly on the
+        // nodes (or on their logarithms) through the given
+        // interpolator, whose results on unit vectors are the
+        // derivatives with respect to each node.
+        template <class Interpolator>
+        struct NodeDependence {
+            static const bool available = false;
+            static const bool logarithmic = false;
+            typedef Linear interpolator;
+        };
+
+        template <>
+        struct NodeDependence<Linear> {
+            static const bool available = true;
+            static const bool logarithmic = false;
+            typedef Linear interpolator;
+        };
+
+        template <>
+        struct NodeDependence<LogLinear> {
+            static const bool available = true;
+            static const bool logarithmic = true;
+            typedef Linear interpolator;
+        };
+
+        template <>
+        struct NodeDependence<BackwardFlat> {
+            static const bool available = true;
+            static const bool logarithmic = false;
+            typedef BackwardFlat interpolator;
+        };
+
+        template <>
+        struct NodeDependence<ForwardFlat> {
+            static const bool available = true;
+            static const bool logarithmic = false;
+            typedef ForwardFlat interpolator;
+        };
+
+    }
+
     //! Piecewise yield term structure
     /*! This term structure is bootstrapped on a number of interest
         rate instruments which are passed as a vector of handles to
@@ -53,12 +103,15 @@ namespace QuantLib {
         - the correctness of the returned values is tested by
           checking them against the original inputs.
         - the observability of the term structure is tested.
+        - the sensitivities to the helper quotes are checked against
+          the results of bumping the quotes and bootstrapping again
+          for several combinations of traits and interpolations.
     */
     template <class Traits, class Interpolator,
               template <class> class Bootstrap = IterativeBootstrap>
     class PiecewiseYieldCurve
         : public Traits::template curve<Interpolator>::type,
-          public LazyObject {
+          public LazyObject, public BootstrapSensitivities {
       private:
         typedef typename Traits::template curve<Interpolator>::type base_curve;
         typedef PiecewiseYieldCurve<Traits,Interpolator,Bootstrap> this_curve;
@@ -80,7 +133,8 @@ namespace QuantLib {
                const Bootstrap<this_curve>& bootstrap = Bootstrap<this_curve>())
         : base_curve(referenceDate, dayCounter, jumps, jumpDates, i),
           instruments_(instruments),
-          accuracy_(accuracy), bootstrap_(bootstrap) {
+          accuracy_(accuracy), sensitivitiesEnabled_(false),
+          bootstrap_(bootstrap) {
             bootstrap_.setup(this);
         }
         PiecewiseYieldCurve(
@@ -94,7 +148,8 @@ namespace QuantLib {
         : base_curve(referenceDate, dayCounter,
                      std::vector<Handle<Quote> >(), std::vector<Date>(), i),
           instruments_(instruments),
-          accuracy_(accuracy), bootstrap_(bootstrap) {
+          accuracy_(accuracy), sensitivitiesEnabled_(false),
+          bootstrap_(bootstrap) {
             bootstrap_.setup(this);
         }
         PiecewiseYieldCurve(
@@ -107,7 +162,8 @@ namespace QuantLib {
         : base_curve(referenceDate, dayCounter,
                      std::vector<Handle<Quote> >(), std::vector<Date>(), i),
           instruments_(instruments),
-          accuracy_(1.0e-12), bootstrap_(bootstrap) {
+          accuracy_(1.0e-12), sensitivitiesEnabled_(false),
+          bootstrap_(bootstrap) {
             bootstrap_.setup(this);
         }
         PiecewiseYieldCurve(
@@ -123,7 +179,8 @@ namespace QuantLib {
                const Bootstrap<this_curve>& bootstrap = Bootstrap<this_curve>())
         : base_curve(settlementDays, calendar, dayCounter, jumps, jumpDates, i),
           instruments_(instruments),
-          accuracy_(accuracy), bootstrap_(bootstrap) {
+          accuracy_(accuracy), sensitivitiesEnabled_(false),
+          bootstrap_(bootstrap) {
             bootstrap_.setup(this);
         }
         PiecewiseYieldCurve(
@@ -138,7 +195,8 @@ namespace QuantLib {
         : base_curve(settlementDays, calendar, dayCounter,
                      std::vector<Handle<Quote> >(), std::vector<Date>(), i),
           instruments_(instruments),
-          accuracy_(accuracy), bootstrap_(bootstrap) {
+          accuracy_(accuracy), sensitivitiesEnabled_(false),
+          bootstrap_(bootstrap) {
             bootstrap_.setup(this);
         }
         PiecewiseYieldCurve(
@@ -152,7 +210,8 @@ namespace QuantLib {
         : base_curve(settlementDays, calendar, dayCounter,
                      std::vector<Handle<Quote> >(), std::vector<Date>(), i),
           instruments_(instruments),
-          accuracy_(1.0e-12), bootstrap_(bootstrap) {
+          accuracy_(1.0e-12), sensitivitiesEnabled_(false),
+          bootstrap_(bootstrap) {
             bootstrap_.setup(this);
         }
         //@}
@@ -171,6 +230,41 @@ namespace QuantLib {
         //@{
         void update();
         //@}
+        //! \name BootstrapSensitivities interface
+        //@{
+        /*! the quotes are returned sorted by helper maturity;
+            sensitivities to expired helpers are null.
+        */
+        std::vector<Handle<Quote> > bootstrapQuotes() const;
+        /*! The derivatives are calculated analytically through the
+            interpolation, including the extrapolation beyond the
+            last node.  They are available for discount, zero-yield
+            and forward-rate curves interpolated linearly or with
+            backward- or forward-flat interpolation, and for discount
+            and zero-yield curves interpolated log-linearly.
+        */
+        void addDiscountSensitivities(
+                                const Date& d,
+                                Real weight,
+                                std::vector<Real>& nodeSensitivities) const;
+        /*! \pre quote sensitivities must be enabled. */
+        std::vector<Real> quoteSensitivities(
+                           const std::vector<Real>& nodeSensitivities) const;
+        //@}
+        //! \name Quote sensitivities
+        //@{
+        /*! enables the calculation of the Jacobian of the helpers'
+            implied quotes with respect to the curve nodes, which
+            quoteSensitivities() requires.  The Jacobian is calculated
+            along with each bootstrap; since the helpers provide no
+            derivatives, this is done by perturbing the nodes while
+            the curve is being built, which costs two implied-quote
+            evaluations of every alive helper per node.  The curve is
+            not modified afterwards, so that sensitivities can be
+            calculated on a bootstrapped curve from several threads.
+        */
+        void enableQuoteSensitivities(bool flag = true);
+        //@}
       private:
         //! \name LazyObject interface
         //@{
@@ -178,9 +272,36 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const;
+        void calculateNodeJacobian() const;
+        // derivatives of the interpolated value, of its derivative
+        // and of its primitive with respect to the nodes
+        void interpolationSensitivities(Time t,
+                                        std::vector<Real>& value,
+                                        std::vector<Real>& derivative,
+                                        std::vector<Real>& primitive) const;
+        // derivatives of the discount factor without jumps, depending
+        // on what the curve interpolates
+        void addNodeSensitivities(Time t, Real weight,
+                                  std::vector<Real>& nodeSensitivities,
+                                  const Discount*) const;
+        void addNodeSensitivities(Time t, Real weight,
+                                  std::vector<Real>& nodeSensitivities,
+                                  const ZeroYield*) const;
+        void addNodeSensitivities(Time t, Real weight,
+                                  std::vector<Real>& nodeSensitivities,
+                                  const ForwardRate*) const;
+        template <class T>
+        void addNodeSensitivities(Time, Real, std::vector<Real>&,
+                                  const T*) const {
+            QL_FAIL("quote sensitivities not available for this curve");
+        }
         // data members
         std::vector<boost::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
+        bool sensitivitiesEnabled_;
+        // inverse of the transposed Jacobian of the alive helpers'
+        // implied quotes with respect to the curve nodes
+        mutable Matrix inverseNodeJacobian_;
 
         // bootstrapper classes are declared as friend to manipulate
         // the curve data. They might be passed the data instead, but
@@ -249,8 +370,253 @@ namespace QuantLib {
 
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
+        inverseNodeJacobian_ = Matrix();
         // just delegate to the bootstrapper
         bootstrap_.calculate();
+        // the Jacobian is calculated while the curve is being built
+        if (sensitivitiesEnabled_)
+            calculateNodeJacobian();
+    }
+
+    template <class C, class I, template <class> class B>
+    std::vector<Handle<Quote> >
+    PiecewiseYieldCurve<C,I,B>::bootstrapQuotes() const {
+        calculate();
+        std::vector<Handle<Quote> > quotes(instruments_.size());
+        for (Size j=0; j<instruments_.size(); ++j)
+            quotes[j] = instruments_[j]->quote();
+        return quotes;
+    }
+
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::enableQuoteSensitivities(bool flag) {
+        if (flag != sensitivitiesEnabled_) {
+            sensitivitiesEnabled_ = flag;
+            // the Jacobian is calculated along with the next bootstrap
+            update();
+        }
+    }
+
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::calculateNodeJacobian() const {
+        // node 0 is not bootstrapped; node k+1 is fixed by the k-th
+        // alive helper.  Nodes are moved as the bootstrap does, so
+        // that nodes depending on the perturbed one follow it.
+        Size alive = this->data_.size()-1;
+        Size firstAlive = instruments_.size()-alive;
+        std::vector<Real> nodes = this->data_;
+        Matrix jacobian(alive, alive);
+        try {
+            for (Size k=0; k<alive; ++k) {
+                Real h = 1.0e-6 * std::max(1.0, std::fabs(nodes[k+1]));
+                C::updateGuess(this->data_, nodes[k+1]+h, k+1);
+                this->interpolation_.update();
+                for (Size j=0; j<alive; ++j)
+                    jacobian[k][j] =
+                        instruments_[firstAlive+j]->impliedQuote();
+                C::updateGuess(this->data_, nodes[k+1]-h, k+1);
+                this->interpolation_.update();
+                for (Size j=0; j<alive; ++j)
+                    jacobian[k][j] = (jacobian[k][j] -
+                        instruments_[firstAlive+j]->impliedQuote())/(2.0*h);
+                std::copy(nodes.begin(), nodes.end(), this->data_.begin());
+            }
+        } catch (...) {
+            std::copy(nodes.begin(), nodes.end(), this->data_.begin());
+            this->interpolation_.update();
+            throw;
+        }
+        this->interpolation_.update();
+        // the rows above are already the transposed Jacobian
+        inverseNodeJacobian_ = inverse(jacobian);
+    }
+
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::interpolationSensitivities(
+                                        Time t,
+                                        std::vector<Real>& value,
+                                        std::vector<Real>& derivative,
+                                        std::vector<Real>& primitive) const {
+        typedef detail::NodeDependence<I> dependence;
+        QL_REQUIRE(dependence::available,
+                   "quote sensitivities not available for this "
+                   "interpolation");
+
+        const std::vector<Time>& times = this->times_;
+        const std::vector<Real>& data = this->data_;
+        Size n = data.size();
+        value.resize(n);
+        derivative.resize(n);
+        primitive.resize(n);
+
+        // the interpolation of the j-th unit vector is the derivative
+        // of the interpolation with respect to the j-th node
+        typename dependence::interpolator interpolator;
+        std::vector<Real> unit(n, 0.0);
+        for (Size j=0; j<n; ++j) {
+            unit[j] = 1.0;
+            Interpolation f = interpolator.interpolate(times.begin(),
+                                                       times.end(),
+                                                       unit.begin());
+            value[j] = f(t, true);
+            derivative[j] = f.derivative(t, true);
+            primitive[j] = f.primitive(t, true);
+            unit[j] = 0.0;
+        }
+
+        if (dependence::logarithmic) {
+            // the interpolation is exp(g), where g interpolates the
+            // logarithms of the nodes
+            Real h = this->interpolation_(t, true);
+            Real dg = this->interpolation_.derivative(t, true) / h;
+            for (Size j=0; j<n; ++j) {
+                Real dh = h * value[j] / data[j];
+                derivative[j] = dh * dg + h * derivative[j] / data[j];
+                value[j] = dh;
+                primitive[j] = Null<Real>();
+            }
+        }
+    }
+
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::addNodeSensitivities(
+                                      Time t, Real weight,
+                                      std::vector<Real>& nodeSensitivities,
+                                      const Discount*) const {
+        std::vector<Real> value, derivative, primitive;
+        Time tMax = this->times_.back();
+        if (t <= tMax) {
+            interpolationSensitivities(t, value, derivative, primitive);
+            for (Size j=0; j<value.size(); ++j)
+                nodeSensitivities[j] += weight * value[j];
+        } else {
+            // flat fwd extrapolation: d(t) = dMax exp(-f (t-tMax)),
+            // with f = -d'(tMax)/dMax
+            interpolationSensitivities(tMax, value, derivative, primitive);
+            Size last = value.size()-1;
+            DiscountFactor dMax = this->data_.back();
+            Real slope = this->interpolation_.derivative(tMax);
+            DiscountFactor d = base_curve::discountImpl(t);
+            for (Size j=0; j<=last; ++j) {
+                Real df = - derivative[j] / dMax;
+                Real dd = 0.0;
+                if (j == last) {
+                    df += slope / (dMax*dMax);
+                    dd = 1.0/dMax;
+                }
+                nodeSensitivities[j] += weight * d * (dd - df*(t-tMax));
+            }
+        }
+    }
+
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::addNodeSensitivities(
+                                      Time t, Real weight,
+                                      std::vector<Real>& nodeSensitivities,
+                                      const ZeroYield*) const {
+        if (t == 0.0)
+            return;
+        // d(t) = exp(-z(t) t)
+        std::vector<Real> value, derivative, primitive;
+        DiscountFactor d = base_curve::discountImpl(t);
+        Time tMax = this->times_.back();
+        if (t <= tMax) {
+            interpolationSensitivities(t, value, derivative, primitive);
+            for (Size j=0; j<value.size(); ++j)
+                nodeSensitivities[j] -= weight * d * t * value[j];
+        } else {
+            // flat fwd extrapolation: z(t) = (zMax tMax + f (t-tMax))/t,
+            // with f = zMax + tMax z'(tMax)
+            interpolationSensitivities(tMax, value, derivative, primitive);
+            Size last = value.size()-1;
+            for (Size j=0; j<=last; ++j) {
+                Real df = tMax * derivative[j];
+                Real dz = 0.0;
+                if (j == last) {
+                    df += 1.0;
+                    dz = tMax;
+                }
+                dz = (dz + df*(t-tMax))/t;
+                nodeSensitivities[j] -= weight * d * t * dz;
+            }
+        }
+    }
+
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::addNodeSensitivities(
+                                      Time t, Real weight,
+                                      std::vector<Real>& nodeSensitivities,
+                                      const ForwardRate*) const {
+        QL_REQUIRE(!detail::NodeDependence<I>::logarithmic,
+                   "quote sensitivities not available for this "
+                   "interpolation of forward rates");
+        if (t == 0.0)
+            return;
+        // d(t) = exp(-integral of f from 0 to t)
+        std::vector<Real> value, derivative, primitive;
+        DiscountFactor d = base_curve::discountImpl(t);
+        Time tMax = this->times_.back();
+        interpolationSensitivities(std::min(t, tMax),
+                                   value, derivative, primitive);
+        // flat fwd extrapolation beyond the last node
+        if (t > tMax)
+            primitive.back() += t - tMax;
+        for (Size j=0; j<primitive.size(); ++j)
+            nodeSensitivities[j] -= weight * d * primitive[j];
+    }
+
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::addDiscountSensitivities(
+                               const Date& d,
+                               Real weight,
+                               std::vector<Real>& nodeSensitivities) const {
+        calculate();
+        Size n = this->data_.size();
+        if (nodeSensitivities.empty())
+            nodeSensitivities.resize(n, 0.0);
+        QL_REQUIRE(nodeSensitivities.size() == n,
+                   "wrong number of node sensitivities ("
+                   << nodeSensitivities.size() << " instead of "
+                   << n << ")");
+        Time t = this->timeFromReference(d);
+        // jumps multiply the discount factor by a constant factor
+        DiscountFactor withoutJumps = base_curve::discountImpl(t);
+        if (withoutJumps != 0.0)
+            weight *= this->discount(t, true) / withoutJumps;
+        addNodeSensitivities(t, weight, nodeSensitivities,
+                             static_cast<const C*>(0));
+    }
+
+    template <class C, class I, template <class> class B>
+    std::vector<Real> PiecewiseYieldCurve<C,I,B>::quoteSensitivities(
+                          const std::vector<Real>& nodeSensitivities) const {
+        calculate();
+        QL_REQUIRE(sensitivitiesEnabled_,
+                   "quote sensitivities not enabled for this curve");
+
+        Size alive = this->data_.size()-1;
+        Size firstAlive = instruments_.size()-alive;
+        std::vector<Real> result(instruments_.size(), 0.0);
+        if (nodeSensitivities.empty())
+            return result;
+        QL_REQUIRE(nodeSensitivities.size() == alive+1,
+                   "wrong number of node sensitivities ("
+                   << nodeSensitivities.size() << " instead of "
+                   << alive+1 << ")");
+
+        Array g(nodeSensitivities.begin()+1, nodeSensitivities.end());
+        // node 0 is either fixed or moved along with node 1 by the
+        // bootstrap, as the Jacobian assumes
+        std::vector<Real> probe(2, 0.0);
+        C::updateGuess(probe, 1.0, 1);
+        if (probe[0] == 1.0)
+            g[0] += nodeSensitivities[0];
+
+        // map node sensitivities onto quotes: solve J^T x = g
+        Array alivePart = inverseNodeJacobian_ * g;
+        std::copy(alivePart.begin(), alivePart.end(),
+                  result.begin()+firstAlive);
+        return result;
     }
 
 }
@@ -22,9 +22,89 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        const Year firstYear = 1901, lastYear = 2199;
+
+        // number of set bits for the days of year in [first, last]
+        Size countBusinessDays(const std::bitset<366>& b,
+                               Day first, Day last) {
+            std::bitset<366> window = b >> (first-1);
+            window <<= b.size() - (last-first+1);
+            return window.count();
+        }
+
+    }
+
+    BigNatural Calendar::Impl::currentRevision_ = 1;
+
+    void Calendar::Impl::resetBusinessDayCaches() {
+        ++currentRevision_;
+    }
+
+    const Calendar::Impl::YearlyBitmap&
+    Calendar::Impl::businessDays(Year y) const {
+        QL_REQUIRE(y >= firstYear && y <= lastYear,
+                   "year " << y << " out of bounds. It must be in ["
+                   << firstYear << "," << lastYear << "]");
+        Size i = y - firstYear;
+        // joint calendars depend on other calendars, so any
+        // modification anywhere invalidates all cached bitmaps.
+        // The flushes pair with the ones made by the writer below,
+        // so that the flags are read after the writer published
+        // them and the data are read after the flags.
+        #pragma omp flush
+        if (revision_ == currentRevision_ && cached_[i]) {
+            #pragma omp flush
+            return bitmaps_[i];
+        }
+
+        // the bitmap is built outside the lock, since the rules of
+        // joint calendars query the bitmaps of their components
+        YearlyBitmap b;
+        Date d(1, January, y), end(31, December, y);
+        for (Size j=0; ; ++d, ++j) {
+            if (addedHolidays.find(d) != addedHolidays.end())
+                b[j] = false;
+            else if (removedHolidays.find(d) != removedHolidays.end())
+                b[j] = true;
+            else
+                b[j] = isBusinessDay(d);
+            // avoid incrementing Date::maxDate()
+            if (d == end)
+                break;
+        }
+
+        // the storage is only allocated once, so that readers never
+        // see it reallocated; flags are published after the data
+        #pragma omp critical(ql_calendar_business_days)
+        {
+            if (revision_ != currentRevision_) {
+                bitmaps_.resize(lastYear-firstYear+1);
+                counts_.resize(lastYear-firstYear+1);
+                cached_.assign(lastYear-firstYear+1, 0);
+                #pragma omp flush
+                revision_ = currentRevision_;
+            }
+            if (!cached_[i]) {
+                bitmaps_[i] = b;
+                counts_[i] = b.count();
+                #pragma omp flush
+                cached_[i] = 1;
+            }
+        }
+        return bitmaps_[i];
+    }
+
+    Size Calendar::Impl::businessDaysInYear(Year y) const {
+        businessDays(y);
+        return counts_[y-firstYear];
+    }
+
     void Calendar::addHoliday(const Date& d) {
         // if d was a genuine holiday previously removed, revert the change
         impl_->removedHolidays.erase(d);
@@ -32,6 +112,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        Impl::resetBusinessDayCaches();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -41,6 +122,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        Impl::resetBusinessDayCaches();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -89,6 +171,19 @@ namespace QuantLib {
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
+                    // skip to the end of the year if the remaining
+                    // business days in it are not enough
+                    Year y = d1.year();
+                    if (y < lastYear && d1.dayOfYear() < 365) {
+                        Size left = countBusinessDays(
+                                           impl_->businessDays(y),
+                                           d1.dayOfYear()+1, 366);
+                        if (left < Size(n)) {
+                            n -= Integer(left);
+                            d1 = Date(31, December, y);
+                            continue;
+                        }
+                    }
                     d1++;
                     while (isHoliday(d1))
                         d1++;
@@ -96,6 +191,19 @@ namespace QuantLib {
                 }
             } else {
                 while (n < 0) {
+                    // skip to the start of the year if the remaining
+                    // business days in it are not enough
+                    Year y = d1.year();
+                    if (y > firstYear && d1.dayOfYear() > 1) {
+                        Size left = countBusinessDays(
+                                           impl_->businessDays(y),
+                                           1, d1.dayOfYear()-1);
+                        if (left < Size(-n)) {
+                            n += Integer(left);
+                            d1 = Date(1, January, y);
+                            continue;
+                        }
+                    }
                     d1--;
                     while(isHoliday(d1))
                         d1--;
@@ -130,22 +238,20 @@ namespace QuantLib {
                                              bool includeLast) const {
         BigInteger wd = 0;
         if (from != to) {
-            if (from < to) {
-                // the last one is treated separately to avoid
-                // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(from))
-                    ++wd;
+            // count the business days in [first, last] using the
+            // yearly bitmaps; whole years are taken from the counts
+            Date first = std::min(from, to), last = std::max(from, to);
+            Year y1 = first.year(), y2 = last.year();
+            if (y1 == y2) {
+                wd = countBusinessDays(impl_->businessDays(y1),
+                                       first.dayOfYear(), last.dayOfYear());
+            } else {
+                wd = countBusinessDays(impl_->businessDays(y1),
+                                       first.dayOfYear(), 366);
+                for (Year y = y1+1; y < y2; ++y)
+                    wd += impl_->businessDaysInYear(y);
+                wd += countBusinessDays(impl_->businessDays(y2),
+                                        1, last.dayOfYear());
             }
 
             if (isBusinessDay(from) && !includeFirst)
@@ -29,6 +29,7 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <boost/shared_ptr.hpp>
+#include <bitset>
 #include <set>
 #include <vector>
 #include <string>
@@ -60,13 +61,41 @@ namespace QuantLib {
         //! abstract base class for calendar implementations
         class Impl {
           public:
+            //! business days of a year, indexed by day of year minus one
+            typedef std::bitset<366> YearlyBitmap;
+            Impl() : revision_(0) {}
             virtual ~Impl() {}
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+            /*! Returns the business days of the given year, taking
+                added and removed holidays into account.  The bitmap
+                is built lazily on first access and discarded as soon
+                as any calendar is modified.  Bitmaps are published
+                under a lock, so that calendars can be read from
+                different threads.
+
+                \warning adding or removing holidays while other
+                         threads are using any calendar is not safe.
+            */
+            const YearlyBitmap& businessDays(Year y) const;
+            //! number of business days in the given year
+            Size businessDaysInYear(Year y) const;
+            //! invalidates the cached bitmaps of all calendars
+            static void resetBusinessDayCaches();
+            //! changes whenever any calendar is modified
+            static BigNatural revision() { return currentRevision_; }
+          private:
+            mutable std::vector<YearlyBitmap> bitmaps_;
+            mutable std::vector<Size> counts_;
+            mutable std::vector<unsigned char> cached_;
+            mutable BigNatural revision_;
+            static BigNatural currentRevision_;
         };
         boost::shared_ptr<Impl> impl_;
+        // identifies calendars by implementation rather than by name
+        friend class ScheduleCache;
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -193,6 +222,10 @@ namespace QuantLib {
     }
 
     inline bool Calendar::isBusinessDay(const Date& d) const {
+        Year y = d.year();
+        if (y >= 1901 && y <= 2199)
+            return impl_->businessDays(y).test(d.dayOfYear()-1);
+        // outside the range of valid dates; check the rules directly
         if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
             return false;
         if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
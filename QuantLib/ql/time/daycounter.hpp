@@ -27,6 +27,7 @@
 
 #include <ql/time/date.hpp>
 #include <ql/errors.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -56,6 +57,14 @@ namespace QuantLib {
                                       const Date& d2,
                                       const Date& refPeriodStart,
                                       const Date& refPeriodEnd) const = 0;
+            //! to be overloaded by day counters with a faster batch version
+            virtual void yearFractions(const Date& d1,
+                                       const std::vector<Date>& d2,
+                                       std::vector<Time>& result) const {
+                result.resize(d2.size());
+                for (Size i=0; i<d2.size(); ++i)
+                    result[i] = yearFraction(d1, d2[i], Date(), Date());
+            }
         };
         boost::shared_ptr<Impl> impl_;
         /*! This constructor can be invoked by derived classes which
@@ -85,6 +94,14 @@ namespace QuantLib {
         Time yearFraction(const Date&, const Date&,
                           const Date& refPeriodStart = Date(),
                           const Date& refPeriodEnd = Date()) const;
+        /*! Returns the periods between a given date and each of the
+            passed dates as fractions of year.  The results are the
+            same as those of yearFraction() without reference period;
+            however, the implementation is only called once for the
+            whole set of dates.
+        */
+        std::vector<Time> yearFractions(const Date&,
+                                        const std::vector<Date>&) const;
         //@}
     };
 
@@ -129,6 +146,15 @@ namespace QuantLib {
             return impl_->yearFraction(d1,d2,refPeriodStart,refPeriodEnd);
     }
 
+    inline std::vector<Time>
+    DayCounter::yearFractions(const Date& d1,
+                              const std::vector<Date>& d2) const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        std::vector<Time> result;
+        impl_->yearFractions(d1, d2, result);
+        return result;
+    }
+
 
     inline bool operator==(const DayCounter& d1, const DayCounter& d2) {
         return (d1.empty() && d2.empty())
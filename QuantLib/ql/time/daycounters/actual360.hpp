@@ -49,6 +49,14 @@ namespace QuantLib {
                               const Date&) const {
                 return dayCount(d1,d2)/360.0;
             }
+            void yearFractions(const Date& d1,
+                               const std::vector<Date>& d2,
+                               std::vector<Time>& result) const {
+                BigInteger extra = (includeLastDay_ ? 1 : 0);
+                result.resize(d2.size());
+                for (Size i=0; i<d2.size(); ++i)
+                    result[i] = ((d2[i]-d1) + extra)/360.0;
+            }
         };
       public:
         Actual360(const bool includeLastDay = false )
@@ -52,6 +52,13 @@ namespace QuantLib {
                               const Date&) const {
                 return dayCount(d1,d2)/365.0;
             }
+            void yearFractions(const Date& d1,
+                               const std::vector<Date>& d2,
+                               std::vector<Time>& result) const {
+                result.resize(d2.size());
+                for (Size i=0; i<d2.size(); ++i)
+                    result[i] = (d2[i]-d1)/365.0;
+            }
         };
       public:
         Actual365Fixed()
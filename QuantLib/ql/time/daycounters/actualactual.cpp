@@ -18,6 +18,7 @@
 */
 
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/utilities/null.hpp>
 
 namespace QuantLib {
 
@@ -158,6 +159,32 @@ namespace QuantLib {
         return sum;
     }
 
+    void ActualActual::ISDA_Impl::yearFractions(const Date& d1,
+                                                const std::vector<Date>& d2,
+                                                std::vector<Time>& result)
+                                                                       const {
+        result.resize(d2.size());
+        // the part depending on d1 only is calculated once
+        Integer y1 = d1.year();
+        Time first = Null<Time>();
+        for (Size i=0; i<d2.size(); ++i) {
+            if (d2[i] <= d1) {
+                result[i] = yearFraction(d1, d2[i], Date(), Date());
+            } else {
+                if (first == Null<Time>()) {
+                    Real dib1 = (Date::isLeap(y1) ? 366.0 : 365.0);
+                    first = dayCount(d1, Date(1,January,y1+1))/dib1;
+                }
+                Integer y2 = d2[i].year();
+                Real dib2 = (Date::isLeap(y2) ? 366.0 : 365.0);
+                Time sum = y2 - y1 - 1;
+                sum += first;
+                sum += dayCount(Date(1,January,y2),d2[i])/dib2;
+                result[i] = sum;
+            }
+        }
+    }
+
     Time ActualActual::AFB_Impl::yearFraction(const Date& d1,
                                               const Date& d2,
                                               const Date&,
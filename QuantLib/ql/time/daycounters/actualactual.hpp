@@ -71,6 +71,9 @@ namespace QuantLib {
                               const Date& d2,
                               const Date&,
                               const Date&) const;
+            void yearFractions(const Date& d1,
+                               const std::vector<Date>& d2,
+                               std::vector<Time>& result) const;
         };
         class AFB_Impl : public DayCounter::Impl {
           public:
@@ -72,4 +72,65 @@ namespace QuantLib {
             std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
     }
 
+    // the batch versions below decompose the first date only once
+
+    void Thirty360::US_Impl::yearFractions(const Date& d1,
+                                           const std::vector<Date>& d2,
+                                           std::vector<Time>& result) const {
+        Day dd1 = d1.dayOfMonth();
+        Integer mm1 = d1.month();
+        Year yy1 = d1.year();
+        result.resize(d2.size());
+        for (Size i=0; i<d2.size(); ++i) {
+            Day dd2 = d2[i].dayOfMonth();
+            Integer mm2 = d2[i].month();
+            Year yy2 = d2[i].year();
+
+            if (dd2 == 31 && dd1 < 30) { dd2 = 1; mm2++; }
+
+            BigInteger days = 360*(yy2-yy1) + 30*(mm2-mm1-1) +
+                std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+            result[i] = days/360.0;
+        }
+    }
+
+    void Thirty360::EU_Impl::yearFractions(const Date& d1,
+                                           const std::vector<Date>& d2,
+                                           std::vector<Time>& result) const {
+        Day dd1 = d1.dayOfMonth();
+        Month mm1 = d1.month();
+        Year yy1 = d1.year();
+        result.resize(d2.size());
+        for (Size i=0; i<d2.size(); ++i) {
+            Day dd2 = d2[i].dayOfMonth();
+            Month mm2 = d2[i].month();
+            Year yy2 = d2[i].year();
+
+            BigInteger days = 360*(yy2-yy1) + 30*(mm2-mm1-1) +
+                std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+            result[i] = days/360.0;
+        }
+    }
+
+    void Thirty360::IT_Impl::yearFractions(const Date& d1,
+                                           const std::vector<Date>& d2,
+                                           std::vector<Time>& result) const {
+        Day dd1 = d1.dayOfMonth();
+        Month mm1 = d1.month();
+        Year yy1 = d1.year();
+        if (mm1 == 2 && dd1 > 27) dd1 = 30;
+        result.resize(d2.size());
+        for (Size i=0; i<d2.size(); ++i) {
+            Day dd2 = d2[i].dayOfMonth();
+            Month mm2 = d2[i].month();
+            Year yy2 = d2[i].year();
+
+            if (mm2 == 2 && dd2 > 27) dd2 = 30;
+
+            BigInteger days = 360*(yy2-yy1) + 30*(mm2-mm1-1) +
+                std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+            result[i] = days/360.0;
+        }
+    }
+
 }
@@ -58,9 +58,26 @@ namespace QuantLib {
             }
             return result;
         }
+
+        // shared by default-constructed schedules
+        const boost::shared_ptr<std::vector<Date> >& noDates() {
+            static boost::shared_ptr<std::vector<Date> > dates(
+                                                     new std::vector<Date>);
+            return dates;
+        }
+
+        const boost::shared_ptr<std::vector<bool> >& noRegularity() {
+            static boost::shared_ptr<std::vector<bool> > flags(
+                                                     new std::vector<bool>);
+            return flags;
+        }
+
     }
 
 
+    Schedule::Schedule()
+    : dates_(noDates()), isRegular_(noRegularity()) {}
+
     Schedule::Schedule(const std::vector<Date>& dates,
                        const Calendar& calendar,
                        BusinessDayConvention convention)
@@ -69,7 +86,8 @@ namespace QuantLib {
       convention_(convention),
       terminationDateConvention_(convention),
       rule_(DateGeneration::Forward), endOfMonth_(false),
-      dates_(dates) {}
+      dates_(new std::vector<Date>(dates)),
+      isRegular_(new std::vector<bool>) {}
 
     Schedule::Schedule(Date effectiveDate,
                        const Date& terminationDate,
@@ -87,7 +105,8 @@ namespace QuantLib {
       terminationDateConvention_(terminationDateConvention),
       rule_(rule), endOfMonth_(endOfMonth),
       firstDate_(first==effectiveDate ? Date() : first),
-      nextToLastDate_(nextToLast==terminationDate ? Date() : nextToLast)
+      nextToLastDate_(nextToLast==terminationDate ? Date() : nextToLast),
+      dates_(new std::vector<Date>), isRegular_(new std::vector<bool>)
     {
         // sanity checks
         QL_REQUIRE(terminationDate != Date(), "null termination date");
@@ -186,24 +205,24 @@ namespace QuantLib {
 
           case DateGeneration::Zero:
             tenor_ = 0*Years;
-            dates_.push_back(effectiveDate);
-            dates_.push_back(terminationDate);
-            isRegular_.push_back(true);
+            dates_->push_back(effectiveDate);
+            dates_->push_back(terminationDate);
+            isRegular_->push_back(true);
             break;
 
           case DateGeneration::Backward:
 
-            dates_.push_back(terminationDate);
+            dates_->push_back(terminationDate);
 
             seed = terminationDate;
             if (nextToLastDate_ != Date()) {
-                dates_.insert(dates_.begin(), nextToLastDate_);
+                dates_->insert(dates_->begin(), nextToLastDate_);
                 Date temp = nullCalendar.advance(seed,
                     -periods*tenor_, convention, endOfMonth);
                 if (temp!=nextToLastDate_)
-                    isRegular_.insert(isRegular_.begin(), false);
+                    isRegular_->insert(isRegular_->begin(), false);
                 else
-                    isRegular_.insert(isRegular_.begin(), true);
+                    isRegular_->insert(isRegular_->begin(), true);
                 seed = nextToLastDate_;
             }
 
@@ -216,28 +235,28 @@ namespace QuantLib {
                     -periods*tenor_, convention, endOfMonth);
                 if (temp < exitDate) {
                     if (firstDate_ != Date() &&
-                        (calendar_.adjust(dates_.front(),convention)!=
+                        (calendar_.adjust(dates_->front(),convention)!=
                          calendar_.adjust(firstDate_,convention))) {
-                        dates_.insert(dates_.begin(), firstDate_);
-                        isRegular_.insert(isRegular_.begin(), false);
+                        dates_->insert(dates_->begin(), firstDate_);
+                        isRegular_->insert(isRegular_->begin(), false);
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.front(),convention)!=
+                    if (calendar_.adjust(dates_->front(),convention)!=
                         calendar_.adjust(temp,convention)) {
-                        dates_.insert(dates_.begin(), temp);
-                        isRegular_.insert(isRegular_.begin(), true);
+                        dates_->insert(dates_->begin(), temp);
+                        isRegular_->insert(isRegular_->begin(), true);
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.front(),convention)!=
+            if (calendar_.adjust(dates_->front(),convention)!=
                 calendar_.adjust(effectiveDate,convention)) {
-                dates_.insert(dates_.begin(), effectiveDate);
-                isRegular_.insert(isRegular_.begin(), false);
+                dates_->insert(dates_->begin(), effectiveDate);
+                isRegular_->insert(isRegular_->begin(), false);
             }
             break;
 
@@ -253,22 +272,22 @@ namespace QuantLib {
           case DateGeneration::Forward:
 
             if (rule_ == DateGeneration::CDS) {
-                dates_.push_back(previousTwentieth(effectiveDate,
+                dates_->push_back(previousTwentieth(effectiveDate,
                                                    DateGeneration::CDS));
             } else {
-                dates_.push_back(effectiveDate);
+                dates_->push_back(effectiveDate);
             }
 
-            seed = dates_.back();
+            seed = dates_->back();
 
             if (firstDate_!=Date()) {
-                dates_.push_back(firstDate_);
+                dates_->push_back(firstDate_);
                 Date temp = nullCalendar.advance(seed, periods*tenor_,
                                                  convention, endOfMonth);
                 if (temp!=firstDate_)
-                    isRegular_.push_back(false);
+                    isRegular_->push_back(false);
                 else
-                    isRegular_.push_back(true);
+                    isRegular_->push_back(true);
                 seed = firstDate_;
             } else if (rule_ == DateGeneration::Twentieth ||
                        rule_ == DateGeneration::TwentiethIMM ||
@@ -284,8 +303,8 @@ namespace QuantLib {
                     }
                 }
                 if (next20th != effectiveDate) {
-                    dates_.push_back(next20th);
-                    isRegular_.push_back(false);
+                    dates_->push_back(next20th);
+                    isRegular_->push_back(false);
                     seed = next20th;
                 }
             }
@@ -299,35 +318,35 @@ namespace QuantLib {
                                                  convention, endOfMonth);
                 if (temp > exitDate) {
                     if (nextToLastDate_ != Date() &&
-                        (calendar_.adjust(dates_.back(),convention)!=
+                        (calendar_.adjust(dates_->back(),convention)!=
                          calendar_.adjust(nextToLastDate_,convention))) {
-                        dates_.push_back(nextToLastDate_);
-                        isRegular_.push_back(false);
+                        dates_->push_back(nextToLastDate_);
+                        isRegular_->push_back(false);
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.back(),convention)!=
+                    if (calendar_.adjust(dates_->back(),convention)!=
                         calendar_.adjust(temp,convention)) {
-                        dates_.push_back(temp);
-                        isRegular_.push_back(true);
+                        dates_->push_back(temp);
+                        isRegular_->push_back(true);
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.back(),terminationDateConvention)!=
+            if (calendar_.adjust(dates_->back(),terminationDateConvention)!=
                 calendar_.adjust(terminationDate,terminationDateConvention)) {
                 if (rule_ == DateGeneration::Twentieth ||
                     rule_ == DateGeneration::TwentiethIMM ||
                     rule_ == DateGeneration::OldCDS ||
                     rule_ == DateGeneration::CDS) {
-                    dates_.push_back(nextTwentieth(terminationDate, rule_));
-                    isRegular_.push_back(true);
+                    dates_->push_back(nextTwentieth(terminationDate, rule_));
+                    isRegular_->push_back(true);
                 } else {
-                    dates_.push_back(terminationDate);
-                    isRegular_.push_back(false);
+                    dates_->push_back(terminationDate);
+                    isRegular_->push_back(false);
                 }
             }
 
@@ -339,37 +358,37 @@ namespace QuantLib {
 
         // adjustments
         if (rule_==DateGeneration::ThirdWednesday)
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = Date::nthWeekday(3, Wednesday,
-                                             dates_[i].month(),
-                                             dates_[i].year());
+            for (Size i=1; i<dates_->size()-1; ++i)
+                (*dates_)[i] = Date::nthWeekday(3, Wednesday,
+                                             (*dates_)[i].month(),
+                                             (*dates_)[i].year());
 
         if (endOfMonth && calendar_.isEndOfMonth(seed)) {
             // adjust to end of month
             if (convention == Unadjusted) {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = Date::endOfMonth(dates_[i]);
+                for (Size i=1; i<dates_->size()-1; ++i)
+                    (*dates_)[i] = Date::endOfMonth((*dates_)[i]);
             } else {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = calendar_.endOfMonth(dates_[i]);
+                for (Size i=1; i<dates_->size()-1; ++i)
+                    (*dates_)[i] = calendar_.endOfMonth((*dates_)[i]);
             }
             if (terminationDateConvention != Unadjusted) {
-                dates_.front() = calendar_.endOfMonth(dates_.front());
-                dates_.back() = calendar_.endOfMonth(dates_.back());
+                dates_->front() = calendar_.endOfMonth(dates_->front());
+                dates_->back() = calendar_.endOfMonth(dates_->back());
             } else {
                 // the termination date is the first if going backwards,
                 // the last otherwise.
                 if (rule_ == DateGeneration::Backward)
-                    dates_.back() = Date::endOfMonth(dates_.back());
+                    dates_->back() = Date::endOfMonth(dates_->back());
                 else
-                    dates_.front() = Date::endOfMonth(dates_.front());
+                    dates_->front() = Date::endOfMonth(dates_->front());
             }
         } else {
             // first date not adjusted for CDS schedules
             if (rule_ != DateGeneration::OldCDS)
-                dates_[0] = calendar_.adjust(dates_[0], convention);
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = calendar_.adjust(dates_[i], convention);
+                (*dates_)[0] = calendar_.adjust((*dates_)[0], convention);
+            for (Size i=1; i<dates_->size()-1; ++i)
+                (*dates_)[i] = calendar_.adjust((*dates_)[i], convention);
 
             // termination date is NOT adjusted as per ISDA
             // specifications, unless otherwise specified in the
@@ -380,7 +399,7 @@ namespace QuantLib {
                 || rule_ == DateGeneration::TwentiethIMM
                 || rule_ == DateGeneration::OldCDS
                 || rule_ == DateGeneration::CDS) {
-                dates_.back() = calendar_.adjust(dates_.back(),
+                dates_->back() = calendar_.adjust(dates_->back(),
                                                 terminationDateConvention);
             }
         }
@@ -389,41 +408,46 @@ namespace QuantLib {
         // necessary.  It can happen to be equal or later than the end
         // date due to EOM adjustments (see the Schedule test suite
         // for an example).
-        if (dates_.size() >= 2 && dates_[dates_.size()-2] >= dates_.back()) {
-            isRegular_[dates_.size()-2] =
-                (dates_[dates_.size()-2] == dates_.back());
-            dates_[dates_.size()-2] = dates_.back();
-            dates_.pop_back();
-            isRegular_.pop_back();
+        if (dates_->size() >= 2 && (*dates_)[dates_->size()-2] >= dates_->back()) {
+            (*isRegular_)[dates_->size()-2] =
+                ((*dates_)[dates_->size()-2] == dates_->back());
+            (*dates_)[dates_->size()-2] = dates_->back();
+            dates_->pop_back();
+            isRegular_->pop_back();
         }
-        if (dates_.size() >= 2 && dates_[1] <= dates_.front()) {
-            isRegular_[1] =
-                (dates_[1] == dates_.front());
-            dates_[1] = dates_.front();
-            dates_.erase(dates_.begin());
-            isRegular_.erase(isRegular_.begin());
+        if (dates_->size() >= 2 && (*dates_)[1] <= dates_->front()) {
+            (*isRegular_)[1] =
+                ((*dates_)[1] == dates_->front());
+            (*dates_)[1] = dates_->front();
+            dates_->erase(dates_->begin());
+            isRegular_->erase(isRegular_->begin());
         }
     }
 
 
     Schedule Schedule::until(const Date& truncationDate) const {
         Schedule result = *this;
+        // the dates might be shared with other schedules
+        result.dates_ = boost::shared_ptr<std::vector<Date> >(
+                                               new std::vector<Date>(*dates_));
+        result.isRegular_ = boost::shared_ptr<std::vector<bool> >(
+                                           new std::vector<bool>(*isRegular_));
 
-        QL_REQUIRE(truncationDate>result.dates_[0],
+        QL_REQUIRE(truncationDate>(*result.dates_)[0],
                    "truncation date " << truncationDate <<
                    " must be later than schedule first date " <<
-                   result.dates_[0]);
-        if (truncationDate<result.dates_.back()) {
+                   (*result.dates_)[0]);
+        if (truncationDate<result.dates_->back()) {
             // remove later dates
-            while (result.dates_.back()>truncationDate) {
-                result.dates_.pop_back();
-                result.isRegular_.pop_back();
+            while (result.dates_->back()>truncationDate) {
+                result.dates_->pop_back();
+                result.isRegular_->pop_back();
             }
 
             // add truncationDate if missing
-            if (truncationDate!=result.dates_.back()) {
-                result.dates_.push_back(truncationDate);
-                result.isRegular_.push_back(false);
+            if (truncationDate!=result.dates_->back()) {
+                result.dates_->push_back(truncationDate);
+                result.isRegular_->push_back(false);
                 result.terminationDateConvention_ = Unadjusted;
             } else {
                 result.terminationDateConvention_ = convention_;
@@ -443,12 +467,12 @@ namespace QuantLib {
         Date d = (refDate==Date() ?
                   Settings::instance().evaluationDate() :
                   refDate);
-        return std::lower_bound(dates_.begin(), dates_.end(), d);
+        return std::lower_bound(dates_->begin(), dates_->end(), d);
     }
 
     Date Schedule::nextDate(const Date& refDate) const {
         std::vector<Date>::const_iterator res = lower_bound(refDate);
-        if (res!=dates_.end())
+        if (res!=dates_->end())
             return *res;
         else
             return Date();
@@ -456,7 +480,7 @@ namespace QuantLib {
 
     Date Schedule::previousDate(const Date& refDate) const {
         std::vector<Date>::const_iterator res = lower_bound(refDate);
-        if (res!=dates_.begin())
+        if (res!=dates_->begin())
             return *(--res);
         else
             return Date();
@@ -464,15 +488,141 @@ namespace QuantLib {
 
     bool Schedule::isRegular(Size i) const {
         QL_REQUIRE(fullInterface_, "full interface not available");
-        QL_REQUIRE(i<=isRegular_.size() && i>0,
+        QL_REQUIRE(i<=isRegular_->size() && i>0,
                    "index (" << i << ") must be in [1, " <<
-                   isRegular_.size() <<"]");
-        return isRegular_[i-1];
+                   isRegular_->size() <<"]");
+        return (*isRegular_)[i-1];
+    }
+
+
+    bool ScheduleCache::Key::operator<(const Key& k) const {
+        if (effectiveDate != k.effectiveDate)
+            return effectiveDate < k.effectiveDate;
+        if (terminationDate != k.terminationDate)
+            return terminationDate < k.terminationDate;
+        if (tenorLength != k.tenorLength)
+            return tenorLength < k.tenorLength;
+        if (tenorUnits != k.tenorUnits)
+            return tenorUnits < k.tenorUnits;
+        if (convention != k.convention)
+            return convention < k.convention;
+        if (terminationDateConvention != k.terminationDateConvention)
+            return terminationDateConvention < k.terminationDateConvention;
+        if (rule != k.rule)
+            return rule < k.rule;
+        if (endOfMonth != k.endOfMonth)
+            return endOfMonth < k.endOfMonth;
+        if (firstDate != k.firstDate)
+            return firstDate < k.firstDate;
+        if (nextToLastDate != k.nextToLastDate)
+            return nextToLastDate < k.nextToLastDate;
+        return std::less<const void*>()(calendar, k.calendar);
+    }
+
+    ScheduleCache::ScheduleCache()
+    : revision_(Calendar::Impl::revision()), maxSize_(10000) {}
+
+    Size ScheduleCache::size() const {
+        Size n;
+        #pragma omp critical(ql_schedule_cache)
+        n = schedules_.size();
+        return n;
+    }
+
+    Size ScheduleCache::maxSize() const {
+        return maxSize_;
+    }
+
+    void ScheduleCache::setMaxSize(Size n) {
+        QL_REQUIRE(n > 0, "the cache must hold at least one schedule");
+        #pragma omp critical(ql_schedule_cache)
+        {
+            maxSize_ = n;
+            while (schedules_.size() > maxSize_) {
+                schedules_.erase(insertionOrder_.front());
+                insertionOrder_.pop_front();
+            }
+        }
+    }
+
+    void ScheduleCache::clear() {
+        #pragma omp critical(ql_schedule_cache)
+        {
+            schedules_.clear();
+            insertionOrder_.clear();
+        }
+    }
+
+    Schedule ScheduleCache::schedule(
+                           const Date& effectiveDate,
+                           const Date& terminationDate,
+                           const Period& tenor,
+                           const Calendar& calendar,
+                           BusinessDayConvention convention,
+                           BusinessDayConvention terminationDateConvention,
+                           DateGeneration::Rule rule,
+                           bool endOfMonth,
+                           const Date& firstDate,
+                           const Date& nextToLastDate) {
+        // a null effective date is replaced by a placeholder
+        // depending on the evaluation date; don't cache it
+        if (effectiveDate == Date())
+            return Schedule(effectiveDate, terminationDate, tenor, calendar,
+                            convention, terminationDateConvention,
+                            rule, endOfMonth, firstDate, nextToLastDate);
+
+        Key key;
+        key.effectiveDate = effectiveDate;
+        key.terminationDate = terminationDate;
+        key.tenorLength = tenor.length();
+        key.tenorUnits = tenor.units();
+        key.calendar = calendar.impl_.get();
+        key.convention = convention;
+        key.terminationDateConvention = terminationDateConvention;
+        key.rule = rule;
+        key.endOfMonth = endOfMonth;
+        key.firstDate = firstDate;
+        key.nextToLastDate = nextToLastDate;
+
+        Schedule cached;
+        bool found = false;
+        #pragma omp critical(ql_schedule_cache)
+        {
+            // the holidays of some calendar changed
+            if (revision_ != Calendar::Impl::revision()) {
+                schedules_.clear();
+                insertionOrder_.clear();
+                revision_ = Calendar::Impl::revision();
+            }
+            std::map<Key, Schedule>::const_iterator i = schedules_.find(key);
+            if (i != schedules_.end()) {
+                cached = i->second;
+                found = true;
+            }
+        }
+        if (found)
+            return cached;
+
+        // generated outside the lock, since it might throw
+        Schedule s(effectiveDate, terminationDate, tenor, calendar,
+                   convention, terminationDateConvention,
+                   rule, endOfMonth, firstDate, nextToLastDate);
+        #pragma omp critical(ql_schedule_cache)
+        {
+            if (schedules_.insert(std::make_pair(key, s)).second) {
+                insertionOrder_.push_back(key);
+                if (schedules_.size() > maxSize_) {
+                    schedules_.erase(insertionOrder_.front());
+                    insertionOrder_.pop_front();
+                }
+            }
+        }
+        return s;
     }
 
 
     MakeSchedule::MakeSchedule()
-    : rule_(DateGeneration::Backward), endOfMonth_(false) {}
+    : rule_(DateGeneration::Backward), endOfMonth_(false), cached_(false) {}
 
     MakeSchedule& MakeSchedule::from(const Date& effectiveDate) {
         effectiveDate_ = effectiveDate;
@@ -540,6 +690,11 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeSchedule& MakeSchedule::cached(bool flag) {
+        cached_ = flag;
+        return *this;
+    }
+
     MakeSchedule::operator Schedule() const {
         // check for mandatory arguments
         QL_REQUIRE(effectiveDate_ != Date(), "effective date not provided");
@@ -577,6 +732,12 @@ namespace QuantLib {
             calendar = NullCalendar();
         }
 
+        if (cached_)
+            return ScheduleCache::instance().schedule(
+                        effectiveDate_, terminationDate_, *tenor_, calendar,
+                        convention, terminationDateConvention,
+                        rule_, endOfMonth_, firstDate_, nextToLastDate_);
+
         return Schedule(effectiveDate_, terminationDate_, *tenor_, calendar,
                         convention, terminationDateConvention,
                         rule_, endOfMonth_, firstDate_, nextToLastDate_);
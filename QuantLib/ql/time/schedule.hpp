@@ -30,8 +30,12 @@
 #include <ql/utilities/null.hpp>
 #include <ql/time/period.hpp>
 #include <ql/time/dategenerationrule.hpp>
+#include <ql/patterns/singleton.hpp>
 #include <ql/errors.hpp>
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+#include <deque>
+#include <map>
 
 namespace QuantLib {
 
@@ -52,21 +56,21 @@ namespace QuantLib {
                  bool endOfMonth,
                  const Date& firstDate = Date(),
                  const Date& nextToLastDate = Date());
-        Schedule() {}
+        Schedule();
         //! \name Date access
         //@{
-        Size size() const { return dates_.size(); }
+        Size size() const { return dates_->size(); }
         const Date& operator[](Size i) const;
         const Date& at(Size i) const;
         const Date& date(Size i) const;
         Date previousDate(const Date& refDate) const;
         Date nextDate(const Date& refDate) const;
-        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Date>& dates() const { return *dates_; }
         bool isRegular(Size i) const;
         //@}
         //! \name Other inspectors
         //@{
-        bool empty() const { return dates_.empty(); }
+        bool empty() const { return dates_->empty(); }
         const Calendar& calendar() const;
         const Date& startDate() const;
         const Date& endDate() const;
@@ -80,8 +84,8 @@ namespace QuantLib {
         //! \name Iterators
         //@{
         typedef std::vector<Date>::const_iterator const_iterator;
-        const_iterator begin() const { return dates_.begin(); }
-        const_iterator end() const { return dates_.end(); }
+        const_iterator begin() const { return dates_->begin(); }
+        const_iterator end() const { return dates_->end(); }
         const_iterator lower_bound(const Date& d = Date()) const;
         //@}
         //! \name Utilities
@@ -97,8 +101,67 @@ namespace QuantLib {
         DateGeneration::Rule rule_;
         bool endOfMonth_;
         Date firstDate_, nextToLastDate_;
-        std::vector<Date> dates_;
-        std::vector<bool> isRegular_;
+        // shared between copies; never modified after construction
+        boost::shared_ptr<std::vector<Date> > dates_;
+        boost::shared_ptr<std::vector<bool> > isRegular_;
+    };
+
+
+    //! global repository of generated schedules
+    /*! Schedules requested with the same effective and termination
+        dates and the same conventions are generated once and then
+        returned as copies sharing the same date storage.  This
+        avoids duplicating identical schedules when large numbers of
+        instruments are built with the same conventions.
+
+        Calendars are told apart by their implementation, not by
+        their name, so that bespoke or joint calendars sharing a
+        name don't share schedules; the cached schedules keep their
+        calendars alive.  The whole cache is discarded when holidays
+        are added to or removed from any calendar.  When the cache
+        is full, the oldest schedules are discarded first.  Access
+        is serialized, so that the cache can be used from different
+        threads.
+    */
+    class ScheduleCache : public Singleton<ScheduleCache> {
+        friend class Singleton<ScheduleCache>;
+      private:
+        ScheduleCache();
+      public:
+        //! returns the (possibly cached) schedule for the given inputs
+        Schedule schedule(const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate = Date(),
+                          const Date& nextToLastDate = Date());
+        //! number of cached schedules
+        Size size() const;
+        //! maximum number of cached schedules
+        Size maxSize() const;
+        void setMaxSize(Size n);
+        //! removes all cached schedules
+        void clear();
+      private:
+        struct Key {
+            Date effectiveDate, terminationDate;
+            Integer tenorLength;
+            TimeUnit tenorUnits;
+            const void* calendar;
+            BusinessDayConvention convention, terminationDateConvention;
+            DateGeneration::Rule rule;
+            bool endOfMonth;
+            Date firstDate, nextToLastDate;
+            bool operator<(const Key&) const;
+        };
+        std::map<Key, Schedule> schedules_;
+        std::deque<Key> insertionOrder_;
+        BigNatural revision_;
+        Size maxSize_;
     };
 
 
@@ -122,6 +185,8 @@ namespace QuantLib {
         MakeSchedule& endOfMonth(bool flag=true);
         MakeSchedule& withFirstDate(const Date& d);
         MakeSchedule& withNextToLastDate(const Date& d);
+        //! share the generated dates through the ScheduleCache
+        MakeSchedule& cached(bool flag = true);
         operator Schedule() const;
       private:
         Calendar calendar_;
@@ -132,6 +197,7 @@ namespace QuantLib {
         DateGeneration::Rule rule_;
         bool endOfMonth_;
         Date firstDate_, nextToLastDate_;
+        bool cached_;
     };
 
 
@@ -139,19 +205,19 @@ namespace QuantLib {
     // inline definitions
 
     inline const Date& Schedule::date(Size i) const {
-        return dates_.at(i);
+        return dates_->at(i);
     }
 
     inline const Date& Schedule::operator[](Size i) const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
-        return dates_.at(i);
+        return dates_->at(i);
         #else
-        return dates_[i];
+        return (*dates_)[i];
         #endif
     }
 
     inline const Date& Schedule::at(Size i) const {
-        return dates_.at(i);
+        return dates_->at(i);
     }
 
     inline const Calendar& Schedule::calendar() const {
@@ -159,11 +225,11 @@ namespace QuantLib {
     }
 
     inline const Date& Schedule::startDate() const {
-        return dates_.front();
+        return dates_->front();
     }
 
     inline const Date& Schedule::endDate() const {
-        return dates_.back();
+        return dates_->back();
     }
 
     inline const Period& Schedule::tenor() const {
@@ -29,6 +29,7 @@
 #include <ql/pricingengines/asian/analytic_cont_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
+#include <ql/pricingengines/asian/mlmc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_strike.hpp>
 #include <ql/pricingengines/asian/fdblackscholesasianengine.hpp>
 #include <ql/experimental/exoticoptions/continuousarithmeticasianlevyengine.hpp>
@@ -688,6 +689,103 @@ void AsianOptionTest::testMCDiscreteArithmeticAveragePrice() {
 }
 
 
+void AsianOptionTest::testMLMCDiscreteArithmeticAveragePrice() {
+
+    BOOST_TEST_MESSAGE(
+           "Testing multilevel Monte Carlo discrete arithmetic "
+           "average-price Asians...");
+
+    SavedSettings backup;
+
+    // data from "Asian Option", Levy, 1997
+    // in "Exotic Options: The State of the Art",
+    // edited by Clewlow, Strickland
+    DiscreteAverageData cases[] = {
+        { Option::Put, 90.0, 87.0, 0.06, 0.025, 0.0, 11.0/12.0, 2,
+          0.13, false, 1.3942835683 },
+        { Option::Put, 90.0, 87.0, 0.06, 0.025, 0.0, 11.0/12.0, 12,
+          0.13, false, 1.6980019214 },
+        { Option::Put, 90.0, 87.0, 0.06, 0.025, 1.0/12.0, 11.0/12.0, 4,
+          0.13, false, 2.0111495205 },
+        { Option::Put, 90.0, 87.0, 0.06, 0.025, 3.0/12.0, 11.0/12.0, 26,
+          0.13, false, 2.88179560417 }
+    };
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.03));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.06));
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    Real tolerance = 0.02;
+    boost::shared_ptr<PricingEngine> engine(
+        new MLMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess,
+                                                         tolerance,
+                                                         Null<Size>(), 42));
+
+    Average::Type averageType = Average::Arithmetic;
+    Real runningSum = 0.0;
+    Size pastFixings = 0;
+    for (Size l=0; l<LENGTH(cases); l++) {
+
+        boost::shared_ptr<StrikedTypePayoff> payoff(new
+            PlainVanillaPayoff(cases[l].type, cases[l].strike));
+
+        Time dt = cases[l].length/(cases[l].fixings-1);
+        std::vector<Date> fixingDates(cases[l].fixings);
+        for (Size i=0; i<cases[l].fixings; i++) {
+            Time t = i*dt + cases[l].first;
+            fixingDates[i] = today + Integer(t*360+0.5);
+        }
+        boost::shared_ptr<Exercise> exercise(new
+            EuropeanExercise(fixingDates[cases[l].fixings-1]));
+
+        spot ->setValue(cases[l].underlying);
+        qRate->setValue(cases[l].dividendYield);
+        rRate->setValue(cases[l].riskFreeRate);
+        vol  ->setValue(cases[l].volatility);
+
+        DiscreteAveragingAsianOption option(averageType, runningSum,
+                                            pastFixings, fixingDates,
+                                            payoff, exercise);
+        option.setPricingEngine(engine);
+
+        Real calculated = option.NPV();
+        Real expected = cases[l].result;
+        if (std::fabs(calculated-expected) > 3.0*tolerance) {
+            REPORT_FAILURE("value", averageType, runningSum, pastFixings,
+                           fixingDates, payoff, exercise, spot->value(),
+                           qRate->value(), rRate->value(), today,
+                           vol->value(), expected, calculated,
+                           3.0*tolerance);
+        }
+
+        Real errorEstimate = option.errorEstimate();
+        Real bias = option.result<Real>("biasEstimate");
+        if (errorEstimate > tolerance/std::sqrt(2.0)
+            || bias > tolerance/std::sqrt(2.0)) {
+            BOOST_ERROR("failed to reach required tolerance"
+                        << "\n    fixings:        " << cases[l].fixings
+                        << "\n    error estimate: " << errorEstimate
+                        << "\n    bias estimate:  " << bias
+                        << "\n    tolerance:      " << tolerance);
+        }
+    }
+}
+
+
 void AsianOptionTest::testMCDiscreteArithmeticAverageStrike() {
 
     BOOST_TEST_MESSAGE(
@@ -1322,6 +1420,8 @@ test_suite* AsianOptionTest::suite() {
         &AsianOptionTest::testMCDiscreteGeometricAveragePrice));
     suite->add(QUANTLIB_TEST_CASE(
         &AsianOptionTest::testMCDiscreteArithmeticAveragePrice));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AsianOptionTest::testMLMCDiscreteArithmeticAveragePrice));
     suite->add(QUANTLIB_TEST_CASE(
         &AsianOptionTest::testMCDiscreteArithmeticAverageStrike));
     suite->add(QUANTLIB_TEST_CASE(
@@ -34,6 +34,7 @@
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/barrier/mlmcbarrierengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/experimental/barrieroption/perturbativebarrieroptionengine.hpp>
 #include <ql/experimental/barrieroption/doublebarrieroption.hpp>
@@ -1298,6 +1299,91 @@ void BarrierOptionTest::testVannaVolgaDoubleBarrierValues() {
 }
 
 
+void BarrierOptionTest::testMLMCBarrierEngine() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing multilevel Monte Carlo barrier engine against analytic values...");
+
+    SavedSettings backup;
+
+    struct MLMCBarrierData {
+        Barrier::Type type;
+        Option::Type optionType;
+        Real barrier;
+        Real rebate;
+    };
+
+    MLMCBarrierData values[] = {
+        { Barrier::DownOut, Option::Call,  90.0, 3.0 },
+        { Barrier::UpOut,   Option::Call, 130.0, 3.0 },
+        { Barrier::DownIn,  Option::Put,   90.0, 3.0 },
+        { Barrier::UpIn,    Option::Put,  110.0, 3.0 }
+    };
+
+    Real strike = 100.0;
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> underlying =
+        boost::make_shared<SimpleQuote>(100.0);
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS =
+        flatVol(today, 0.25, dc);
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        boost::make_shared<BlackScholesMertonProcess>(
+                                      Handle<Quote>(underlying),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS));
+
+    Date exDate = today+360;
+    boost::shared_ptr<Exercise> exercise =
+        boost::make_shared<EuropeanExercise>(exDate);
+
+    Real tolerance = 0.02;
+    boost::shared_ptr<PricingEngine> analyticEngine =
+        boost::make_shared<AnalyticBarrierEngine>(stochProcess);
+    boost::shared_ptr<PricingEngine> mlmcEngine(
+        new MLMCBarrierEngine<PseudoRandom>(stochProcess, 4, tolerance,
+                                            false, Null<Size>(), 42));
+
+    for (Size i=0; i<LENGTH(values); i++) {
+        boost::shared_ptr<StrikedTypePayoff> payoff =
+            boost::make_shared<PlainVanillaPayoff>(values[i].optionType,
+                                                   strike);
+        BarrierOption option(values[i].type, values[i].barrier,
+                             values[i].rebate, payoff, exercise);
+
+        option.setPricingEngine(analyticEngine);
+        Real expected = option.NPV();
+
+        option.setPricingEngine(mlmcEngine);
+        Real calculated = option.NPV();
+        Real errorEstimate = option.errorEstimate();
+        Real bias = option.result<Real>("biasEstimate");
+
+        Real error = std::fabs(calculated-expected);
+        if (error > 3.0*tolerance) {
+            REPORT_FAILURE("value", values[i].type, values[i].barrier,
+                           values[i].rebate, payoff, exercise,
+                           underlying->value(), 0.02, 0.05, today, 0.25,
+                           expected, calculated, error, 3.0*tolerance);
+        }
+        if (errorEstimate > tolerance/std::sqrt(2.0)
+            || bias > tolerance/std::sqrt(2.0)) {
+            BOOST_ERROR("failed to reach required tolerance"
+                        << "\n    barrier type:   "
+                        << barrierTypeToString(values[i].type)
+                        << "\n    error estimate: " << errorEstimate
+                        << "\n    bias estimate:  " << bias
+                        << "\n    tolerance:      " << tolerance);
+        }
+    }
+}
+
+
 test_suite* BarrierOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Barrier option tests");
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testHaugValues));
@@ -1305,6 +1391,7 @@ test_suite* BarrierOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testBeagleholeValues));
     suite->add(QUANTLIB_TEST_CASE(
                         &BarrierOptionTest::testLocalVolAndHestonComparison));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMLMCBarrierEngine));
     return suite;
 }
 
@@ -943,6 +943,110 @@ void BasketOptionTest::testOddSamples() {
     }
 }
 
+void BasketOptionTest::testPathBlocks() {
+
+    BOOST_TEST_MESSAGE("Testing basket options priced on blocks of paths...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+
+    Real spots[] = { 100.0, 95.0, 105.0 };
+    Volatility vols[] = { 0.20, 0.30, 0.25 };
+    std::vector<boost::shared_ptr<StochasticProcess1D> > procs;
+    for (Size i=0; i<LENGTH(spots); ++i) {
+        boost::shared_ptr<Quote> spot(new SimpleQuote(spots[i]));
+        procs.push_back(boost::shared_ptr<StochasticProcess1D>(new
+            BlackScholesMertonProcess(
+                     Handle<Quote>(spot),
+                     Handle<YieldTermStructure>(qTS),
+                     Handle<YieldTermStructure>(rTS),
+                     Handle<BlackVolTermStructure>(
+                                           flatVol(today, vols[i], dc)))));
+    }
+
+    Matrix correlation(3, 3, 1.0);
+    correlation[1][0] = correlation[0][1] = -0.25;
+    correlation[2][0] = correlation[0][2] = 0.25;
+    correlation[2][1] = correlation[1][2] = 0.3;
+    boost::shared_ptr<StochasticProcessArray> process(
+                               new StochasticProcessArray(procs,correlation));
+
+    boost::shared_ptr<PlainVanillaPayoff> payoff(new
+        PlainVanillaPayoff(Option::Call, 100.0));
+    Date exDate = today + 360;
+
+    // the number of samples is not a multiple of the blocks
+    Size samples = 1001, timeSteps = 10;
+    Size blocks[] = { 7, 64 };
+    Real tolerance = 1.0e-12;
+
+    BasketOption europeanOption(basketTypeToPayoff(MaxBasket, payoff),
+                                boost::shared_ptr<Exercise>(
+                                              new EuropeanExercise(exDate)));
+    europeanOption.setPricingEngine(
+        MakeMCEuropeanBasketEngine<PseudoRandom>(process)
+        .withSteps(timeSteps)
+        .withAntitheticVariate()
+        .withSamples(samples)
+        .withSeed(42)
+        .withPathBlock(1));
+    Real expected = europeanOption.NPV();
+
+    for (Size i=0; i<LENGTH(blocks); ++i) {
+        europeanOption.setPricingEngine(
+            MakeMCEuropeanBasketEngine<PseudoRandom>(process)
+            .withSteps(timeSteps)
+            .withAntitheticVariate()
+            .withSamples(samples)
+            .withSeed(42)
+            .withPathBlock(blocks[i]));
+        Real calculated = europeanOption.NPV();
+        if (std::fabs(calculated-expected) > tolerance*expected)
+            BOOST_ERROR("European basket price depends on path block"
+                        << std::setprecision(16)
+                        << "\n    block:      " << blocks[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    BasketOption americanOption(basketTypeToPayoff(MaxBasket, payoff),
+                                boost::shared_ptr<Exercise>(
+                                      new AmericanExercise(today, exDate)));
+    americanOption.setPricingEngine(
+        MakeMCAmericanBasketEngine<PseudoRandom>(process)
+        .withSteps(timeSteps)
+        .withAntitheticVariate()
+        .withSamples(samples)
+        .withCalibrationSamples(samples/2)
+        .withSeed(42)
+        .withPathBlock(1));
+    expected = americanOption.NPV();
+
+    for (Size i=0; i<LENGTH(blocks); ++i) {
+        americanOption.setPricingEngine(
+            MakeMCAmericanBasketEngine<PseudoRandom>(process)
+            .withSteps(timeSteps)
+            .withAntitheticVariate()
+            .withSamples(samples)
+            .withCalibrationSamples(samples/2)
+            .withSeed(42)
+            .withPathBlock(blocks[i]));
+        Real calculated = americanOption.NPV();
+        if (std::fabs(calculated-expected) > tolerance*expected)
+            BOOST_ERROR("American basket price depends on path block"
+                        << std::setprecision(16)
+                        << "\n    block:      " << blocks[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+}
+
 test_suite* BasketOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Basket option tests");
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testEuroTwoValues));
@@ -952,6 +1056,7 @@ test_suite* BasketOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testTavellaValues));
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testOneDAmericanValues));
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testOddSamples));
+    suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testPathBlocks));
 
     return suite;
 }
@@ -32,6 +32,7 @@ class BasketOptionTest {
     static void testTavellaValues();
     static void testOneDAmericanValues();
     static void testOddSamples();
+    static void testPathBlocks();
     static boost::unit_test_framework::test_suite* suite();
 };
 
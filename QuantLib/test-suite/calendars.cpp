@@ -39,6 +39,36 @@
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
+namespace {
+
+    // gives access to the holiday rules, bypassing the cached bitmaps
+    class RuleBasedCalendar : public Calendar {
+      public:
+        explicit RuleBasedCalendar(const Calendar& c) : Calendar(c) {}
+        bool isBusinessDay(const Date& d) const {
+            if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
+                return false;
+            if (impl_->removedHolidays.find(d) !=
+                                           impl_->removedHolidays.end())
+                return true;
+            return impl_->isBusinessDay(d);
+        }
+    };
+
+    void checkCachedBusinessDays(const Calendar& calendar,
+                                 const Date& from, const Date& to,
+                                 const std::string& tag) {
+        RuleBasedCalendar rules(calendar);
+        for (Date d = from; d <= to; ++d) {
+            if (calendar.isBusinessDay(d) != rules.isBusinessDay(d))
+                BOOST_FAIL(calendar.name() << " (" << tag << "): "
+                           << "cached and rule-based calendars "
+                           << "disagree on " << d);
+        }
+    }
+
+}
+
 void CalendarTest::testModifiedCalendars() {
 
     BOOST_TEST_MESSAGE("Testing calendar modification...");
@@ -1004,6 +1034,87 @@ void CalendarTest::testBusinessDaysBetween() {
 }
 
 
+void CalendarTest::testCachedBusinessDays() {
+
+    BOOST_TEST_MESSAGE("Testing cached business-day calculations...");
+
+    Calendar calendar = JointCalendar(TARGET(), UnitedKingdom());
+
+    // brute-force count against the bitmap-based one
+    Date from(28,December,2009), to(3,January,2014);
+    Date d = from;
+    BigInteger expectedDays = 0;
+    for (Integer i=0; i<600; ++i) {
+        if (calendar.isBusinessDay(d+i))
+            ++expectedDays;
+        BigInteger calculated =
+            calendar.businessDaysBetween(from, d+i, true, true);
+        if (calculated != expectedDays)
+            BOOST_FAIL("from " << from << " to " << d+i << ":\n"
+                       << "    calculated: " << calculated << "\n"
+                       << "    expected:   " << expectedDays);
+    }
+
+    // advancing across year boundaries
+    for (Integer n=-800; n<=800; n+=7) {
+        Date expected = from;
+        Integer m = n;
+        while (m > 0) {
+            ++expected;
+            while (calendar.isHoliday(expected))
+                ++expected;
+            --m;
+        }
+        while (m < 0) {
+            --expected;
+            while (calendar.isHoliday(expected))
+                --expected;
+            ++m;
+        }
+        Date calculated = calendar.advance(from, n, Days);
+        if (calculated != expected)
+            BOOST_FAIL("advancing " << from << " by " << n << " days:\n"
+                       << "    calculated: " << calculated << "\n"
+                       << "    expected:   " << expected);
+    }
+
+    // modifying a component must be seen by the joint calendar
+    Date d1(27,April,2010);
+    QL_REQUIRE(calendar.isBusinessDay(d1),
+               "wrong assumption---correct the test");
+    Calendar uk = UnitedKingdom();
+    uk.addHoliday(d1);
+    bool isHoliday = calendar.isHoliday(d1);
+    uk.removeHoliday(d1);
+    if (!isHoliday)
+        BOOST_FAIL(d1 << " still a business day for joint calendar");
+    if (calendar.isHoliday(d1))
+        BOOST_FAIL(d1 << " still a holiday for joint calendar");
+
+    // cached bitmaps against the holiday rules
+    Calendar calendars[] = { TARGET(), UnitedKingdom(), Japan(),
+                             UnitedStates(UnitedStates::NYSE),
+                             Brazil(), Italy(),
+                             JointCalendar(TARGET(), UnitedStates()) };
+    Date start(1,January,2005), end(31,December,2016);
+    for (Size i=0; i<LENGTH(calendars); ++i)
+        checkCachedBusinessDays(calendars[i], start, end, "initial");
+
+    Calendar target = TARGET();
+    Date christmas(25,December,2012), weekday(11,July,2012);
+    target.removeHoliday(christmas);
+    target.addHoliday(weekday);
+    for (Size i=0; i<LENGTH(calendars); ++i)
+        checkCachedBusinessDays(calendars[i], start, end, "modified");
+    target.addHoliday(christmas);
+    target.removeHoliday(weekday);
+    for (Size i=0; i<LENGTH(calendars); ++i)
+        checkCachedBusinessDays(calendars[i], start, end, "restored");
+    if (!target.isHoliday(christmas) || target.isHoliday(weekday))
+        BOOST_FAIL("TARGET holidays not restored");
+}
+
+
 void CalendarTest::testBespokeCalendars() {
 
     BOOST_TEST_MESSAGE("Testing bespoke calendars...");
@@ -1150,6 +1261,7 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testCachedBusinessDays));
 
     return suite;
 }
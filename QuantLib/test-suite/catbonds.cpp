@@ -41,6 +41,7 @@
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -668,6 +669,110 @@ void CatBondTest::testCatBondWithGeneratedEventsProportional() {
     BOOST_CHECK_LT(riskFreeYield, yield);
 }
 
+void CatBondTest::testCachedEventPaths() {
+    BOOST_TEST_MESSAGE("Testing cat bond pricing on cached event paths...");
+
+    CommonVars vars;
+
+    Date today(22,November,2004);
+    Settings::instance().evaluationDate() = today;
+
+    Natural settlementDays = 1;
+
+    Handle<YieldTermStructure> riskFreeRate(flatRate(today,0.025,Actual360()));
+    Handle<YieldTermStructure> discountCurve(flatRate(today,0.03,Actual360()));
+
+    shared_ptr<IborIndex> index(new USDLibor(6*Months, riskFreeRate));
+    Natural fixingDays = 1;
+
+    Real tolerance = 1.0e-10;
+
+    shared_ptr<IborCouponPricer> pricer(new
+        BlackIborCouponPricer(Handle<OptionletVolatilityStructure>()));
+
+    Schedule sch(Date(30,November,2004),
+                 Date(30,November,2008),
+                 Period(Semiannual),
+                 UnitedStates(UnitedStates::GovernmentBond),
+                 ModifiedFollowing, ModifiedFollowing,
+                 DateGeneration::Backward, false);
+
+    boost::shared_ptr<CatRisk> betaCatRisk(new BetaRisk(5000, 50, 500, 500));
+    boost::shared_ptr<CachedCatRisk> cachedCatRisk(
+                                             new CachedCatRisk(betaCatRisk));
+
+    boost::shared_ptr<EventPaymentOffset> paymentOffset(new NoOffset());
+    boost::shared_ptr<NotionalRisk> notionalRisk(new ProportionalNotionalRisk(paymentOffset, 500, 1500));
+
+    FloatingCatBond catBond(settlementDays, vars.faceAmount, sch,
+                           index, ActualActual(ActualActual::ISMA),
+                           notionalRisk,
+                           ModifiedFollowing, fixingDays,
+                           std::vector<Rate>(), std::vector<Spread>(),
+                           std::vector<Rate>(), std::vector<Rate>(),
+                           false,
+                           100.0, Date(30,November,2004));
+    setCouponPricer(catBond.cashflows(),pricer);
+
+    catBond.setPricingEngine(shared_ptr<PricingEngine>(
+                  new MonteCarloCatBondEngine(betaCatRisk, discountCurve)));
+    Real price = catBond.cleanPrice();
+    Real expectedLoss = catBond.expectedLoss();
+
+    catBond.setPricingEngine(shared_ptr<PricingEngine>(
+                new MonteCarloCatBondEngine(cachedCatRisk, discountCurve)));
+    Real cachedPrice = catBond.cleanPrice();
+    Real cachedExpectedLoss = catBond.expectedLoss();
+
+    BOOST_CHECK_CLOSE(price, cachedPrice, tolerance);
+    BOOST_CHECK_CLOSE(expectedLoss, cachedExpectedLoss, tolerance);
+
+    // a second bond on the same period reuses the stored paths
+    Date start = std::max(Date(30,November,2004), catBond.settlementDate());
+    Date end = catBond.cashflows().back()->date();
+    boost::shared_ptr<CatPathSet> paths = cachedCatRisk->paths(start, end);
+    BOOST_CHECK_EQUAL(paths->size(), Size(10000));
+
+    FloatingCatBond otherBond(settlementDays, vars.faceAmount, sch,
+                              index, ActualActual(ActualActual::ISMA),
+                              boost::shared_ptr<NotionalRisk>(
+                                  new DigitalNotionalRisk(paymentOffset, 1000)),
+                              ModifiedFollowing, fixingDays,
+                              std::vector<Rate>(), std::vector<Spread>(),
+                              std::vector<Rate>(), std::vector<Rate>(),
+                              false,
+                              100.0, Date(30,November,2004));
+    setCouponPricer(otherBond.cashflows(),pricer);
+    otherBond.setPricingEngine(shared_ptr<PricingEngine>(
+                new MonteCarloCatBondEngine(cachedCatRisk, discountCurve)));
+    otherBond.cleanPrice();
+    BOOST_CHECK(cachedCatRisk->paths(start, end) == paths);
+
+    // concurrent requests for the same period share a single path set
+    boost::shared_ptr<CachedCatRisk> sharedCatRisk(
+                                             new CachedCatRisk(betaCatRisk));
+    std::vector<boost::shared_ptr<CatPathSet> > sharedPaths(8);
+    #pragma omp parallel for
+    for (long i=0; i<long(sharedPaths.size()); ++i)
+        sharedPaths[i] = sharedCatRisk->paths(start, end);
+    for (Size i=0; i<sharedPaths.size(); ++i)
+        BOOST_CHECK(sharedPaths[i] == sharedCatRisk->paths(start, end));
+
+    // paths read back from a binary catalogue give the same price
+    std::stringstream catalogue;
+    paths->save(catalogue);
+    boost::shared_ptr<CachedCatRisk> catalogueRisk(
+                              new CachedCatRisk(boost::shared_ptr<CatRisk>()));
+    catalogueRisk->add(boost::shared_ptr<CatPathSet>(
+                                                 new CatPathSet(catalogue)));
+
+    catBond.setPricingEngine(shared_ptr<PricingEngine>(
+                new MonteCarloCatBondEngine(catalogueRisk, discountCurve)));
+    Real cataloguePrice = catBond.cleanPrice();
+
+    BOOST_CHECK_CLOSE(price, cataloguePrice, tolerance);
+}
+
 test_suite* CatBondTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("CatBond tests");
 
@@ -680,5 +785,6 @@ test_suite* CatBondTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testCatBondWithDoomOnceInTenYears));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testCatBondWithDoomOnceInTenYearsProportional));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testCatBondWithGeneratedEventsProportional));
+    suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testCachedEventPaths));
     return suite;
 }
@@ -33,6 +33,7 @@ class CatBondTest {
     static void testCatBondWithDoomOnceInTenYears();
     static void testCatBondWithDoomOnceInTenYearsProportional();
     static void testCatBondWithGeneratedEventsProportional();
+    static void testCachedEventPaths();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -494,10 +494,97 @@ void CmsTest::testParity() {
     }
 }
 
+void CmsTest::testPricerCache() {
+
+    BOOST_TEST_MESSAGE("Testing reuse of replication results across coupons...");
+
+    CommonVars vars;
+
+    shared_ptr<SwapIndex> swapIndex(new
+        EuriborSwapIsdaFixA(10*Years,
+                            vars.iborIndex->forwardingTermStructure()));
+    Date startDate = vars.termStructure->referenceDate() + 5*Years;
+    Date paymentDate = startDate + 1*Years;
+    Date endDate = paymentDate;
+    Real nominal = 1.0;
+    Rate cap = 0.06;
+    Rate infiniteFloor = Null<Real>();
+    Real gearing = 1.0;
+    Spread spread = 0.0;
+    CappedFlooredCmsCoupon first(paymentDate, nominal,
+                                 startDate, endDate,
+                                 swapIndex->fixingDays(), swapIndex,
+                                 gearing, spread,
+                                 cap, infiniteFloor,
+                                 startDate, endDate,
+                                 vars.iborIndex->dayCounter());
+    CappedFlooredCmsCoupon second(paymentDate, 2.0*nominal,
+                                  startDate, endDate,
+                                  swapIndex->fixingDays(), swapIndex,
+                                  gearing, spread,
+                                  cap, infiniteFloor,
+                                  startDate, endDate,
+                                  vars.iborIndex->dayCounter());
+
+    Handle<Quote> zeroMeanRev(shared_ptr<Quote>(new SimpleQuote(0.0)));
+    Real tol = 1.0e-12;
+
+    for (Size j=0; j<vars.yieldCurveModels.size(); ++j) {
+        bool linearTsr = j==vars.yieldCurveModels.size()-1;
+        std::vector<shared_ptr<CmsCouponPricer> > pricers(2);
+        pricers[0] = vars.numericalPricers[j];
+        pricers[1] = vars.analyticPricers[j];
+        for (Size k=0; k<pricers.size(); ++k) {
+            vars.termStructure.linkTo(
+                flatRate(vars.termStructure->referenceDate(), 0.05,
+                         Actual365Fixed()));
+            first.setPricer(pricers[k]);
+            second.setPricer(pricers[k]);
+
+            // the second coupon reuses the results of the first one
+            Rate firstRate = first.rate();
+            Rate secondRate = second.rate();
+            if (std::fabs(firstRate-secondRate) > tol)
+                BOOST_FAIL("\nYieldCurve Model: " << vars.yieldCurveModels[j] <<
+                           (k==0 ? "\nNumerical Pricer" : "\nAnalytic Pricer") <<
+                           (linearTsr && k==0 ? " (Linear TSR Model)" : "") <<
+                           "\nfirst coupon:     " << io::rate(firstRate) <<
+                           "\nsecond coupon:    " << io::rate(secondRate));
+
+            // results must be recomputed after the curve changed
+            vars.termStructure.linkTo(
+                flatRate(vars.termStructure->referenceDate(), 0.04,
+                         Actual365Fixed()));
+            shared_ptr<CmsCouponPricer> freshPricer;
+            if (k == 1)
+                freshPricer = shared_ptr<CmsCouponPricer>(new
+                    AnalyticHaganPricer(vars.atmVol, vars.yieldCurveModels[j],
+                                        zeroMeanRev));
+            else if (linearTsr)
+                freshPricer = shared_ptr<CmsCouponPricer>(new
+                    LinearTsrPricer(vars.atmVol, zeroMeanRev));
+            else
+                freshPricer = shared_ptr<CmsCouponPricer>(new
+                    NumericHaganPricer(vars.atmVol, vars.yieldCurveModels[j],
+                                       zeroMeanRev));
+            Rate cachedRate = second.rate();
+            second.setPricer(freshPricer);
+            Rate expectedRate = second.rate();
+            if (std::fabs(cachedRate-expectedRate) > tol)
+                BOOST_FAIL("\nYieldCurve Model: " << vars.yieldCurveModels[j] <<
+                           (k==0 ? "\nNumerical Pricer" : "\nAnalytic Pricer") <<
+                           (linearTsr && k==0 ? " (Linear TSR Model)" : "") <<
+                           "\ncached pricer:    " << io::rate(cachedRate) <<
+                           "\nfresh pricer:     " << io::rate(expectedRate));
+        }
+    }
+}
+
 test_suite* CmsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cms tests");
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCmsSwap));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testParity));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testPricerCache));
     return suite;
 }
@@ -31,6 +31,7 @@
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <iomanip>
 #include <iostream>
@@ -558,6 +559,126 @@ void CreditDefaultSwapTest::testFairUpfront() {
 }
 
 
+void CreditDefaultSwapTest::testRelinkedCurves() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing credit-default swap engines after relinking curves...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(9,June,2006);
+    Date today = Settings::instance().evaluationDate();
+    Calendar calendar = TARGET();
+
+    boost::shared_ptr<SimpleQuote> hazardRate(new SimpleQuote(0.01234));
+    RelinkableHandle<DefaultProbabilityTermStructure> probabilityCurve;
+    probabilityCurve.linkTo(
+        boost::shared_ptr<DefaultProbabilityTermStructure>(
+                   new FlatHazardRate(0, calendar, Handle<Quote>(hazardRate),
+                                      Actual360())));
+    RelinkableHandle<YieldTermStructure> discountCurve;
+    discountCurve.linkTo(boost::shared_ptr<YieldTermStructure>(
+                            new FlatForward(today,0.06,Actual360())));
+
+    Date issueDate = calendar.advance(today, -1, Years);
+    Date maturity = calendar.advance(issueDate, 10, Years);
+    BusinessDayConvention convention = ModifiedFollowing;
+    Schedule schedule(issueDate, maturity, Period(Semiannual), calendar,
+                      convention, convention, DateGeneration::Forward, false);
+
+    Real recoveryRate = 0.4;
+    CreditDefaultSwap cds(Protection::Seller, 10000.0, 0.0120,
+                          schedule, convention, Actual360(), true, true);
+
+    // the engines store per-period data computed from the curves; any
+    // change in the curves must discard them
+    for (Size i=0; i<2; ++i) {
+        std::string name = (i == 0 ? "mid-point" : "integral");
+        boost::shared_ptr<PricingEngine> engine;
+        if (i == 0)
+            engine = boost::shared_ptr<PricingEngine>(
+                new MidPointCdsEngine(probabilityCurve, recoveryRate,
+                                      discountCurve));
+        else
+            engine = boost::shared_ptr<PricingEngine>(
+                new IntegralCdsEngine(1*Weeks, probabilityCurve,
+                                      recoveryRate, discountCurve));
+        cds.setPricingEngine(engine);
+        Real initialNpv = cds.NPV();
+
+        // relink both curves, also changing the day counters and
+        // therefore the times of the stored periods
+        Handle<Quote> newHazardRate(
+                       boost::shared_ptr<Quote>(new SimpleQuote(0.02)));
+        boost::shared_ptr<DefaultProbabilityTermStructure> newProbability(
+                new FlatHazardRate(today, newHazardRate, Actual365Fixed()));
+        boost::shared_ptr<YieldTermStructure> newDiscount(
+                new FlatForward(today, 0.03, Actual365Fixed()));
+        probabilityCurve.linkTo(newProbability);
+        discountCurve.linkTo(newDiscount);
+
+        Real relinkedNpv = cds.NPV();
+
+        Handle<DefaultProbabilityTermStructure> freshProbability(
+                                                             newProbability);
+        Handle<YieldTermStructure> freshDiscount(newDiscount);
+        CreditDefaultSwap freshCds(Protection::Seller, 10000.0, 0.0120,
+                                   schedule, convention, Actual360(),
+                                   true, true);
+        if (i == 0)
+            freshCds.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new MidPointCdsEngine(freshProbability, recoveryRate,
+                                      freshDiscount)));
+        else
+            freshCds.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new IntegralCdsEngine(1*Weeks, freshProbability,
+                                      recoveryRate, freshDiscount)));
+        Real expectedNpv = freshCds.NPV();
+
+        if (relinkedNpv == initialNpv)
+            BOOST_ERROR("NPV unchanged after relinking curves with "
+                        << name << " engine\n"
+                        << std::setprecision(10)
+                        << "    NPV: " << relinkedNpv);
+        if (std::fabs(relinkedNpv - expectedNpv) > 1.0e-10)
+            BOOST_ERROR("Failed to reproduce NPV of fresh " << name
+                        << " engine after relinking curves\n"
+                        << std::setprecision(10)
+                        << "    calculated NPV: " << relinkedNpv << "\n"
+                        << "    expected NPV:   " << expectedNpv);
+
+        // relinking back must restore the initial value
+        probabilityCurve.linkTo(
+            boost::shared_ptr<DefaultProbabilityTermStructure>(
+                   new FlatHazardRate(0, calendar, Handle<Quote>(hazardRate),
+                                      Actual360())));
+        discountCurve.linkTo(boost::shared_ptr<YieldTermStructure>(
+                            new FlatForward(today,0.06,Actual360())));
+        Real restoredNpv = cds.NPV();
+        if (std::fabs(restoredNpv - initialNpv) > 1.0e-10)
+            BOOST_ERROR("Failed to restore NPV with " << name
+                        << " engine after relinking original curves\n"
+                        << std::setprecision(10)
+                        << "    calculated NPV: " << restoredNpv << "\n"
+                        << "    expected NPV:   " << initialNpv);
+
+        // changing the underlying quote must also be picked up
+        hazardRate->setValue(0.015);
+        Real bumpedNpv = cds.NPV();
+        hazardRate->setValue(0.01234);
+        if (bumpedNpv == initialNpv)
+            BOOST_ERROR("NPV unchanged after changing hazard rate with "
+                        << name << " engine");
+        if (std::fabs(cds.NPV() - initialNpv) > 1.0e-10)
+            BOOST_ERROR("Failed to restore NPV with " << name
+                        << " engine after restoring hazard rate\n"
+                        << std::setprecision(10)
+                        << "    calculated NPV: " << cds.NPV() << "\n"
+                        << "    expected NPV:   " << initialNpv);
+    }
+}
+
+
 test_suite* CreditDefaultSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Credit-default swap tests");
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testCachedValue));
@@ -567,6 +688,8 @@ test_suite* CreditDefaultSwapTest::suite() {
                               &CreditDefaultSwapTest::testImpliedHazardRate));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairUpfront));
+    suite->add(QUANTLIB_TEST_CASE(
+                                 &CreditDefaultSwapTest::testRelinkedCurves));
     return suite;
 }
 
@@ -22,6 +22,8 @@
 #include "daycounters.hpp"
 #include "utilities.hpp"
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/one.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
 #include <ql/time/daycounters/business252.hpp>
@@ -422,6 +424,59 @@ void DayCounterTest::testThirty360_EurobondBasis() {
     }
 }
 
+void DayCounterTest::testYearFractions() {
+
+    BOOST_TEST_MESSAGE("Testing batch year-fraction calculation...");
+
+    std::vector<DayCounter> dayCounters;
+    dayCounters.push_back(Actual360());
+    dayCounters.push_back(Actual360(true));
+    dayCounters.push_back(Actual365Fixed());
+    dayCounters.push_back(ActualActual(ActualActual::ISDA));
+    dayCounters.push_back(ActualActual(ActualActual::ISMA));
+    dayCounters.push_back(ActualActual(ActualActual::AFB));
+    dayCounters.push_back(Thirty360(Thirty360::BondBasis));
+    dayCounters.push_back(Thirty360(Thirty360::EurobondBasis));
+    dayCounters.push_back(Thirty360(Thirty360::Italian));
+    dayCounters.push_back(SimpleDayCounter());
+
+    // end-of-month and end-of-February references exercise the
+    // day adjustments of the 30/360 conventions
+    std::vector<Date> references;
+    references.push_back(Date(28,February,2008));
+    references.push_back(Date(31,January,2011));
+    references.push_back(Date(30,April,2010));
+    references.push_back(Date(15,June,2009));
+
+    for (Size k=0; k<references.size(); ++k) {
+        Date reference = references[k];
+        std::vector<Date> dates;
+        for (Integer i=-400; i<=4000; i+=13)
+            dates.push_back(reference + i);
+        for (Integer i=1; i<=120; ++i)
+            dates.push_back(Date::endOfMonth(reference + i*Months));
+
+        for (Size i=0; i<dayCounters.size(); ++i) {
+            std::vector<Time> calculated =
+                dayCounters[i].yearFractions(reference, dates);
+            if (calculated.size() != dates.size())
+                BOOST_FAIL(dayCounters[i].name() << ": "
+                           << calculated.size() << " year fractions returned for "
+                           << dates.size() << " dates");
+            for (Size j=0; j<dates.size(); ++j) {
+                Time expected = dayCounters[i].yearFraction(reference, dates[j]);
+                if (calculated[j] != expected)
+                    BOOST_ERROR(dayCounters[i].name()
+                                << " from " << reference
+                                << " to " << dates[j] << ":\n"
+                                << std::setprecision(12)
+                                << "    calculated: " << calculated[j] << "\n"
+                                << "    expected:   " << expected);
+            }
+        }
+    }
+}
+
 test_suite* DayCounterTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Day counter tests");
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testActualActual));
@@ -430,6 +485,7 @@ test_suite* DayCounterTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_BondBasis));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_EurobondBasis));
+    suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testYearFractions));
     return suite;
 }
 
@@ -33,6 +33,7 @@ class DayCounterTest {
     static void testBusiness252();
     static void testThirty360_BondBasis();
     static void testThirty360_EurobondBasis();
+    static void testYearFractions();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -1265,6 +1265,57 @@ void EuropeanOptionTest::testQmcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testRqmcEngines() {
+
+    BOOST_TEST_MESSAGE("Testing randomized Quasi Monte Carlo European "
+                       "engines against analytic results...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.03));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.06));
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Call, 95.0));
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(today + 360));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                      new AnalyticEuropeanEngine(process)));
+    Real expected = option.NPV();
+
+    Real tolerance = 0.005;
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<RandomizedLowDiscrepancy>(process)
+        .withSteps(1)
+        .withAbsoluteTolerance(tolerance)
+        .withSeed(42));
+    Real calculated = option.NPV();
+    Real errorEstimate = option.errorEstimate();
+
+    if (errorEstimate > tolerance)
+        BOOST_ERROR("failed to reach required tolerance"
+                    << "\n    error estimate: " << errorEstimate
+                    << "\n    tolerance:      " << tolerance);
+    if (std::fabs(calculated - expected) > 3.0*errorEstimate)
+        BOOST_ERROR("failed to reproduce analytic price"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error estimate: " << errorEstimate);
+}
+
 void EuropeanOptionTest::testFFTEngines() {
 
     BOOST_TEST_MESSAGE("Testing FFT European engines "
@@ -1537,6 +1588,7 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testRqmcEngines));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
@@ -0,0 +1,275 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include "fittedbonddiscountcurve.hpp"
+#include "utilities.hpp"
+#include <ql/termstructures/yield/fittedbonddiscountcurve.hpp>
+#include <ql/termstructures/yield/nonlinearfittingmethods.hpp>
+#include <ql/termstructures/yield/bondhelpers.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/pricingengines/bond/discountingbondengine.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/simpledaycounter.hpp>
+#include <ql/utilities/dataformatters.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+using boost::shared_ptr;
+
+namespace {
+
+    struct CommonVars {
+        // global data
+        Date today;
+        Calendar calendar;
+        DayCounter dayCounter;
+        Handle<YieldTermStructure> marketCurve;
+        std::vector<shared_ptr<SimpleQuote> > quotes;
+        std::vector<shared_ptr<BondHelper> > helpers;
+
+        // cleanup
+        SavedSettings backup;
+
+        // setup
+        CommonVars() {
+            calendar = NullCalendar();
+            today = Date(15, January, 2014);
+            Settings::instance().evaluationDate() = today;
+            dayCounter = SimpleDayCounter();
+
+            // the quoted prices are generated off a flat curve, which
+            // the Nelson-Siegel form can reproduce exactly
+            marketCurve = Handle<YieldTermStructure>(
+                    shared_ptr<YieldTermStructure>(
+                           new FlatForward(today, 0.04, dayCounter,
+                                           Continuous, Annual)));
+            shared_ptr<PricingEngine> engine(
+                                   new DiscountingBondEngine(marketCurve));
+
+            Integer lengths[] = { 2, 4, 6, 8, 10, 12, 14, 16, 18, 20 };
+            Rate coupons[] = { 0.0200, 0.0250, 0.0300, 0.0350, 0.0400,
+                               0.0425, 0.0450, 0.0475, 0.0500, 0.0525 };
+
+            for (Size i=0; i<LENGTH(lengths); ++i) {
+                Date maturity = calendar.advance(today, lengths[i]*Years);
+                Schedule schedule(today, maturity, Period(Annual), calendar,
+                                  Unadjusted, Unadjusted,
+                                  DateGeneration::Backward, false);
+                shared_ptr<SimpleQuote> quote(new SimpleQuote(100.0));
+                shared_ptr<BondHelper> helper(
+                      new FixedRateBondHelper(Handle<Quote>(quote), 0, 100.0,
+                                              schedule,
+                                              std::vector<Rate>(1,coupons[i]),
+                                              dayCounter, Unadjusted));
+                helper->bond()->setPricingEngine(engine);
+                quote->setValue(helper->bond()->cleanPrice());
+                quotes.push_back(quote);
+                helpers.push_back(helper);
+            }
+        }
+    };
+
+    // the derived fitting methods make size() private
+    Size coefficients(const FittedBondDiscountCurve::FittingMethod& method) {
+        return method.size();
+    }
+
+    void checkGradient(const std::string& name,
+                       const FittedBondDiscountCurve::FittingMethod& method,
+                       const Array& x) {
+
+        Time times[] = { 0.25, 1.0, 2.5, 5.0, 7.5, 12.0, 20.0 };
+        Real tolerance = 1.0e-7;
+
+        for (Size i=0; i<LENGTH(times); ++i) {
+            Array gradient = method.discountGradient(x, times[i]);
+            if (gradient.size() != x.size())
+                BOOST_FAIL(name << ": gradient has size " << gradient.size()
+                           << " instead of " << x.size());
+            Array y = x;
+            for (Size j=0; j<x.size(); ++j) {
+                Real h = 1.0e-6 * std::max(1.0, std::fabs(x[j]));
+                y[j] = x[j] + h;
+                DiscountFactor up = method.discount(y, times[i]);
+                y[j] = x[j] - h;
+                DiscountFactor down = method.discount(y, times[i]);
+                y[j] = x[j];
+                Real expected = (up - down) / (2.0*h);
+                if (std::fabs(gradient[j] - expected) > tolerance)
+                    BOOST_ERROR(name << ": wrong derivative of the "
+                                "discount function at t = " << times[i]
+                                << " w.r.t. the " << io::ordinal(j+1)
+                                << " coefficient"
+                                << std::setprecision(10)
+                                << "\n    analytic:           " << gradient[j]
+                                << "\n    finite differences: " << expected
+                                << "\n    tolerance:          " << tolerance);
+            }
+        }
+    }
+
+}
+
+
+void FittedBondDiscountCurveTest::testGradients() {
+
+    BOOST_TEST_MESSAGE("Testing gradients of fitted discount functions...");
+
+    ExponentialSplinesFitting exponentialSplines;
+    Array x(coefficients(exponentialSplines));
+    for (Size i=0; i<x.size()-1; ++i)
+        x[i] = 0.05 * (Real(i%3) - 1.0);
+    x[x.size()-1] = 0.1;
+    checkGradient("exponential splines", exponentialSplines, x);
+
+    SimplePolynomialFitting simplePolynomial(3);
+    x = Array(coefficients(simplePolynomial));
+    x[0] = -0.03;
+    x[1] = 0.001;
+    x[2] = -0.00002;
+    checkGradient("simple polynomial", simplePolynomial, x);
+
+    NelsonSiegelFitting nelsonSiegel;
+    x = Array(coefficients(nelsonSiegel));
+    x[0] = 0.04;
+    x[1] = -0.01;
+    x[2] = 0.02;
+    x[3] = 0.5;
+    checkGradient("Nelson-Siegel", nelsonSiegel, x);
+
+    SvenssonFitting svensson;
+    x = Array(coefficients(svensson));
+    x[0] = 0.04;
+    x[1] = -0.01;
+    x[2] = 0.02;
+    x[3] = 0.015;
+    x[4] = 0.5;
+    x[5] = 0.15;
+    checkGradient("Svensson", svensson, x);
+
+    Time knots[] = { -30.0, -20.0, 0.0, 5.0, 10.0, 15.0,
+                     20.0, 25.0, 30.0, 40.0, 50.0 };
+    std::vector<Time> knotVector(knots, knots + LENGTH(knots));
+    for (Size k=0; k<2; ++k) {
+        bool constrainAtZero = (k == 0);
+        CubicBSplinesFitting cubicBSplines(knotVector, constrainAtZero);
+        x = Array(coefficients(cubicBSplines));
+        for (Size i=0; i<x.size(); ++i)
+            x[i] = 1.0 - 0.05*i;
+        checkGradient(constrainAtZero ?
+                      "constrained cubic B-splines" :
+                      "unconstrained cubic B-splines",
+                      cubicBSplines, x);
+    }
+}
+
+
+void FittedBondDiscountCurveTest::testMultistart() {
+
+    BOOST_TEST_MESSAGE("Testing multistart fitting of bond curves...");
+
+    CommonVars vars;
+
+    NelsonSiegelFitting nelsonSiegel;
+    Real accuracy = 1.0e-10;
+    Size maxEvaluations = 10000;
+
+    Array guess(4);
+    guess[0] = 0.03;
+    guess[1] = 0.0;
+    guess[2] = 0.0;
+    guess[3] = 0.5;
+
+    FittedBondDiscountCurve singleStart(vars.today, vars.helpers,
+                                        vars.dayCounter, nelsonSiegel,
+                                        accuracy, maxEvaluations, guess);
+    Array expected = singleStart.fitResults().solution();
+    Real expectedCost = singleStart.fitResults().minimumCostValue();
+
+    // the starting points are optimized independently, so repeating
+    // the same one must reproduce the single-start fit exactly
+    std::vector<Array> sameGuesses(3, guess);
+    FittedBondDiscountCurve repeated(vars.today, vars.helpers,
+                                     vars.dayCounter, nelsonSiegel,
+                                     accuracy, maxEvaluations, guess,
+                                     1.0, sameGuesses);
+    Array calculated = repeated.fitResults().solution();
+    if (calculated.size() != expected.size())
+        BOOST_FAIL("repeated multistart fit returned " << calculated.size()
+                   << " coefficients instead of " << expected.size());
+    for (Size i=0; i<expected.size(); ++i) {
+        if (calculated[i] != expected[i])
+            BOOST_ERROR("repeated multistart fit differs from "
+                        "single-start fit for the " << io::ordinal(i+1)
+                        << " coefficient" << std::setprecision(16)
+                        << "\n    single start: " << expected[i]
+                        << "\n    multistart:   " << calculated[i]);
+    }
+    if (repeated.fitResults().minimumCostValue() != expectedCost)
+        BOOST_ERROR("repeated multistart fit has a different cost"
+                    << std::setprecision(16)
+                    << "\n    single start: " << expectedCost
+                    << "\n    multistart:   "
+                    << repeated.fitResults().minimumCostValue());
+
+    // further starting points can only improve the fit
+    std::vector<Array> otherGuesses;
+    Array other(4);
+    other[0] = 0.05; other[1] = 0.01; other[2] = -0.01; other[3] = 1.0;
+    otherGuesses.push_back(other);
+    other[0] = 0.02; other[1] = -0.02; other[2] = 0.02; other[3] = 0.2;
+    otherGuesses.push_back(other);
+    shared_ptr<FittedBondDiscountCurve> multistart(
+                  new FittedBondDiscountCurve(vars.today, vars.helpers,
+                                              vars.dayCounter, nelsonSiegel,
+                                              accuracy, maxEvaluations, guess,
+                                              1.0, otherGuesses));
+    if (multistart->fitResults().minimumCostValue() > expectedCost)
+        BOOST_ERROR("multistart fit worse than single-start fit"
+                    << std::setprecision(16)
+                    << "\n    single start: " << expectedCost
+                    << "\n    multistart:   "
+                    << multistart->fitResults().minimumCostValue());
+
+    // the fitted curve must reprice the bonds, which checks the cash
+    // flows and prices cached by the cost function against the bonds
+    Handle<YieldTermStructure> fittedCurve(multistart);
+    shared_ptr<PricingEngine> engine(new DiscountingBondEngine(fittedCurve));
+    Real tolerance = 1.0e-3;
+    for (Size i=0; i<vars.helpers.size(); ++i) {
+        shared_ptr<Bond> bond = vars.helpers[i]->bond();
+        bond->setPricingEngine(engine);
+        Real price = bond->cleanPrice();
+        if (std::fabs(price - vars.quotes[i]->value()) > tolerance)
+            BOOST_ERROR("failed to reprice " << io::ordinal(i+1)
+                        << " bond with the fitted curve"
+                        << std::setprecision(8)
+                        << "\n    quoted price:  " << vars.quotes[i]->value()
+                        << "\n    fitted price:  " << price
+                        << "\n    tolerance:     " << tolerance);
+    }
+}
+
+
+test_suite* FittedBondDiscountCurveTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Fitted bond discount curve tests");
+    suite->add(QUANTLIB_TEST_CASE(&FittedBondDiscountCurveTest::testGradients));
+    suite->add(QUANTLIB_TEST_CASE(&FittedBondDiscountCurveTest::testMultistart));
+    return suite;
+}
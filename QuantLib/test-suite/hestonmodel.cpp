@@ -38,6 +38,7 @@
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/pricingengines/vanilla/mlmceuropeanhestonengine.hpp>
 #include <ql/experimental/exoticoptions/analyticpdfhestonengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -509,6 +510,63 @@ void HestonModelTest::testMcVsCached() {
     }
 }
 
+void HestonModelTest::testMultilevelMcVsAnalytic() {
+    BOOST_TEST_MESSAGE(
+        "Testing multilevel Monte Carlo Heston engine against analytic...");
+
+    SavedSettings backup;
+
+    Date settlementDate(1, January, 2014);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    DayCounter dayCounter = Actual365Fixed();
+    Date exerciseDate = settlementDate + 1*Years;
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Call, 100));
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exerciseDate));
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<HestonProcess> process(new HestonProcess(
+                   riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.04, 0.3, -0.7));
+
+    VanillaOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new AnalyticHestonEngine(
+                      boost::shared_ptr<HestonModel>(new HestonModel(process)),
+                      192)));
+    Real expected = option.NPV();
+
+    Real tolerance = 0.05;
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new MLMCEuropeanHestonEngine<PseudoRandom>(process, 2, tolerance,
+                                                   Null<Size>(), 1234)));
+
+    Real calculated = option.NPV();
+    Real errorEstimate = option.errorEstimate();
+    Real bias = option.result<Real>("biasEstimate");
+
+    if (std::fabs(calculated - expected) > 3.0*tolerance) {
+        BOOST_ERROR("Failed to reproduce analytic price"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    tolerance:  " << tolerance);
+    }
+
+    if (errorEstimate > tolerance/std::sqrt(2.0)
+        || bias > tolerance/std::sqrt(2.0)) {
+        BOOST_ERROR("failed to reach required tolerance"
+                    << "\n    error estimate: " << errorEstimate
+                    << "\n    bias estimate:  " << bias
+                    << "\n    tolerance:      " << tolerance);
+    }
+}
+
 void HestonModelTest::testFdBarrierVsCached() {
     BOOST_TEST_MESSAGE("Testing FD barrier Heston engine against cached values...");
 
@@ -1504,6 +1562,8 @@ test_suite* HestonModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdVanillaVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMcVsCached));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testMultilevelMcVsAnalytic));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testAnalyticPiecewiseTimeDependent));
     suite->add(QUANTLIB_TEST_CASE(
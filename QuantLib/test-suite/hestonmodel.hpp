@@ -33,6 +33,7 @@ class HestonModelTest {
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
     static void testMcVsCached();
+    static void testMultilevelMcVsAnalytic();
     static void testFdBarrierVsCached();    
     static void testFdVanillaVsCached();    
     static void testDifferentIntegrals();
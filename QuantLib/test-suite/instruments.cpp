@@ -20,6 +20,27 @@
 #include "instruments.hpp"
 #include "utilities.hpp"
 #include <ql/instruments/stock.hpp>
+#include <ql/instruments/compositeinstrument.hpp>
+#include <ql/instruments/portfolio.hpp>
+#include <ql/instruments/bonds/fixedratebond.hpp>
+#include <ql/instruments/bonds/floatingratebond.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/pricingengines/bond/discountingbondengine.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/termstructures/volatility/swaption/swaptionconstantvol.hpp>
+#include <ql/cashflows/cmscoupon.hpp>
+#include <ql/cashflows/conundrumpricer.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/swap/euriborswap.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/quotes/simplequote.hpp>
 
 using namespace QuantLib;
@@ -61,9 +82,234 @@ void InstrumentTest::testObservable() {
 }
 
 
+void InstrumentTest::testPortfolioRecalculation() {
+
+    BOOST_TEST_MESSAGE("Testing recalculation of dirty portfolio instruments...");
+
+    boost::shared_ptr<SimpleQuote> q1(new SimpleQuote(1.0));
+    boost::shared_ptr<SimpleQuote> q2(new SimpleQuote(2.0));
+    boost::shared_ptr<Instrument> s1(new Stock(Handle<Quote>(q1)));
+    boost::shared_ptr<Instrument> s2(new Stock(Handle<Quote>(q2)));
+    boost::shared_ptr<Instrument> s3(new Stock(Handle<Quote>(q1)));
+
+    // inner depends on s1, outer on inner; they are added to the
+    // portfolio in the wrong order on purpose
+    boost::shared_ptr<CompositeInstrument> inner(new CompositeInstrument);
+    inner->add(s1);
+    boost::shared_ptr<CompositeInstrument> outer(new CompositeInstrument);
+    outer->add(inner, 2.0);
+
+    Portfolio portfolio;
+    portfolio.add(s1);
+    portfolio.add(s2);
+    portfolio.add(s3);
+    portfolio.add(outer);
+    portfolio.addSharedObject(outer);
+    portfolio.addSharedObject(inner);
+
+    if (portfolio.dirtyInstruments().size() != 4)
+        BOOST_FAIL("new instruments not flagged for recalculation");
+
+    Size recalculated = portfolio.recalculate();
+    if (recalculated != 4)
+        BOOST_FAIL(recalculated << " instruments recalculated, 4 expected");
+    if (!portfolio.dirtyInstruments().empty())
+        BOOST_FAIL("instruments still dirty after recalculation");
+
+    const std::vector<Size>& order = portfolio.sharedObjectOrder();
+    if (order.size() != 2 || order[0] != 1 || order[1] != 0)
+        BOOST_FAIL("shared objects not sorted by dependency");
+
+    q1->setValue(3.0);
+    std::vector<Size> dirty = portfolio.dirtyInstruments();
+    if (dirty.size() != 3 || dirty[0] != 0 || dirty[1] != 2 || dirty[2] != 3)
+        BOOST_FAIL("wrong instruments flagged after quote change");
+    if (portfolio.isDirty(1))
+        BOOST_FAIL("unaffected instrument flagged after quote change");
+
+    Real npv = portfolio.NPV();
+    Real expected = 3.0 + 2.0 + 3.0 + 2.0*3.0;
+    if (std::fabs(npv - expected) > 1.0e-12)
+        BOOST_FAIL("portfolio NPV:  " << npv << "\n"
+                   << "expected:       " << expected);
+    if (!portfolio.dirtyInstruments().empty())
+        BOOST_FAIL("instruments still dirty after recalculation");
+    if (portfolio.recalculate() != 0)
+        BOOST_FAIL("clean instruments recalculated");
+}
+
+
+void InstrumentTest::testPortfolioParallelRecalculation() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing parallel recalculation of portfolio bonds and swaps...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Calendar calendar = TARGET();
+    Date today = calendar.adjust(Date(15, March, 2013));
+    Settings::instance().evaluationDate() = today;
+
+    // bootstrapped curve shared by all instruments
+    Rate depositRates[] = { 0.0030, 0.0040 };
+    Period depositTenors[] = { 3*Months, 6*Months };
+    Rate swapRates[] = { 0.0060, 0.0110, 0.0170 };
+    Period swapTenors[] = { 2*Years, 5*Years, 10*Years };
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    std::vector<boost::shared_ptr<RateHelper> > helpers;
+    for (Size i=0; i<LENGTH(depositRates); ++i) {
+        boost::shared_ptr<SimpleQuote> q(new SimpleQuote(depositRates[i]));
+        quotes.push_back(q);
+        helpers.push_back(boost::shared_ptr<RateHelper>(
+            new DepositRateHelper(Handle<Quote>(q), depositTenors[i], 2,
+                                  calendar, ModifiedFollowing, true,
+                                  Actual360())));
+    }
+    for (Size i=0; i<LENGTH(swapRates); ++i) {
+        boost::shared_ptr<SimpleQuote> q(new SimpleQuote(swapRates[i]));
+        quotes.push_back(q);
+        helpers.push_back(boost::shared_ptr<RateHelper>(
+            new SwapRateHelper(Handle<Quote>(q), swapTenors[i], calendar,
+                               Annual, Unadjusted,
+                               Thirty360(Thirty360::BondBasis),
+                               boost::shared_ptr<IborIndex>(
+                                                      new Euribor6M))));
+    }
+    boost::shared_ptr<YieldTermStructure> curve(
+        new PiecewiseYieldCurve<Discount,LogLinear>(0, calendar, helpers,
+                                                    Actual365Fixed()));
+    Handle<YieldTermStructure> curveHandle(curve);
+
+    boost::shared_ptr<IborIndex> index(new Euribor6M(curveHandle));
+    for (Date d = today - 1*Years; d < today; ++d)
+        if (index->isValidFixingDate(d))
+            index->addFixing(d, 0.0035);
+
+    Portfolio portfolio;
+    std::vector<boost::shared_ptr<Instrument> > instruments;
+
+    // fixed-rate bonds, each with its own engine
+    for (Integer i=1; i<=4; ++i) {
+        Schedule schedule(today - 3*Months, today + 2*i*Years,
+                          Period(Annual), calendar, Unadjusted, Unadjusted,
+                          DateGeneration::Backward, false);
+        boost::shared_ptr<Bond> bond(
+            new FixedRateBond(2, 100.0, schedule,
+                              std::vector<Rate>(1, 0.01*i),
+                              ActualActual(ActualActual::ISMA)));
+        portfolio.add(bond, boost::shared_ptr<PricingEngine>(
+                                 new DiscountingBondEngine(curveHandle)));
+        instruments.push_back(bond);
+    }
+
+    // floating-rate bonds with past fixings, sharing a coupon pricer
+    boost::shared_ptr<IborCouponPricer> iborPricer(new BlackIborCouponPricer);
+    for (Integer i=1; i<=3; ++i) {
+        Schedule schedule(today - 4*Months, today + (3*i+1)*Years,
+                          Period(Semiannual), calendar, ModifiedFollowing,
+                          ModifiedFollowing, DateGeneration::Backward, false);
+        boost::shared_ptr<Bond> bond(
+            new FloatingRateBond(2, 100.0, schedule, index, Actual360(),
+                                 ModifiedFollowing, 2,
+                                 std::vector<Real>(1, 1.0),
+                                 std::vector<Spread>(1, 0.001*i)));
+        setCouponPricer(bond->cashflows(), iborPricer);
+        portfolio.add(bond, boost::shared_ptr<PricingEngine>(
+                                 new DiscountingBondEngine(curveHandle)));
+        instruments.push_back(bond);
+    }
+    portfolio.addSequentialObject(iborPricer);
+
+    // vanilla swaps, two of them sharing an engine
+    boost::shared_ptr<PricingEngine> swapEngine(
+                                  new DiscountingSwapEngine(curveHandle));
+    for (Integer i=1; i<=3; ++i) {
+        boost::shared_ptr<VanillaSwap> swap =
+            MakeVanillaSwap(3*i*Years, index, 0.01*i)
+            .withEffectiveDate(today - 2*Months)
+            .withNominal(100.0);
+        portfolio.add(swap, i < 3 ? swapEngine :
+                      boost::shared_ptr<PricingEngine>(
+                                 new DiscountingSwapEngine(curveHandle)));
+        instruments.push_back(swap);
+    }
+
+    // CMS swaps sharing a CMS coupon pricer, which stores the
+    // replication results of the coupons it prices
+    boost::shared_ptr<SwapIndex> swapIndex(
+                           new EuriborSwapIsdaFixA(5*Years, curveHandle));
+    Handle<SwaptionVolatilityStructure> volatility(
+        boost::shared_ptr<SwaptionVolatilityStructure>(
+            new ConstantSwaptionVolatility(today, calendar,
+                                           ModifiedFollowing, 0.25,
+                                           Actual365Fixed())));
+    Handle<Quote> meanReversion(
+                       boost::shared_ptr<Quote>(new SimpleQuote(0.01)));
+    boost::shared_ptr<CmsCouponPricer> cmsPricer(
+        new AnalyticHaganPricer(volatility, GFunctionFactory::Standard,
+                                meanReversion));
+    for (Integer i=1; i<=2; ++i) {
+        // forward starting, so that no swap-rate fixing is needed
+        Schedule schedule(today + 1*Months, today + (24*i+1)*Months,
+                          Period(Annual), calendar,
+                          ModifiedFollowing, ModifiedFollowing,
+                          DateGeneration::Forward, false);
+        Leg fixedLeg = FixedRateLeg(schedule)
+            .withNotionals(100.0)
+            .withCouponRates(0.015, Thirty360());
+        Leg cmsLeg = CmsLeg(schedule, swapIndex)
+            .withNotionals(100.0)
+            .withPaymentDayCounter(Thirty360())
+            .withFixingDays(2)
+            .withCaps(0.04);
+        setCouponPricer(cmsLeg, cmsPricer);
+        boost::shared_ptr<Instrument> swap(new Swap(fixedLeg, cmsLeg));
+        portfolio.add(swap, boost::shared_ptr<PricingEngine>(
+                                 new DiscountingSwapEngine(curveHandle)));
+        instruments.push_back(swap);
+    }
+    portfolio.addSequentialObject(cmsPricer);
+
+    portfolio.addSharedObject(
+                 boost::dynamic_pointer_cast<LazyObject>(curve));
+
+    Real tolerance = 1.0e-10;
+    for (Size k=0; k<2; ++k) {
+        if (k == 1) {
+            quotes[1]->setValue(quotes[1]->value() + 0.0010);
+            quotes[3]->setValue(quotes[3]->value() + 0.0010);
+            if (portfolio.dirtyInstruments().size() != instruments.size())
+                BOOST_FAIL("instruments not flagged after curve change");
+        }
+
+        // parallel recalculation, then serial one as a reference
+        Size recalculated = portfolio.recalculate();
+        if (recalculated != instruments.size())
+            BOOST_FAIL(recalculated << " instruments recalculated, "
+                       << instruments.size() << " expected");
+        std::vector<Real> parallel(instruments.size());
+        for (Size i=0; i<instruments.size(); ++i)
+            parallel[i] = instruments[i]->NPV();
+        for (Size i=0; i<instruments.size(); ++i) {
+            instruments[i]->recalculate();
+            Real serial = instruments[i]->NPV();
+            if (std::fabs(parallel[i] - serial) > tolerance)
+                BOOST_ERROR("instrument #" << i << " (pass " << k << "):"
+                            << std::setprecision(12)
+                            << "\n    parallel NPV: " << parallel[i]
+                            << "\n    serial NPV:   " << serial);
+        }
+    }
+}
+
+
 test_suite* InstrumentTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Instrument tests");
     suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testObservable));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testPortfolioRecalculation));
+    suite->add(QUANTLIB_TEST_CASE(
+                      &InstrumentTest::testPortfolioParallelRecalculation));
     return suite;
 }
 
@@ -28,6 +28,8 @@
 class InstrumentTest {
   public:
     static void testObservable();
+    static void testPortfolioRecalculation();
+    static void testPortfolioParallelRecalculation();
     static boost::unit_test_framework::test_suite* suite();
 };
 
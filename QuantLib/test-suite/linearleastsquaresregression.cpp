@@ -23,6 +23,7 @@
 #include <ql/math/functional.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/linearleastsquaresregression.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -250,6 +251,74 @@ void LinearLeastSquaresRegressionTest::test1dLinearRegression() {
 }
 
 
+void LinearLeastSquaresRegressionTest::testIncrementalRegression() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing incremental linear least-squares regression...");
+
+    SavedSettings backup;
+
+    const Size nr=10000;
+    const Real tolerance = 1.0e-8;
+    PseudoRandom::rng_type rng(PseudoRandom::urng_type(1234u));
+
+    std::vector<boost::function1<Real, Real> > v;
+    v.push_back(constant<Real, Real>(1.0));
+    v.push_back(identity<Real>());
+    v.push_back(square<Real>());
+    v.push_back(std::ptr_fun<Real, Real>(std::sin));
+
+    // the last basis function duplicates an earlier one, so that the
+    // minimum-norm solution is required
+    std::vector<boost::function1<Real, Real> > w(v);
+    w.push_back(square<Real>());
+
+    std::vector<Real> x(nr), y(nr);
+    for (Size i=0; i<nr; ++i) {
+        x[i] = rng.next().value;
+        y[i] = 1.0 + 2.0*x[i] - x[i]*x[i] + 0.5*std::sin(x[i])
+             + rng.next().value;
+    }
+
+    for (Size k=0; k<2; ++k) {
+        const std::vector<boost::function1<Real, Real> >& basis =
+            (k == 0 ? v : w);
+
+        const Array expected = LinearRegression(x, y, basis).coefficients();
+
+        // two partial regressions over disjoint samples, then merged
+        IncrementalLinearLeastSquares first(basis.size()),
+                                      second(basis.size());
+        Array values(basis.size());
+        for (Size i=0; i<nr; ++i) {
+            for (Size l=0; l<basis.size(); ++l)
+                values[l] = basis[l](x[i]);
+            if (i < nr/3)
+                first.add(values.begin(), values.end(), y[i]);
+            else
+                second.add(values.begin(), values.end(), y[i]);
+        }
+        first.add(second);
+
+        if (first.samples() != nr)
+            BOOST_ERROR("wrong number of samples"
+                        << "\n    calculated: " << first.samples()
+                        << "\n    expected:   " << nr);
+
+        const Array calculated = first.coefficients();
+        for (Size l=0; l<basis.size(); ++l) {
+            if (std::fabs(calculated[l]-expected[l]) > tolerance) {
+                BOOST_ERROR("Failed to reproduce linear regression coef."
+                            << "\n    basis size: " << basis.size()
+                            << "\n    calculated: " << calculated[l]
+                            << "\n    expected:   " << expected[l]
+                            << "\n    tolerance:  " << tolerance);
+            }
+        }
+    }
+}
+
+
 test_suite* LinearLeastSquaresRegressionTest::suite() {
     test_suite* suite =
         BOOST_TEST_SUITE("linear least squares regression tests");
@@ -259,6 +328,8 @@ test_suite* LinearLeastSquaresRegressionTest::suite() {
         &LinearLeastSquaresRegressionTest::testMultiDimRegression));
     suite->add(QUANTLIB_TEST_CASE(
         &LinearLeastSquaresRegressionTest::test1dLinearRegression));
+    suite->add(QUANTLIB_TEST_CASE(
+        &LinearLeastSquaresRegressionTest::testIncrementalRegression));
     return suite;
 }
 
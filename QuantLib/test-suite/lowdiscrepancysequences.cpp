@@ -29,6 +29,7 @@
 #include <ql/math/randomnumbers/primitivepolynomials.hpp>
 #include <ql/math/randomnumbers/randomizedlds.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/progress.hpp>
@@ -1045,6 +1046,73 @@ void LowDiscrepancyTest::testUnitSobolDiscrepancy() {
 }
 
 
+void LowDiscrepancyTest::testScrambledSobol() {
+
+    BOOST_TEST_MESSAGE("Testing scrambled Sobol sequences...");
+
+    Size dimensionality = 20;
+    Size points = 1024;
+    ScrambledSobolRsg::Scrambling scramblings[] = {
+        ScrambledSobolRsg::DigitalShift,
+        ScrambledSobolRsg::LinearScrambling };
+
+    for (Size i=0; i<LENGTH(scramblings); i++) {
+        ScrambledSobolRsg rsg(dimensionality, 42, scramblings[i]);
+        for (BigNatural r=0; r<3; r++) {
+            rsg.randomize(r);
+            // the first 2^m points fill each of the 2^m intervals of
+            // the unit interval once in every dimension
+            std::vector<std::vector<Size> > counts(
+                            dimensionality, std::vector<Size>(points, 0));
+            std::vector<Real> first;
+            for (Size j=0; j<points; j++) {
+                const std::vector<Real>& x = rsg.nextSequence().value;
+                if (j == 0)
+                    first = x;
+                for (Size k=0; k<dimensionality; k++) {
+                    if (x[k] <= 0.0 || x[k] >= 1.0)
+                        BOOST_FAIL("point #" << j << " out of the open "
+                                   "unit interval in dimension " << k);
+                    counts[k][Size(x[k]*points)]++;
+                }
+            }
+            for (Size k=0; k<dimensionality; k++) {
+                for (Size j=0; j<points; j++) {
+                    if (counts[k][j] != 1)
+                        BOOST_FAIL("stratification lost:"
+                                   << "\n  scrambling:    " << scramblings[i]
+                                   << "\n  randomization: " << r
+                                   << "\n  dimension:     " << k
+                                   << "\n  interval:      " << j
+                                   << "\n  points:        " << counts[k][j]);
+                }
+            }
+
+            // randomizations are reproducible...
+            ScrambledSobolRsg rsg2(dimensionality, 42, scramblings[i]);
+            rsg2.randomize(r);
+            const std::vector<Real>& x = rsg2.nextSequence().value;
+            for (Size k=0; k<dimensionality; k++) {
+                if (x[k] != first[k])
+                    BOOST_FAIL("randomization " << r
+                               << " not reproduced in dimension " << k);
+            }
+
+            // ...and different from one another
+            rsg2.randomize(r+1);
+            const std::vector<Real>& y = rsg2.nextSequence().value;
+            Size equal = 0;
+            for (Size k=0; k<dimensionality; k++) {
+                if (y[k] == first[k])
+                    equal++;
+            }
+            if (equal > 0)
+                BOOST_FAIL(equal << " coordinates not changed by "
+                           "randomization " << r+1);
+        }
+    }
+}
+
 void LowDiscrepancyTest::testSobolSkipping() {
 
     BOOST_TEST_MESSAGE("Testing Sobol sequence skipping...");
@@ -1129,6 +1197,7 @@ test_suite* LowDiscrepancyTest::suite() {
            &LowDiscrepancyTest::testSobolLevitanLemieuxSobolDiscrepancy));
 
     suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolSkipping));
+    suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testScrambledSobol));
 
     suite->add(QUANTLIB_TEST_CASE(
            &LowDiscrepancyTest::testRandomizedLowDiscrepancySequence));
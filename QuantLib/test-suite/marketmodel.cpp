@@ -448,12 +448,13 @@ namespace {
         const std::vector<Size>& numeraires,
         const BrownianGeneratorFactory& generatorFactory,
         EvolverType evolverType,
-        Size initialStep = 0) {
+        Size initialStep = 0,
+        Size pathBlock = 1) {
             switch (evolverType) {
           case Ipc:
               return boost::shared_ptr<MarketModelEvolver>(
                   new LogNormalFwdRateIpc(marketModel, generatorFactory,
-                  numeraires, initialStep));
+                  numeraires, initialStep, pathBlock));
           case Balland:
               return boost::shared_ptr<MarketModelEvolver>(
                   new LogNormalFwdRateBalland(marketModel, generatorFactory,
@@ -461,11 +462,11 @@ namespace {
           case Pc:
               return boost::shared_ptr<MarketModelEvolver>(
                   new LogNormalFwdRatePc(marketModel, generatorFactory,
-                  numeraires, initialStep));
+                  numeraires, initialStep, pathBlock));
           case NormalPc:
               return boost::shared_ptr<MarketModelEvolver>(
                   new NormalFwdRatePc(marketModel, generatorFactory,
-                  numeraires, initialStep));
+                  numeraires, initialStep, pathBlock));
           default:
               QL_FAIL("unknown MarketModelEvolver type");
             }
@@ -1939,6 +1940,366 @@ void MarketModelTest::testCallableSwapAnderson() {
 
 
 
+void MarketModelTest::testParallelEngines() {
+
+    BOOST_TEST_MESSAGE("Testing parallel accounting and upper-bound engines...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+
+    MultiStepSwap payerSwap(rateTimes, accruals, accruals, paymentTimes,
+        fixedRate, true);
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+        fixedRate, false);
+
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    CallSpecifiedMultiProduct callableProduct =
+        CallSpecifiedMultiProduct(receiverSwap, naifStrategy,
+                                  ExerciseAdapter(nullRebate));
+    EvolutionDescription evolution = callableProduct.evolution();
+
+    MultiProductComposite allProducts;
+    allProducts.add(payerSwap);
+    allProducts.add(receiverSwap);
+    allProducts.add(callableProduct);
+    allProducts.finalize();
+
+    std::vector<Size> numeraires = makeMeasure(callableProduct,
+                                               MoneyMarketPlus);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 4,
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    const Size workers = 3;
+    const Real tolerance = 1.0e-12;
+
+    // 1. accounting engine, both with Sobol and Mersenne-twister
+    //    generators, over two calls
+    SobolBrownianGeneratorFactory sobolFactory(
+                                   SobolBrownianGenerator::Diagonal, seed_);
+    MTBrownianGeneratorFactory mtFactory(seed_);
+    const BrownianGeneratorFactory* factories[] = { &sobolFactory,
+                                                    &mtFactory };
+
+    for (Size f=0; f<LENGTH(factories); ++f) {
+        AccountingEngine engine(
+            makeMarketModelEvolver(marketModel, numeraires, *factories[f], Pc),
+            allProducts, initialNumeraireValue);
+        SequenceStatisticsInc stats(allProducts.numberOfProducts());
+        engine.multiplePathValues(stats, 200);
+        engine.multiplePathValues(stats, 131);
+
+        std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers;
+        for (Size w=0; w<workers; ++w)
+            evolvers.push_back(makeMarketModelEvolver(marketModel, numeraires,
+                                                      *factories[f], Pc));
+        ParallelAccountingEngine parallelEngine(evolvers, allProducts,
+                                                initialNumeraireValue);
+        SequenceStatisticsInc parallelStats(allProducts.numberOfProducts());
+        parallelEngine.multiplePathValues(parallelStats, 200);
+        parallelEngine.multiplePathValues(parallelStats, 131);
+
+        std::vector<Real> expected = stats.mean();
+        std::vector<Real> calculated = parallelStats.mean();
+        for (Size i=0; i<expected.size(); ++i) {
+            if (std::fabs(calculated[i]-expected[i]) > tolerance)
+                BOOST_ERROR("parallel accounting engine failed to reproduce "
+                            "serial result for product " << i <<
+                            "\n    generator:  " << (f == 0 ? "Sobol" : "MT") <<
+                            "\n    calculated: " << calculated[i] <<
+                            "\n    expected:   " << expected[i]);
+        }
+    }
+
+    // 2. upper-bound engine
+    std::valarray<bool> isExerciseTime =
+        isInSubset(evolution.evolutionTimes(), naifStrategy.exerciseTimes());
+
+    std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers;
+    std::vector<std::vector<boost::shared_ptr<MarketModelEvolver> > >
+        innerEvolvers(workers+1);
+    for (Size w=0; w<workers+1; ++w) {
+        evolvers.push_back(makeMarketModelEvolver(marketModel, numeraires,
+                                                  sobolFactory, Pc));
+        for (Size s=0; s < isExerciseTime.size(); ++s) {
+            if (isExerciseTime[s]) {
+                MTBrownianGeneratorFactory iFactory(seed_+s);
+                innerEvolvers[w].push_back(
+                    makeMarketModelEvolver(marketModel, numeraires,
+                                           iFactory, Pc, s));
+            }
+        }
+    }
+
+    UpperBoundEngine uEngine(evolvers.back(), innerEvolvers.back(),
+                             receiverSwap, nullRebate,
+                             receiverSwap, nullRebate,
+                             naifStrategy, initialNumeraireValue);
+    Statistics uStats;
+    uEngine.multiplePathValues(uStats, 10, 16);
+    uEngine.multiplePathValues(uStats, 7, 16);
+
+    evolvers.pop_back();
+    innerEvolvers.pop_back();
+    ParallelUpperBoundEngine parallelUEngine(evolvers, innerEvolvers,
+                                             receiverSwap, nullRebate,
+                                             receiverSwap, nullRebate,
+                                             naifStrategy,
+                                             initialNumeraireValue);
+    Statistics parallelUStats;
+    parallelUEngine.multiplePathValues(parallelUStats, 10, 16);
+    parallelUEngine.multiplePathValues(parallelUStats, 7, 16);
+
+    if (std::fabs(parallelUStats.mean()-uStats.mean()) > tolerance)
+        BOOST_ERROR("parallel upper-bound engine failed to reproduce "
+                    "serial result" <<
+                    "\n    calculated: " << parallelUStats.mean() <<
+                    "\n    expected:   " << uStats.mean());
+}
+
+
+void MarketModelTest::testMultiPathEvolvers() {
+
+    BOOST_TEST_MESSAGE("Testing multi-path evolution against single paths...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+        fixedRate, false);
+
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    // the callable swap stops some paths before the last step
+    CallSpecifiedMultiProduct callableProduct =
+        CallSpecifiedMultiProduct(receiverSwap, naifStrategy,
+                                  ExerciseAdapter(nullRebate));
+    EvolutionDescription evolution = callableProduct.evolution();
+
+    MultiProductComposite allProducts;
+    allProducts.add(receiverSwap);
+    allProducts.add(callableProduct);
+    allProducts.finalize();
+
+    std::vector<Size> numeraires = makeMeasure(callableProduct, Terminal);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    const Size pathBlock = 16;
+    const Size workers = 3;
+    const Real tolerance = 1.0e-12;
+
+    EvolverType evolvers[] = { Pc, Ipc, NormalPc };
+    Size factors[] = { 4, todaysForwards.size() };
+    MTBrownianGeneratorFactory generatorFactory(seed_);
+
+    for (Size e=0; e<LENGTH(evolvers); ++e) {
+        for (Size f=0; f<LENGTH(factors); ++f) {
+            boost::shared_ptr<MarketModel> marketModel =
+                makeMarketModel(evolvers[e] != NormalPc, evolution,
+                                factors[f],
+                                ExponentialCorrelationFlatVolatility);
+
+            AccountingEngine engine(
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       generatorFactory, evolvers[e]),
+                allProducts, initialNumeraireValue);
+            SequenceStatisticsInc stats(allProducts.numberOfProducts());
+            engine.multiplePathValues(stats, 200);
+            engine.multiplePathValues(stats, 131);
+
+            AccountingEngine blockEngine(
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       generatorFactory, evolvers[e],
+                                       0, pathBlock),
+                allProducts, initialNumeraireValue);
+            SequenceStatisticsInc blockStats(allProducts.numberOfProducts());
+            blockEngine.multiplePathValues(blockStats, 200);
+            blockEngine.multiplePathValues(blockStats, 131);
+
+            // skipping paths must also account for those in the block
+            std::vector<boost::shared_ptr<MarketModelEvolver> > blockEvolvers;
+            for (Size w=0; w<workers; ++w)
+                blockEvolvers.push_back(
+                    makeMarketModelEvolver(marketModel, numeraires,
+                                           generatorFactory, evolvers[e],
+                                           0, pathBlock));
+            ParallelAccountingEngine parallelEngine(blockEvolvers,
+                                                    allProducts,
+                                                    initialNumeraireValue);
+            SequenceStatisticsInc parallelStats(
+                                           allProducts.numberOfProducts());
+            parallelEngine.multiplePathValues(parallelStats, 200);
+            parallelEngine.multiplePathValues(parallelStats, 131);
+
+            std::vector<Real> expected = stats.mean();
+            std::vector<Real> calculated = blockStats.mean();
+            std::vector<Real> parallel = parallelStats.mean();
+            for (Size i=0; i<expected.size(); ++i) {
+                if (std::fabs(calculated[i]-expected[i]) > tolerance ||
+                    std::fabs(parallel[i]-expected[i]) > tolerance)
+                    BOOST_ERROR("multi-path evolution failed to reproduce "
+                                "single-path result for product " << i <<
+                                "\n    evolver:    " <<
+                                evolverTypeToString(evolvers[e]) <<
+                                "\n    factors:    " << factors[f] <<
+                                "\n    calculated: " << calculated[i] <<
+                                "\n    parallel:   " << parallel[i] <<
+                                "\n    expected:   " << expected[i]);
+            }
+        }
+    }
+}
+
+
+void MarketModelTest::testParallelPathwiseGreeks() {
+
+    BOOST_TEST_MESSAGE("Testing parallel pathwise greeks against "
+                       "serial accounting engines...");
+
+    setup();
+
+    std::vector<boost::shared_ptr<Payoff> > payoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i)
+        payoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+
+    MultiStepOptionlets product(rateTimes, accruals,
+        paymentTimes, payoffs);
+
+    MarketModelPathwiseMultiDeflatedCaplet capletsDeflated(rateTimes, accruals,
+        paymentTimes, todaysForwards);
+
+    EvolutionDescription evolution = product.evolution();
+    Size numberRates = evolution.numberOfRates();
+    Size numberProducts = capletsDeflated.numberOfProducts();
+    std::vector<Size> numeraires = makeMeasure(product, MoneyMarket);
+
+    const Size workers = 3;
+    const Real tolerance = 1.0e-10;
+    Size factors = std::min<Size>(3, todaysForwards.size());
+
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, factors,
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    // vega bumps as unit clusters and as the equivalent matrices
+    VegaBumpCollection possibleBumps(marketModel, true);
+    const std::vector<VegaBumpCluster>& clusters = possibleBumps.allBumps();
+    std::vector<std::vector<Matrix> > vegaBumps(
+        marketModel->numberOfSteps(),
+        std::vector<Matrix>(clusters.size(),
+                            Matrix(numberRates, factors, 0.0)));
+    for (Size k=0; k<clusters.size(); ++k)
+        for (Size s=clusters[k].stepBegin(); s<clusters[k].stepEnd(); ++s)
+            for (Size r=clusters[k].rateBegin(); r<clusters[k].rateEnd(); ++r)
+                for (Size f=clusters[k].factorBegin();
+                     f<clusters[k].factorEnd(); ++f)
+                    vegaBumps[s][k][r][f] = 1.0;
+
+    // copies of an evolver would share its generator, so each engine
+    // gets its own one starting from the same seed
+    MTBrownianGeneratorFactory generatorFactory(seed_);
+
+    std::vector<boost::shared_ptr<LogNormalFwdRateEuler> > evolvers;
+    for (Size w=0; w<workers; ++w)
+        evolvers.push_back(boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                      numeraires)));
+
+    // values and deltas
+    PathwiseAccountingEngine engine(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                      numeraires)),
+        capletsDeflated, marketModel, initialNumeraireValue);
+    SequenceStatisticsInc stats(numberProducts*(numberRates+1));
+    engine.multiplePathValues(stats, 200);
+    engine.multiplePathValues(stats, 131);
+
+    ParallelPathwiseAccountingEngine parallelEngine(
+        evolvers, capletsDeflated, marketModel, initialNumeraireValue);
+    SequenceStatisticsInc parallelStats(numberProducts*(numberRates+1));
+    parallelEngine.multiplePathValues(parallelStats, 200);
+    parallelEngine.multiplePathValues(parallelStats, 131);
+
+    std::vector<Real> expected = stats.mean();
+    std::vector<Real> calculated = parallelStats.mean();
+    std::vector<Real> expectedErrors = stats.errorEstimate();
+    std::vector<Real> calculatedErrors = parallelStats.errorEstimate();
+    if (parallelStats.samples() != stats.samples())
+        BOOST_ERROR("parallel pathwise engine used " <<
+                    parallelStats.samples() << " paths instead of " <<
+                    stats.samples());
+    for (Size i=0; i<expected.size(); ++i) {
+        Real scale = std::max(std::fabs(expected[i]), 1.0e-4);
+        if (std::fabs(calculated[i]-expected[i]) > tolerance*scale ||
+            std::fabs(calculatedErrors[i]-expectedErrors[i])
+                                                       > tolerance*scale)
+            BOOST_ERROR("parallel pathwise engine failed to reproduce "
+                        "serial result for element " << i <<
+                        "\n    calculated: " << calculated[i] <<
+                        " +/- " << calculatedErrors[i] <<
+                        "\n    expected:   " << expected[i] <<
+                        " +/- " << expectedErrors[i]);
+    }
+
+    // vegas
+    std::vector<boost::shared_ptr<LogNormalFwdRateEuler> > vegaEvolvers;
+    for (Size w=0; w<workers; ++w)
+        vegaEvolvers.push_back(boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                      numeraires)));
+
+    std::vector<Real> values, errors;
+    PathwiseVegasOuterAccountingEngine vegaEngine(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                      numeraires)),
+        capletsDeflated, marketModel, vegaBumps, initialNumeraireValue);
+    vegaEngine.multiplePathValues(values, errors, 331);
+
+    ParallelPathwiseVegasOuterAccountingEngine parallelVegaEngine(
+        vegaEvolvers, capletsDeflated, marketModel, vegaBumps,
+        initialNumeraireValue);
+    std::vector<Real> parallelValues, parallelErrors;
+    parallelVegaEngine.multiplePathValues(parallelValues, parallelErrors,
+                                          331);
+
+    // recombining the same paths for the clusters needs no new simulation
+    std::vector<Real> clusterValues, clusterErrors;
+    parallelVegaEngine.vegas(possibleBumps, clusterValues, clusterErrors);
+
+    if (parallelValues.size() != values.size() ||
+        clusterValues.size() != values.size())
+        BOOST_FAIL("parallel pathwise vega engine returned " <<
+                   parallelValues.size() << " and " <<
+                   clusterValues.size() << " results instead of " <<
+                   values.size());
+    for (Size i=0; i<values.size(); ++i) {
+        Real scale = std::max(std::fabs(values[i]), 1.0e-4);
+        if (std::fabs(parallelValues[i]-values[i]) > tolerance*scale ||
+            std::fabs(clusterValues[i]-values[i]) > tolerance*scale)
+            BOOST_ERROR("parallel pathwise vega engine failed to reproduce "
+                        "serial result for element " << i <<
+                        "\n    calculated: " << parallelValues[i] <<
+                        "\n    clusters:   " << clusterValues[i] <<
+                        "\n    expected:   " << values[i]);
+    }
+}
+
 void MarketModelTest::testGreeks() {
 
     BOOST_TEST_MESSAGE("Testing caplet greeks in a lognormal forward rate market model using partial proxy simulation...");
@@ -4894,6 +5255,9 @@ test_suite* MarketModelTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCallableSwapNaif));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCallableSwapAnderson));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelEngines));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testMultiPathEvolvers));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelPathwiseGreeks));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testGreeks));
 
@@ -38,6 +38,9 @@ class MarketModelTest {
     static void testCallableSwapNaif();
     static void testCallableSwapLS();
     static void testCallableSwapAnderson();
+    static void testParallelEngines();
+    static void testMultiPathEvolvers();
+    static void testParallelPathwiseGreeks();
     static void testGreeks();
     static void testPathwiseGreeks();
     static void testPathwiseVegas();
@@ -25,10 +25,15 @@
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/methods/montecarlo/longstaffschwartzpathpricer.hpp>
+#include <ql/methods/montecarlo/pathgenerator.hpp>
+#include <ql/math/linearleastsquaresregression.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/mcamericanengine.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
+#include <iomanip>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -118,6 +123,41 @@ namespace {
         }
     };
 
+    // gives access to the calibrated regression coefficients
+    class InspectableLongstaffSchwartzPathPricer
+        : public LongstaffSchwartzPathPricer<Path> {
+      public:
+        InspectableLongstaffSchwartzPathPricer(
+            const TimeGrid& times,
+            const boost::shared_ptr<EarlyExercisePathPricer<Path> >& pricer,
+            const boost::shared_ptr<YieldTermStructure>& termStructure)
+        : LongstaffSchwartzPathPricer<Path>(times, pricer, termStructure) {}
+        const Array& coefficients(Size i) const { return coeff_[i]; }
+    };
+
+    // returns new generators drawing the same paths
+    class PathGeneratorFactory {
+      public:
+        typedef PathGenerator<PseudoRandom::rsg_type> generator_type;
+        PathGeneratorFactory(
+                    const boost::shared_ptr<StochasticProcess>& process,
+                    const TimeGrid& grid,
+                    BigNatural seed)
+        : process_(process), grid_(grid), seed_(seed) {}
+        boost::shared_ptr<generator_type> operator()() const {
+            return boost::shared_ptr<generator_type>(
+                new generator_type(
+                    process_, grid_,
+                    PseudoRandom::make_sequence_generator(grid_.size()-1,
+                                                          seed_),
+                    false));
+        }
+      private:
+        boost::shared_ptr<StochasticProcess> process_;
+        TimeGrid grid_;
+        BigNatural seed_;
+    };
+
 }
 
 
@@ -294,6 +334,141 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testPathPricerCalibration() {
+    BOOST_TEST_MESSAGE("Testing Longstaff-Schwartz calibration "
+                       "against serial regression and regenerated paths...");
+
+    SavedSettings backup;
+
+    Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dayCounter = Actual365Fixed();
+
+    boost::shared_ptr<YieldTermStructure> riskFreeCurve(
+                               new FlatForward(today, 0.06, dayCounter));
+    Handle<YieldTermStructure> riskFreeTS(riskFreeCurve);
+    Handle<YieldTermStructure> dividendTS(
+        boost::shared_ptr<YieldTermStructure>(
+                               new FlatForward(today, 0.02, dayCounter)));
+    Handle<BlackVolTermStructure> volTS(
+        boost::shared_ptr<BlackVolTermStructure>(
+            new BlackConstantVol(today, NullCalendar(), 0.25, dayCounter)));
+    Handle<Quote> underlying(
+        boost::shared_ptr<Quote>(new SimpleQuote(36.0)));
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new GeneralizedBlackScholesProcess(underlying, dividendTS,
+                                           riskFreeTS, volTS));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Put, 40.0));
+    boost::shared_ptr<EarlyExercisePathPricer<Path> > exercisePricer(
+        new AmericanPathPricer(payoff, 3, LsmBasisSystem::Monomial));
+    std::vector<boost::function1<Real, Real> > basis =
+        exercisePricer->basisSystem();
+
+    Size steps = 20;
+    TimeGrid grid(1.0, steps);
+    PathGeneratorFactory factory(process, grid, 42);
+
+    // a single block, a few blocks, and several chunks of paths
+    Size samples[] = { 10, 1000, 5000 };
+
+    for (Size k=0; k<2*LENGTH(samples); ++k) {
+        bool antithetic = (k % 2 == 1);
+        InspectableLongstaffSchwartzPathPricer pricer(grid, exercisePricer,
+                                                      riskFreeCurve);
+        boost::shared_ptr<PathGeneratorFactory::generator_type> generator =
+            factory();
+        std::vector<Path> paths;
+        for (Size j=0; j<samples[k/2]; ++j) {
+            paths.push_back(generator->next().value);
+            pricer(paths.back());
+            if (antithetic) {
+                paths.push_back(generator->antithetic().value);
+                pricer(paths.back());
+            }
+        }
+        pricer.calibrate();
+
+        // paths drawn again for each exercise time must give the
+        // same regression as stored ones
+        InspectableLongstaffSchwartzPathPricer regenerated(grid,
+                                                           exercisePricer,
+                                                           riskFreeCurve);
+        regenerated.calibrate(
+            boost::function<boost::shared_ptr<
+                                PathGeneratorFactory::generator_type>()>(
+                                                                   factory),
+            samples[k/2], antithetic);
+        for (Size i=grid.size()-2; i>0; --i) {
+            for (Size l=0; l<basis.size(); ++l) {
+                if (regenerated.coefficients(i)[l]
+                                        != pricer.coefficients(i)[l])
+                    BOOST_FAIL("regenerated paths give different regression "
+                               "with " << paths.size() << " paths at step "
+                               << i << ", coefficient #" << l
+                               << std::setprecision(12)
+                               << "\n    regenerated: "
+                               << regenerated.coefficients(i)[l]
+                               << "\n    stored:      "
+                               << pricer.coefficients(i)[l]);
+            }
+        }
+
+        // serial regression on all in-the-money paths at once
+        Size n = paths.size(), len = grid.size();
+        std::vector<Real> prices(n);
+        for (Size j=0; j<n; ++j)
+            prices[j] = (*exercisePricer)(paths[j], len-1);
+
+        for (Size i=len-2; i>0; --i) {
+            DiscountFactor dF = riskFreeCurve->discount(grid[i+1])
+                              / riskFreeCurve->discount(grid[i]);
+            std::vector<Real> x, y, exercise(n);
+            for (Size j=0; j<n; ++j) {
+                exercise[j] = (*exercisePricer)(paths[j], i);
+                if (exercise[j] > 0.0) {
+                    x.push_back(exercisePricer->state(paths[j], i));
+                    y.push_back(dF*prices[j]);
+                }
+            }
+
+            Array expected(basis.size(), 0.0);
+            if (basis.size() <= x.size())
+                expected = LinearLeastSquaresRegression<Real>(x, y, basis)
+                           .coefficients();
+            const Array& calculated = pricer.coefficients(i);
+
+            for (Size l=0; l<basis.size(); ++l) {
+                Real tolerance = 1.0e-8 * std::max(1.0,
+                                                   std::fabs(expected[l]));
+                if (std::fabs(calculated[l] - expected[l]) > tolerance)
+                    BOOST_FAIL("failed to reproduce serial regression with "
+                               << n << " paths at step " << i
+                               << ", coefficient #" << l
+                               << std::setprecision(12)
+                               << "\n    calculated: " << calculated[l]
+                               << "\n    expected:   " << expected[l]);
+            }
+
+            // use the same coefficients to roll back, so that the
+            // comparison at the next step is not affected by an
+            // exercise decision flipped by rounding
+            for (Size j=0; j<n; ++j) {
+                prices[j] *= dF;
+                if (exercise[j] > 0.0) {
+                    Real state = exercisePricer->state(paths[j], i);
+                    Real continuationValue = 0.0;
+                    for (Size l=0; l<basis.size(); ++l)
+                        continuationValue += calculated[l]*basis[l](state);
+                    if (continuationValue < exercise[j])
+                        prices[j] = exercise[j];
+                }
+            }
+        }
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -301,6 +476,8 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testPathPricerCalibration));
     return suite;
 }
 
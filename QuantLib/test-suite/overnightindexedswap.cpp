@@ -34,6 +34,7 @@
 #include <ql/indexes/ibor/eonia.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
@@ -424,6 +425,85 @@ void OvernightIndexedSwapTest::testBootstrap() {
     */
 }
 
+namespace {
+
+    Rate expectedCouponRate(const OvernightIndexedCoupon& coupon,
+                            const Eonia& index,
+                            const YieldTermStructure& curve) {
+        const std::vector<Date>& fixingDates = coupon.fixingDates();
+        const std::vector<Date>& valueDates = coupon.valueDates();
+        const std::vector<Time>& dt = coupon.dt();
+        Date today = Settings::instance().evaluationDate();
+        Real compoundFactor = 1.0;
+        Size i = 0;
+        while (i<dt.size() && (fixingDates[i] < today ||
+                               (fixingDates[i] == today &&
+                                index.timeSeries()[today] != Null<Real>()))) {
+            compoundFactor *= 1.0 + index.timeSeries()[fixingDates[i]]*dt[i];
+            ++i;
+        }
+        if (i<dt.size())
+            compoundFactor *= curve.discount(valueDates[i]) /
+                              curve.discount(valueDates.back());
+        return (compoundFactor - 1.0)/coupon.accrualPeriod();
+    }
+
+}
+
+void OvernightIndexedSwapTest::testSeasonedCoupon() {
+
+    BOOST_TEST_MESSAGE("Testing seasoned overnight-indexed coupon...");
+
+    CommonVars vars;
+    IndexHistoryCleaner cleaner;
+
+    Date start = vars.calendar.advance(vars.today, -30, Days);
+    Date end = vars.calendar.advance(vars.today, 30, Days);
+    vars.eoniaTermStructure.linkTo(flatRate(start, 0.05, Actual365Fixed()));
+
+    OvernightIndexedCoupon coupon(end, 1.0, start, end, vars.eoniaIndex);
+
+    // fixings up to a few days after today
+    Date lastFixing = vars.calendar.advance(vars.today, 5, Days);
+    for (Date d = start; d <= lastFixing;
+         d = vars.calendar.advance(d, 1, Days))
+        vars.eoniaIndex->addFixing(d, 0.04 + 0.0001*(d - start));
+
+    Date evaluationDates[] = {
+        vars.today,
+        vars.calendar.advance(vars.today, 2, Days),
+        vars.calendar.advance(vars.today, 5, Days),
+        vars.calendar.advance(vars.today, 6, Days),
+        vars.today
+    };
+
+    for (Size k=0; k<LENGTH(evaluationDates); ++k) {
+        Settings::instance().evaluationDate() = evaluationDates[k];
+        Rate calculated = coupon.rate();
+        Rate expected = expectedCouponRate(coupon, *vars.eoniaIndex,
+                                           **vars.eoniaTermStructure);
+        if (std::fabs(calculated - expected) > 1.0e-12)
+            BOOST_ERROR("unable to reproduce seasoned coupon rate"
+                        << "\n    evaluation date: " << evaluationDates[k]
+                        << std::setprecision(12)
+                        << "\n    calculated:      " << calculated
+                        << "\n    expected:        " << expected);
+    }
+
+    // changing a past fixing must be reflected in the rate
+    Date fixingDate = vars.calendar.advance(vars.today, -10, Days);
+    vars.eoniaIndex->addFixing(fixingDate, 0.06, true);
+    Rate calculated = coupon.rate();
+    Rate expected = expectedCouponRate(coupon, *vars.eoniaIndex,
+                                       **vars.eoniaTermStructure);
+    if (std::fabs(calculated - expected) > 1.0e-12)
+        BOOST_ERROR("unable to reproduce seasoned coupon rate "
+                    "after changing a fixing"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+}
+
 
 test_suite* OvernightIndexedSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
@@ -431,6 +511,8 @@ test_suite* OvernightIndexedSwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testCachedValue));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &OvernightIndexedSwapTest::testSeasonedCoupon));
     return suite;
 }
 
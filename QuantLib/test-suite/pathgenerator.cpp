@@ -20,8 +20,10 @@
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/batchpathgenerator.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
@@ -138,6 +140,99 @@ namespace {
         }
     }
 
+    void checkBatch(const PathBatch& batch, Size k,
+                    const MultiPath& path, Real weight,
+                    const std::string& tag, bool antithetic) {
+        Real tolerance = 1.0e-12;
+        for (Size j=0; j<path.assetNumber(); j++) {
+            for (Size i=0; i<path.pathSize(); i++) {
+                Real expected = path[j][i];
+                Real calculated = batch(i,j,k);
+                Real error = std::fabs(calculated-expected)
+                           / std::max(1.0, std::fabs(expected));
+                if (error > tolerance) {
+                    BOOST_FAIL("using " << tag << " process "
+                               << (antithetic ? "(antithetic sample, " : "(")
+                               << io::ordinal(k+1) << " path, "
+                               << io::ordinal(j+1) << " asset, "
+                               << io::ordinal(i+1) << " time):\n"
+                               << std::setprecision(13)
+                               << "    batch:      " << calculated << "\n"
+                               << "    single:     " << expected << "\n"
+                               << "    error:      " << error << "\n"
+                               << "    tolerance:  " << tolerance);
+                }
+            }
+        }
+        if (batch.weight(k) != weight)
+            BOOST_FAIL("using " << tag << " process "
+                       << "(" << io::ordinal(k+1) << " path):\n"
+                       << "    batch weight:  " << batch.weight(k) << "\n"
+                       << "    single weight: " << weight);
+    }
+
+    void testBatch(const boost::shared_ptr<StochasticProcess>& process,
+                   const std::string& tag, bool brownianBridge) {
+        typedef PseudoRandom::rsg_type rsg_type;
+
+        BigNatural seed = 42;
+        Time length = 10;
+        Size timeSteps = 12;
+        Size batchSize = 7, batches = 3;
+        TimeGrid grid(length, timeSteps);
+        Size dimension = process->factors()*timeSteps;
+
+        BatchPathGenerator<rsg_type> generator(
+                   process, grid,
+                   PseudoRandom::make_sequence_generator(dimension, seed),
+                   batchSize, brownianBridge);
+
+        // reference paths are drawn one at a time from the same sequence
+        rsg_type rsg = PseudoRandom::make_sequence_generator(dimension, seed);
+        boost::shared_ptr<PathGenerator<rsg_type> > singleGenerator;
+        boost::shared_ptr<MultiPathGenerator<rsg_type> > multiGenerator;
+        if (process->size() == 1)
+            singleGenerator = boost::shared_ptr<PathGenerator<rsg_type> >(
+                   new PathGenerator<rsg_type>(process, grid, rsg,
+                                               brownianBridge));
+        else
+            multiGenerator = boost::shared_ptr<MultiPathGenerator<rsg_type> >(
+                   new MultiPathGenerator<rsg_type>(process, grid, rsg,
+                                                    brownianBridge));
+
+        MultiPath path(process->size(), grid);
+        Real weight;
+        for (Size n=0; n<batches; n++) {
+            PathBatch batch = generator.next();
+            PathBatch antitheticBatch = generator.antithetic();
+            for (Size k=0; k<batchSize; k++) {
+                if (singleGenerator) {
+                    const Sample<Path>& sample = singleGenerator->next();
+                    path[0] = sample.value;
+                    weight = sample.weight;
+                } else {
+                    const Sample<MultiPath>& sample = multiGenerator->next();
+                    path = sample.value;
+                    weight = sample.weight;
+                }
+                checkBatch(batch, k, path, weight, tag, false);
+
+                if (singleGenerator) {
+                    const Sample<Path>& sample =
+                        singleGenerator->antithetic();
+                    path[0] = sample.value;
+                    weight = sample.weight;
+                } else {
+                    const Sample<MultiPath>& sample =
+                        multiGenerator->antithetic();
+                    path = sample.value;
+                    weight = sample.weight;
+                }
+                checkBatch(antitheticBatch, k, path, weight, tag, true);
+            }
+        }
+    }
+
 }
 
 
@@ -290,11 +385,151 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testBatchPathGenerator() {
+
+    BOOST_TEST_MESSAGE("Testing batch path generation against single paths...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    boost::shared_ptr<StochasticProcess1D> blackScholes(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    testBatch(blackScholes, "Black-Scholes", false);
+    testBatch(blackScholes, "Black-Scholes", true);
+
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                                     new OrnsteinUhlenbeckProcess(0.1, 0.20)),
+              "Ornstein-Uhlenbeck", false);
+
+    HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::QuadraticExponentialMartingale };
+    std::string names[] = { "Heston (partial truncation)",
+                            "Heston (full truncation)",
+                            "Heston (reflection)",
+                            "Heston (QE martingale)" };
+    for (Size i=0; i<LENGTH(schemes); i++) {
+        testBatch(boost::shared_ptr<StochasticProcess>(
+                      new HestonProcess(r, q, x0, 0.04, 1.5, 0.04, 0.5, -0.7,
+                                        schemes[i])),
+                  names[i], false);
+    }
+
+    Matrix correlation(2,2);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.6;
+    correlation[1][0] = 0.6; correlation[1][1] = 1.0;
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(2);
+    processes[0] = blackScholes;
+    processes[1] = boost::shared_ptr<StochasticProcess1D>(
+                                 new SquareRootProcess(0.1, 0.1, 0.20, 10.0));
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                           new StochasticProcessArray(processes,correlation)),
+              "process array", false);
+}
+
+
+void PathGeneratorTest::testMultiPathBlocks() {
+
+    BOOST_TEST_MESSAGE("Testing block generation of correlated multi-paths...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+
+    Size assets = 40;
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(assets);
+    Matrix correlation(assets, assets);
+    for (Size i=0; i<assets; i++) {
+        Handle<Quote> x0(boost::shared_ptr<Quote>(
+                                          new SimpleQuote(90.0 + i*0.5)));
+        Handle<BlackVolTermStructure> sigma(flatVol(0.15 + i*0.005,
+                                                    Actual360()));
+        if (i % 10 == 9)
+            processes[i] = boost::shared_ptr<StochasticProcess1D>(
+                                 new SquareRootProcess(0.1, 0.1, 0.20, 10.0));
+        else
+            processes[i] = boost::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+        for (Size j=0; j<assets; j++)
+            correlation[i][j] = std::exp(-0.1*std::fabs(Real(i)-Real(j)));
+    }
+    boost::shared_ptr<StochasticProcess> process(
+                           new StochasticProcessArray(processes,correlation));
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    typedef MultiPathGenerator<rsg_type>::sample_type sample_type;
+
+    BigNatural seed = 42;
+    Time length = 5.0;
+    Size timeSteps = 12;
+    TimeGrid grid(length, timeSteps);
+    Size dimension = process->factors()*timeSteps;
+
+    MultiPathGenerator<rsg_type> generator(
+                   process, grid,
+                   PseudoRandom::make_sequence_generator(dimension, seed),
+                   false);
+    // the number of paths below is not a multiple of the block
+    MultiPathGenerator<rsg_type> blockGenerator(
+                   process, grid,
+                   PseudoRandom::make_sequence_generator(dimension, seed),
+                   false, 16);
+
+    Real tolerance = 1.0e-12;
+    for (Size n=0; n<50; n++) {
+        for (Size a=0; a<2; a++) {
+            // antithetic paths are only requested for some of the paths
+            bool antithetic = (a == 1);
+            if (antithetic && n % 3 == 1)
+                continue;
+            const sample_type& sample =
+                antithetic ? generator.antithetic() : generator.next();
+            const sample_type& blockSample =
+                antithetic ? blockGenerator.antithetic()
+                           : blockGenerator.next();
+            if (blockSample.weight != sample.weight)
+                BOOST_FAIL("wrong weight for path " << n <<
+                           (antithetic ? " (antithetic)" : "") <<
+                           "\n    calculated: " << blockSample.weight <<
+                           "\n    expected:   " << sample.weight);
+            for (Size j=0; j<assets; j++) {
+                for (Size i=0; i<grid.size(); i++) {
+                    Real expected = sample.value[j][i];
+                    Real calculated = blockSample.value[j][i];
+                    if (std::fabs(calculated-expected) >
+                                       tolerance*std::fabs(expected)) {
+                        BOOST_FAIL("block generation failed to reproduce "
+                                   "path " << n <<
+                                   (antithetic ? " (antithetic)" : "") <<
+                                   "\n    asset:      " << j <<
+                                   "\n    time:       " << grid[i] <<
+                                   "\n    calculated: " << calculated <<
+                                   "\n    expected:   " << expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testBatchPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathBlocks));
     return suite;
 }
 
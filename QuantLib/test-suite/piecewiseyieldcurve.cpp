@@ -36,6 +36,7 @@
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/instruments/forwardrateagreement.hpp>
 #include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/bonds/fixedratebond.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
@@ -907,6 +908,185 @@ void PiecewiseYieldCurveTest::testZeroCopy() {
 
 
 
+namespace {
+
+    template <class T, class I>
+    void testCurveQuoteSensitivities(CommonVars& vars) {
+
+        boost::shared_ptr<PiecewiseYieldCurve<T,I> > curve(
+                      new PiecewiseYieldCurve<T,I>(vars.settlement,
+                                                   vars.instruments,
+                                                   Actual360()));
+        curve->enableQuoteSensitivities();
+        // the bond pays beyond the last node
+        curve->enableExtrapolation();
+        Handle<YieldTermStructure> curveHandle(curve);
+        boost::shared_ptr<IborIndex> euribor6m(new Euribor6M(curveHandle));
+
+        // the floating leg is forecast on the curve as well
+        boost::shared_ptr<VanillaSwap> swap =
+            MakeVanillaSwap(7*Years, euribor6m, 0.05)
+            .withEffectiveDate(vars.settlement)
+            .withPricingEngine(boost::shared_ptr<PricingEngine>(
+                new DiscountingSwapEngine(curveHandle, boost::none,
+                                          Date(), Date(), true)));
+        Schedule schedule(vars.settlement, vars.settlement + 35*Years,
+                          Period(Annual), vars.calendar,
+                          Unadjusted, Unadjusted,
+                          DateGeneration::Backward, false);
+        FixedRateBond bond(vars.settlementDays, 100.0, schedule,
+                           std::vector<Rate>(1, 0.045),
+                           vars.bondDayCounter);
+        bond.setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new DiscountingBondEngine(curveHandle, boost::none, true)));
+
+        std::vector<Real> swapSensitivities =
+            swap->result<std::vector<Real> >("quoteSensitivities");
+        std::vector<Real> bondSensitivities =
+            bond.result<std::vector<Real> >("quoteSensitivities");
+        std::vector<Handle<Quote> > quotes = curve->bootstrapQuotes();
+
+        if (quotes.size() != vars.instruments.size())
+            BOOST_FAIL("wrong number of bootstrap quotes: " << quotes.size()
+                       << " instead of " << vars.instruments.size());
+        if (swapSensitivities.size() != quotes.size()
+            || bondSensitivities.size() != quotes.size())
+            BOOST_FAIL("wrong number of quote sensitivities");
+
+        // compare with bump-and-reprice
+        boost::shared_ptr<VanillaSwap> bumpedSwap =
+            MakeVanillaSwap(7*Years, euribor6m, 0.05)
+            .withEffectiveDate(vars.settlement)
+            .withDiscountingTermStructure(curveHandle);
+        FixedRateBond bumpedBond(vars.settlementDays, 100.0, schedule,
+                                 std::vector<Rate>(1, 0.045),
+                                 vars.bondDayCounter);
+        bumpedBond.setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new DiscountingBondEngine(curveHandle)));
+
+        Real bump = 1.0e-5;
+        for (Size i=0; i<quotes.size(); ++i) {
+            boost::shared_ptr<SimpleQuote> q =
+                boost::dynamic_pointer_cast<SimpleQuote>(
+                                                   quotes[i].currentLink());
+            Real value = q->value();
+            q->setValue(value + bump);
+            Real swapUp = bumpedSwap->NPV(), bondUp = bumpedBond.NPV();
+            q->setValue(value - bump);
+            Real swapDown = bumpedSwap->NPV(), bondDown = bumpedBond.NPV();
+            q->setValue(value);
+
+            Real expected = (swapUp-swapDown)/(2.0*bump);
+            Real tolerance = 1.0e-4 * std::max(1.0, std::fabs(expected));
+            if (std::fabs(swapSensitivities[i] - expected) > tolerance)
+                BOOST_FAIL(io::ordinal(i+1) << " quote:"
+                           << std::setprecision(8)
+                           << "\n    swap sensitivity: "
+                           << swapSensitivities[i]
+                           << "\n    bump-and-reprice: " << expected
+                           << "\n    tolerance:        " << tolerance);
+
+            expected = (bondUp-bondDown)/(2.0*bump);
+            tolerance = 1.0e-4 * std::max(1.0, std::fabs(expected));
+            if (std::fabs(bondSensitivities[i] - expected) > tolerance)
+                BOOST_FAIL(io::ordinal(i+1) << " quote:"
+                           << std::setprecision(8)
+                           << "\n    bond sensitivity: "
+                           << bondSensitivities[i]
+                           << "\n    bump-and-reprice: " << expected
+                           << "\n    tolerance:        " << tolerance);
+        }
+    }
+
+}
+
+void PiecewiseYieldCurveTest::testQuoteSensitivities() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing sensitivities of swaps and bonds to bootstrap quotes...");
+
+    CommonVars vars;
+
+    testCurveQuoteSensitivities<Discount,LogLinear>(vars);
+    testCurveQuoteSensitivities<Discount,Linear>(vars);
+    testCurveQuoteSensitivities<ZeroYield,Linear>(vars);
+    testCurveQuoteSensitivities<ZeroYield,BackwardFlat>(vars);
+    testCurveQuoteSensitivities<ForwardRate,BackwardFlat>(vars);
+    testCurveQuoteSensitivities<ForwardRate,Linear>(vars);
+}
+
+void PiecewiseYieldCurveTest::testQuoteSensitivityRequirements() {
+
+    BOOST_TEST_MESSAGE("Testing requirements of quote sensitivities...");
+
+    CommonVars vars;
+
+    Date d = vars.settlement + 10*Years;
+
+    // the Jacobian is only available when enabled
+    boost::shared_ptr<PiecewiseYieldCurve<Discount,LogLinear> > curve(
+        new PiecewiseYieldCurve<Discount,LogLinear>(vars.settlement,
+                                                    vars.instruments,
+                                                    Actual360()));
+    std::vector<Real> expectedData = curve->data();
+    std::vector<Real> nodeSensitivities;
+    curve->addDiscountSensitivities(d, 1.0, nodeSensitivities);
+    bool failed = false;
+    try {
+        curve->quoteSensitivities(nodeSensitivities);
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_FAIL("quote sensitivities calculated without being enabled");
+
+    // calculating them leaves the curve unchanged
+    curve->enableQuoteSensitivities();
+    std::vector<Real> sensitivities =
+        curve->quoteSensitivities(nodeSensitivities);
+    const std::vector<Real>& data = curve->data();
+    for (Size i=0; i<data.size(); ++i) {
+        if (data[i] != expectedData[i])
+            BOOST_FAIL(io::ordinal(i+1) << " node changed:"
+                       << std::setprecision(12)
+                       << "\n    expected: " << expectedData[i]
+                       << "\n    found:    " << data[i]);
+    }
+    std::vector<Real> nullSensitivities =
+        curve->quoteSensitivities(std::vector<Real>());
+    for (Size i=0; i<nullSensitivities.size(); ++i) {
+        if (nullSensitivities[i] != 0.0)
+            BOOST_FAIL(io::ordinal(i+1) << " quote sensitivity "
+                       "not null for null node sensitivities:"
+                       << "\n    found: " << nullSensitivities[i]);
+    }
+
+    // wrong number of node sensitivities
+    failed = false;
+    try {
+        curve->quoteSensitivities(std::vector<Real>(data.size()+1, 1.0));
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_FAIL("wrong number of node sensitivities accepted");
+
+    // the derivatives through a cubic interpolation are not available
+    boost::shared_ptr<PiecewiseYieldCurve<Discount,Cubic> > cubicCurve(
+        new PiecewiseYieldCurve<Discount,Cubic>(vars.settlement,
+                                                vars.instruments,
+                                                Actual360()));
+    nodeSensitivities.clear();
+    failed = false;
+    try {
+        cubicCurve->addDiscountSensitivities(d, 1.0, nodeSensitivities);
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_FAIL("node sensitivities calculated for cubic interpolation");
+}
+
 
 test_suite* PiecewiseYieldCurveTest::suite() {
 
@@ -955,5 +1135,10 @@ test_suite* PiecewiseYieldCurveTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testForwardCopy));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testZeroCopy));
 
+    suite->add(QUANTLIB_TEST_CASE(
+                   &PiecewiseYieldCurveTest::testQuoteSensitivities));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &PiecewiseYieldCurveTest::testQuoteSensitivityRequirements));
+
     return suite;
 }
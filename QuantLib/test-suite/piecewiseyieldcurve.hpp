@@ -51,6 +51,9 @@ class PiecewiseYieldCurveTest {
     static void testForwardCopy();
     static void testZeroCopy();
 
+    static void testQuoteSensitivities();
+    static void testQuoteSensitivityRequirements();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
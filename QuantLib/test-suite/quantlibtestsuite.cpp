@@ -89,6 +89,7 @@
 #include "fastfouriertransform.hpp"
 #include "fdheston.hpp"
 #include "fdmlinearop.hpp"
+#include "fittedbonddiscountcurve.hpp"
 #include "forwardoption.hpp"
 #include "functions.hpp"
 #include "gaussianquadratures.hpp"
@@ -147,6 +148,7 @@
 #include "rounding.hpp"
 #include "sampledcurve.hpp"
 #include "schedule.hpp"
+#include "sensitivityanalysis.hpp"
 #include "shortratemodels.hpp"
 #include "solvers.hpp"
 #include "spreadoption.hpp"
@@ -293,6 +295,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(FastFourierTransformTest::suite());
     test->add(FdHestonTest::suite());
     test->add(FdmLinearOpTest::suite());
+    test->add(FittedBondDiscountCurveTest::suite());
     test->add(ForwardOptionTest::suite());
     test->add(FunctionsTest::suite());
     test->add(GARCHTest::suite());
@@ -383,6 +386,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(OdeTest::suite());
     test->add(PagodaOptionTest::suite());
     test->add(PartialTimeBarrierOptionTest::suite());
+    test->add(SensitivityAnalysisTest::suite());
     test->add(SpreadOptionTest::suite());
     test->add(SwingOptionTest::suite());
     test->add(TwoAssetBarrierOptionTest::suite());
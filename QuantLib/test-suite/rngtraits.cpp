@@ -22,6 +22,7 @@
 #include "utilities.hpp"
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/math/statistics/incrementalstatistics.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -92,11 +93,126 @@ void RngTraitsTest::testCustomPoisson() {
 }
 
 
+void RngTraitsTest::testZiggurat() {
+
+    BOOST_TEST_MESSAGE("Testing Ziggurat Gaussian pseudo-random number generation...");
+
+    Ziggurat::rsg_type rsg = Ziggurat::make_sequence_generator(100, 1234);
+
+    const std::vector<Real>& values = rsg.nextSequence().value;
+    Real sum = 0.0;
+    for (Size i=0; i<values.size(); i++)
+        sum += values[i];
+
+    Real stored = -4.429675;
+    Real tolerance = 1.0e-5;
+    if (std::fabs(sum - stored) > tolerance)
+        BOOST_FAIL("the sum of the samples does not match the stored value\n"
+                   << "    calculated: " << sum << "\n"
+                   << "    expected:   " << stored);
+
+    IncrementalStatistics stats;
+    for (Size i=0; i<1000; i++) {
+        const std::vector<Real>& sample = rsg.nextSequence().value;
+        stats.addSequence(sample.begin(), sample.end());
+    }
+    if (std::fabs(stats.mean()) > 0.01
+        || std::fabs(stats.variance() - 1.0) > 0.02)
+        BOOST_FAIL("the samples are not standard normal\n"
+                   << "    mean:     " << stats.mean() << "\n"
+                   << "    variance: " << stats.variance());
+}
+
+
+void RngTraitsTest::testCounterBased() {
+
+    BOOST_TEST_MESSAGE("Testing counter-based pseudo-random number generation...");
+
+    // the published test vectors use 64-bit keys and counters
+    if (sizeof(BigNatural) >= 8) {
+        // Philox4x32-10 known-answer test from Salmon et al. (2011):
+        // the seed gives the key, the stream the upper half of the
+        // counter and the number of skipped blocks its lower half
+        BigNatural seed = BigNatural(0x299f31d0a4093822ULL);
+        BigNatural stream = BigNatural(0x0370734413198a2eULL);
+        BigNatural block = BigNatural(0x85a308d3243f6a88ULL);
+        PhiloxUniformRng rng(seed, stream);
+        for (Size i=0; i<4; i++)
+            rng.discard(block);
+        unsigned long expected[] = { 0xd16cfe09UL, 0x94fdccebUL,
+                                     0x5001e420UL, 0x24126ea1UL };
+        for (Size i=0; i<LENGTH(expected); i++) {
+            unsigned long calculated = rng.nextInt32();
+            if (calculated != expected[i])
+                BOOST_FAIL("output #" << i+1 << " does not match "
+                           << "the known answer\n" << std::hex
+                           << "    calculated: " << calculated << "\n"
+                           << "    expected:   " << expected[i]);
+        }
+    }
+
+    // skipping must reach the same outputs as drawing them
+    PhiloxUniformRng reference(42, 3);
+    std::vector<unsigned long> outputs(1000);
+    for (Size i=0; i<outputs.size(); i++)
+        outputs[i] = reference.nextInt32();
+
+    Size skips[] = { 0, 1, 3, 4, 5, 8, 517, 980 };
+    for (Size i=0; i<LENGTH(skips); i++) {
+        for (Size drawn=0; drawn<=std::min<Size>(skips[i], 6); drawn++) {
+            PhiloxUniformRng rng(42, 3);
+            for (Size j=0; j<drawn; j++)
+                rng.nextInt32();
+            rng.discard(skips[i]-drawn);
+            for (Size j=skips[i]; j<std::min<Size>(skips[i]+10, 1000); j++) {
+                if (rng.nextInt32() != outputs[j])
+                    BOOST_FAIL("output #" << j+1 << " not reproduced after "
+                               << "drawing " << drawn << " and skipping "
+                               << skips[i]-drawn << " outputs");
+            }
+        }
+    }
+
+    // streams are independent and stream 0 is the default one
+    CounterBasedPseudoRandom::rsg_type rsg0 =
+        CounterBasedPseudoRandom::make_sequence_generator(100, 1234);
+    CounterBasedPseudoRandom::rsg_type rsg1 =
+        CounterBasedPseudoRandom::make_sequence_generator(100, 1234, 0);
+    CounterBasedPseudoRandom::rsg_type rsg2 =
+        CounterBasedPseudoRandom::make_sequence_generator(100, 1234, 1);
+    const std::vector<Real>& values0 = rsg0.nextSequence().value;
+    const std::vector<Real>& values1 = rsg1.nextSequence().value;
+    const std::vector<Real>& values2 = rsg2.nextSequence().value;
+    Size equal = 0;
+    for (Size i=0; i<values0.size(); i++) {
+        if (values0[i] != values1[i])
+            BOOST_FAIL("the default stream differs from stream 0");
+        if (values0[i] == values2[i])
+            ++equal;
+    }
+    if (equal > 0)
+        BOOST_FAIL(equal << " samples shared by streams 0 and 1");
+
+    Real sum = 0.0;
+    for (Size i=0; i<values0.size(); i++)
+        sum += values0[i];
+
+    Real stored = 8.110812;
+    Real tolerance = 1.0e-5;
+    if (std::fabs(sum - stored) > tolerance)
+        BOOST_FAIL("the sum of the samples does not match the stored value\n"
+                   << "    calculated: " << sum << "\n"
+                   << "    expected:   " << stored);
+}
+
+
 test_suite* RngTraitsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("RNG traits tests");
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testGaussian));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testDefaultPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCustomPoisson));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testZiggurat));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCounterBased));
     return suite;
 }
 
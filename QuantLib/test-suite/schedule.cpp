@@ -20,6 +20,7 @@
 #include "schedule.hpp"
 #include "utilities.hpp"
 #include <ql/time/schedule.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
@@ -210,6 +211,80 @@ void ScheduleTest::testDoubleFirstDateWithEomAdjustment() {
     check_dates(s, expected);
 }
 
+void ScheduleTest::testCachedSchedules() {
+    BOOST_TEST_MESSAGE("Testing cached schedules...");
+
+    ScheduleCache::instance().clear();
+
+    MakeSchedule maker;
+    maker.from(Date(22,August,1996))
+         .to(Date(22,August,2006))
+         .withCalendar(TARGET())
+         .withTenor(6*Months)
+         .withConvention(ModifiedFollowing)
+         .backwards();
+
+    Schedule s1 = maker;
+    Schedule s2 = maker.cached();
+    Schedule s3 = maker.cached();
+
+    check_dates(s2, s1.dates());
+    check_dates(s3, s1.dates());
+
+    if (ScheduleCache::instance().size() != 1)
+        BOOST_ERROR("expected 1 cached schedule, found "
+                    << ScheduleCache::instance().size());
+    if (&s2.dates() != &s3.dates())
+        BOOST_ERROR("cached schedules do not share their dates");
+
+    // truncating a shared schedule must not affect the others
+    Schedule truncated = s2.until(Date(1,January,2000));
+    check_dates(s3, s1.dates());
+    if (truncated.endDate() != Date(1,January,2000))
+        BOOST_ERROR("wrong end date for truncated schedule: "
+                    << truncated.endDate());
+
+    // calendars sharing a name must not share schedules
+    BespokeCalendar noWeekends("bespoke"), sundays("bespoke");
+    sundays.addWeekend(Sunday);
+    maker.withCalendar(noWeekends).withConvention(Following);
+    Schedule s4 = maker.cached();
+    maker.withCalendar(sundays);
+    Schedule s5 = maker.cached();
+    Schedule s6 = maker.cached(false);
+    check_dates(s5, s6.dates());
+    if (s4.dates() == s5.dates())
+        BOOST_ERROR("bespoke calendars with different weekends "
+                    "share the same schedule");
+
+    // modifying a calendar must discard the cached schedules
+    Calendar target = TARGET();
+    Date holiday(22,February,2000);
+    maker.withCalendar(target).withConvention(ModifiedFollowing);
+    Schedule before = maker.cached();
+    target.addHoliday(holiday);
+    Schedule after = maker.cached();
+    Schedule expected = maker.cached(false);
+    target.removeHoliday(holiday);
+    check_dates(after, expected.dates());
+    if (after.dates() == before.dates())
+        BOOST_ERROR("cached schedule not regenerated after "
+                    "adding a holiday");
+
+    // the size of the cache is bounded
+    ScheduleCache::instance().clear();
+    Size maxSize = ScheduleCache::instance().maxSize();
+    ScheduleCache::instance().setMaxSize(3);
+    for (Integer i=0; i<5; ++i)
+        Schedule s = maker.from(Date(22,August,1996)+i).cached();
+    Size size = ScheduleCache::instance().size();
+    ScheduleCache::instance().setMaxSize(maxSize);
+    if (size != 3)
+        BOOST_ERROR("expected 3 cached schedules, found " << size);
+
+    ScheduleCache::instance().clear();
+}
+
 
 test_suite* ScheduleTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Schedule tests");
@@ -223,6 +298,7 @@ test_suite* ScheduleTest::suite() {
         &ScheduleTest::testBackwardDatesWithEomAdjustment));
     suite->add(QUANTLIB_TEST_CASE(
         &ScheduleTest::testDoubleFirstDateWithEomAdjustment));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testCachedSchedules));
     return suite;
 }
 
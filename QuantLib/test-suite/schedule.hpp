@@ -33,6 +33,7 @@ class ScheduleTest {
     static void testForwardDatesWithEomAdjustment();
     static void testBackwardDatesWithEomAdjustment();
     static void testDoubleFirstDateWithEomAdjustment();
+    static void testCachedSchedules();
     static boost::unit_test_framework::test_suite* suite();
 };
 
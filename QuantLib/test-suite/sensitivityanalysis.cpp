@@ -0,0 +1,291 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include "sensitivityanalysis.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/bonds/fixedratebond.hpp>
+#include <ql/pricingengines/bond/discountingbondengine.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/piecewisezerospreadedtermstructure.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/statistics/riskstatistics.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+using boost::shared_ptr;
+
+namespace {
+
+    // a self-contained copy of the market and of the instruments
+    struct Replica {
+        std::vector<Handle<SimpleQuote> > quotes;
+        std::vector<shared_ptr<Instrument> > instruments;
+
+        Replica() {
+            Calendar calendar = TARGET();
+            Date today = Settings::instance().evaluationDate();
+
+            // zero-rate spreads over a flat curve; unlike a bootstrap,
+            // which starts from the previous solution and converges
+            // within its accuracy, the resulting curve only depends on
+            // the current quotes, so that serial and parallel results
+            // can be compared tightly.
+            Rate spreads[] = { 0.0030, 0.0040, 0.0060, 0.0090,
+                               0.0110, 0.0140, 0.0170 };
+            Period tenors[] = { 3*Months, 6*Months, 2*Years, 3*Years,
+                                5*Years, 7*Years, 10*Years };
+
+            std::vector<Handle<Quote> > spreadHandles;
+            std::vector<Date> dates;
+            for (Size i=0; i<LENGTH(spreads); ++i) {
+                shared_ptr<SimpleQuote> q(new SimpleQuote(spreads[i]));
+                quotes.push_back(Handle<SimpleQuote>(q));
+                spreadHandles.push_back(Handle<Quote>(q));
+                dates.push_back(calendar.advance(today, tenors[i]));
+            }
+            Handle<YieldTermStructure> flat(shared_ptr<YieldTermStructure>(
+                new FlatForward(today, 0.01, Actual365Fixed())));
+            Handle<YieldTermStructure> curve(shared_ptr<YieldTermStructure>(
+                new PiecewiseZeroSpreadedTermStructure(flat, spreadHandles,
+                                                       dates)));
+
+            shared_ptr<IborIndex> index(new Euribor6M(curve));
+            shared_ptr<PricingEngine> swapEngine(
+                                        new DiscountingSwapEngine(curve));
+            for (Integer i=1; i<=4; ++i) {
+                shared_ptr<VanillaSwap> swap =
+                    MakeVanillaSwap(2*i*Years, index, 0.004*i)
+                    .withNominal(1000000.0);
+                swap->setPricingEngine(swapEngine);
+                instruments.push_back(swap);
+            }
+
+            Schedule schedule(today, today + 6*Years, Period(Annual),
+                              calendar, Unadjusted, Unadjusted,
+                              DateGeneration::Backward, false);
+            shared_ptr<Bond> bond(
+                new FixedRateBond(2, 1000000.0, schedule,
+                                  std::vector<Rate>(1, 0.02),
+                                  Thirty360(Thirty360::BondBasis)));
+            bond->setPricingEngine(shared_ptr<PricingEngine>(
+                                          new DiscountingBondEngine(curve)));
+            instruments.push_back(bond);
+        }
+    };
+
+}
+
+
+void SensitivityAnalysisTest::testParallelBucketAnalysis() {
+
+    BOOST_TEST_MESSAGE("Testing parallel bucket sensitivity analysis...");
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(15, March, 2013);
+
+    std::vector<Real> quantities;
+    quantities.push_back(1.0);
+    quantities.push_back(-2.0);
+    quantities.push_back(0.5);
+    quantities.push_back(1.0);
+    quantities.push_back(3.0);
+
+    Replica serial;
+    Size nQuotes = serial.quotes.size();
+
+    Size nReplicaSets[] = { 1, 3, 7, 12 };
+    SensitivityAnalysis types[] = { OneSide, Centered };
+
+    for (Size t=0; t<LENGTH(types); ++t) {
+        std::pair<std::vector<Real>, std::vector<Real> > expected =
+            bucketAnalysis(serial.quotes, serial.instruments, quantities,
+                           0.0001, types[t]);
+
+        for (Size k=0; k<LENGTH(nReplicaSets); ++k) {
+            Size nReplicas = nReplicaSets[k];
+            std::vector<std::vector<Handle<SimpleQuote> > > quotes;
+            std::vector<std::vector<shared_ptr<Instrument> > > instruments;
+            for (Size r=0; r<nReplicas; ++r) {
+                Replica replica;
+                quotes.push_back(replica.quotes);
+                instruments.push_back(replica.instruments);
+            }
+
+            std::pair<std::vector<Real>, std::vector<Real> > calculated =
+                parallelBucketAnalysis(quotes, instruments, quantities,
+                                       0.0001, types[t]);
+
+            if (calculated.first.size() != nQuotes ||
+                calculated.second.size() != nQuotes)
+                BOOST_FAIL("wrong number of sensitivities returned");
+
+            Real tolerance = 1.0e-8;
+            for (Size i=0; i<nQuotes; ++i) {
+                if (std::fabs(calculated.first[i] - expected.first[i])
+                                                              > tolerance ||
+                    std::fabs(calculated.second[i] - expected.second[i])
+                                                              > tolerance)
+                    BOOST_ERROR("parallel bucket analysis with "
+                                << nReplicas << " replicas ("
+                                << types[t] << ") differs from serial "
+                                "one for quote #" << i
+                                << std::setprecision(12)
+                                << "\n    first derivative:  "
+                                << calculated.first[i]
+                                << " instead of " << expected.first[i]
+                                << "\n    second derivative: "
+                                << calculated.second[i]
+                                << " instead of " << expected.second[i]);
+            }
+
+            // the bumped quotes must have been restored
+            for (Size r=0; r<nReplicas; ++r)
+                for (Size i=0; i<nQuotes; ++i)
+                    if (quotes[r][i]->value() != serial.quotes[i]->value())
+                        BOOST_ERROR("quote #" << i << " of replica #" << r
+                                    << " not restored: "
+                                    << quotes[r][i]->value()
+                                    << " instead of "
+                                    << serial.quotes[i]->value());
+        }
+    }
+}
+
+
+void SensitivityAnalysisTest::testHistoricalRiskAnalysis() {
+
+    BOOST_TEST_MESSAGE("Testing parallel historical full revaluation...");
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(15, March, 2013);
+
+    std::vector<Real> quantities;
+    quantities.push_back(1.0);
+    quantities.push_back(-2.0);
+    quantities.push_back(0.5);
+    quantities.push_back(1.0);
+    quantities.push_back(3.0);
+
+    Replica serial;
+    Size nQuotes = serial.quotes.size();
+
+    // daily spread changes of a few basis points, with a common factor
+    MersenneTwisterUniformRng rng(42);
+    const Size nScenarios = 250;
+    std::vector<std::vector<Real> > shifts(nScenarios,
+                                           std::vector<Real>(nQuotes));
+    for (Size s=0; s<nScenarios; ++s) {
+        Real common = rng.next().value - 0.5;
+        for (Size i=0; i<nQuotes; ++i)
+            shifts[s][i] = 0.0010*common + 0.0004*(rng.next().value-0.5);
+    }
+
+    // serial loop over the scenarios
+    Real referenceNpv = aggregateNPV(serial.instruments, quantities);
+    std::vector<Real> base(nQuotes), expected(nScenarios);
+    for (Size i=0; i<nQuotes; ++i)
+        base[i] = serial.quotes[i]->value();
+    for (Size s=0; s<nScenarios; ++s) {
+        for (Size i=0; i<nQuotes; ++i)
+            serial.quotes[i]->setValue(base[i] + shifts[s][i]);
+        expected[s] = aggregateNPV(serial.instruments, quantities)
+                    - referenceNpv;
+    }
+    for (Size i=0; i<nQuotes; ++i)
+        serial.quotes[i]->setValue(base[i]);
+
+    RiskStatistics stats;
+    stats.addSequence(expected.begin(), expected.end());
+    Real percentile = 0.99;
+    Real expectedVar = stats.valueAtRisk(percentile);
+    Real expectedEs = stats.expectedShortfall(percentile);
+
+    Size nReplicaSets[] = { 1, 3, 7 };
+    for (Size k=0; k<LENGTH(nReplicaSets); ++k) {
+        Size nReplicas = nReplicaSets[k];
+        std::vector<std::vector<Handle<SimpleQuote> > > quotes;
+        std::vector<std::vector<shared_ptr<Instrument> > > instruments;
+        for (Size r=0; r<nReplicas; ++r) {
+            Replica replica;
+            quotes.push_back(replica.quotes);
+            instruments.push_back(replica.instruments);
+        }
+
+        std::vector<Real> calculated =
+            parallelScenarioAnalysis(quotes, instruments, quantities, shifts);
+        if (calculated.size() != nScenarios)
+            BOOST_FAIL("wrong number of scenario results returned");
+
+        Real tolerance = 1.0e-6;
+        for (Size s=0; s<nScenarios; ++s) {
+            if (std::fabs(calculated[s] - expected[s]) > tolerance)
+                BOOST_ERROR("parallel scenario analysis with "
+                            << nReplicas << " replicas differs from "
+                            "serial loop for scenario #" << s
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated[s]
+                            << "\n    expected:   " << expected[s]);
+        }
+
+        std::pair<Real, Real> risk =
+            historicalRiskAnalysis(quotes, instruments, quantities,
+                                   shifts, percentile);
+        if (std::fabs(risk.first - expectedVar) > tolerance ||
+            std::fabs(risk.second - expectedEs) > tolerance)
+            BOOST_ERROR("historical risk analysis with "
+                        << nReplicas << " replicas differs from "
+                        "serial loop"
+                        << std::setprecision(12)
+                        << "\n    value at risk:      " << risk.first
+                        << " instead of " << expectedVar
+                        << "\n    expected shortfall: " << risk.second
+                        << " instead of " << expectedEs);
+
+        // the shifted quotes must have been restored
+        for (Size r=0; r<nReplicas; ++r)
+            for (Size i=0; i<nQuotes; ++i)
+                if (quotes[r][i]->value() != base[i])
+                    BOOST_ERROR("quote #" << i << " of replica #" << r
+                                << " not restored: "
+                                << quotes[r][i]->value()
+                                << " instead of " << base[i]);
+    }
+
+    if (expectedVar <= 0.0 || expectedEs < expectedVar)
+        BOOST_ERROR("inconsistent historical risk figures"
+                    << "\n    value at risk:      " << expectedVar
+                    << "\n    expected shortfall: " << expectedEs);
+}
+
+
+test_suite* SensitivityAnalysisTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Sensitivity analysis tests");
+    suite->add(QUANTLIB_TEST_CASE(
+                      &SensitivityAnalysisTest::testParallelBucketAnalysis));
+    suite->add(QUANTLIB_TEST_CASE(
+                      &SensitivityAnalysisTest::testHistoricalRiskAnalysis));
+    return suite;
+}
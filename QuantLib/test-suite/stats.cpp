@@ -26,6 +26,8 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/kendallstau.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
@@ -322,12 +324,302 @@ void StatisticsTest::testConvergenceStatistics() {
 }
 
 
+namespace {
+
+    // direct count over all pairs
+    Real naiveKendallsTau(const std::vector<Real>& x,
+                          const std::vector<Real>& y,
+                          const std::vector<Real>& w) {
+        Real sum = 0.0, total = 0.0;
+        for (Size i=0; i<x.size(); ++i) {
+            for (Size j=0; j<i; ++j) {
+                Real dx = x[i]-x[j], dy = y[i]-y[j];
+                Real weight = w[i]*w[j];
+                total += weight;
+                if (dx*dy > 0.0)
+                    sum += weight;
+                else if (dx*dy < 0.0)
+                    sum -= weight;
+            }
+        }
+        return sum/total;
+    }
+
+    void checkKendallsTau(const std::string& name,
+                          const std::vector<Real>& x,
+                          const std::vector<Real>& y,
+                          const std::vector<Real>& w) {
+        Real expected = naiveKendallsTau(x, y, w);
+        Real calculated = kendallsTau(x, y, w);
+        Real tolerance = 1.0e-12;
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("wrong weighted Kendall's tau (" << name << ")"
+                        << std::setprecision(14)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+
+        std::vector<Real> unitWeights(x.size(), 1.0);
+        expected = naiveKendallsTau(x, y, unitWeights);
+        calculated = kendallsTau(x, y);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("wrong Kendall's tau (" << name << ")"
+                        << std::setprecision(14)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+}
+
+
+void StatisticsTest::testKendallsTau() {
+
+    BOOST_TEST_MESSAGE("Testing Kendall's tau against direct pair count...");
+
+    // perfect agreement and disagreement
+    Real a[] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    std::vector<Real> x(a, a+LENGTH(a)), y(x.rbegin(), x.rend());
+    if (kendallsTau(x, x) != 1.0)
+        BOOST_ERROR("Kendall's tau of a series with itself is "
+                    << kendallsTau(x, x) << " instead of 1");
+    if (kendallsTau(x, y) != -1.0)
+        BOOST_ERROR("Kendall's tau of a series with its reverse is "
+                    << kendallsTau(x, y) << " instead of -1");
+
+    MersenneTwisterUniformRng rng(42);
+    Size sizes[] = { 2, 3, 7, 64, 100, 257 };
+    // number of distinct values; a small one yields many ties
+    Size levels[] = { 0, 2, 5, 20 };
+
+    for (Size i=0; i<LENGTH(sizes); ++i) {
+        for (Size k=0; k<LENGTH(levels); ++k) {
+            Size n = sizes[i];
+            std::vector<Real> x(n), y(n), w(n);
+            for (Size j=0; j<n; ++j) {
+                Real u = rng.next().value;
+                x[j] = u;
+                y[j] = 0.5*u + 0.5*rng.next().value;
+                w[j] = 0.1 + rng.next().value;
+                if (levels[k] != 0) {
+                    x[j] = std::floor(x[j]*levels[k]);
+                    y[j] = std::floor(y[j]*levels[k]);
+                }
+            }
+            std::ostringstream name;
+            name << n << " observations, ";
+            if (levels[k] == 0)
+                name << "no ties";
+            else
+                name << levels[k] << " distinct values";
+            checkKendallsTau(name.str(), x, y, w);
+        }
+    }
+
+    // ties in one series only
+    std::vector<Real> tied(x.size(), 1.0), w(x.size(), 1.0);
+    tied[4] = 2.0;
+    checkKendallsTau("ties in first series", tied, x, w);
+    checkKendallsTau("ties in second series", x, tied, w);
+}
+
+
+void StatisticsTest::testKendallsTauMatrix() {
+
+    BOOST_TEST_MESSAGE("Testing Kendall's tau matrix against pair loop...");
+
+    MersenneTwisterUniformRng rng(42);
+    const Size m = 9, n = 60;
+    std::vector<std::vector<Real> > series(m, std::vector<Real>(n));
+    std::vector<Real> w(n);
+    for (Size j=0; j<n; ++j) {
+        Real common = rng.next().value;
+        for (Size i=0; i<m; ++i)
+            series[i][j] = std::floor(10.0*(0.1*i*common +
+                                            rng.next().value));
+        w[j] = 0.1 + rng.next().value;
+    }
+
+    Matrix weighted = kendallsTauMatrix(series, w);
+    Matrix unweighted = kendallsTauMatrix(series);
+    std::vector<Real> unitWeights(n, 1.0);
+    Real tolerance = 1.0e-15;
+    for (Size i=0; i<m; ++i) {
+        for (Size j=0; j<m; ++j) {
+            // the matrix is symmetric by construction; the coefficient
+            // is calculated with the series of larger index first
+            const std::vector<Real>& x = series[std::max(i,j)];
+            const std::vector<Real>& y = series[std::min(i,j)];
+            Real expected = (i == j) ? 1.0 : kendallsTau(x, y, w);
+            if (std::fabs(weighted[i][j]-expected) > tolerance)
+                BOOST_ERROR("wrong weighted Kendall's tau matrix element ("
+                            << i << "," << j << ")"
+                            << std::setprecision(14)
+                            << "\n    calculated: " << weighted[i][j]
+                            << "\n    expected:   " << expected);
+            expected = (i == j) ? 1.0 : kendallsTau(x, y, unitWeights);
+            if (std::fabs(unweighted[i][j]-expected) > tolerance)
+                BOOST_ERROR("wrong Kendall's tau matrix element ("
+                            << i << "," << j << ")"
+                            << std::setprecision(14)
+                            << "\n    calculated: " << unweighted[i][j]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    // an error raised for a pair must reach the caller
+    std::vector<std::vector<Real> > single(m, std::vector<Real>(1, 1.0));
+    bool raised = false;
+    try {
+        kendallsTauMatrix(single);
+    } catch (Error&) {
+        raised = true;
+    }
+    if (!raised)
+        BOOST_ERROR("no error raised for series with a single observation");
+
+    // null weights leave no pair to count
+    raised = false;
+    try {
+        kendallsTauMatrix(series, std::vector<Real>(n, 0.0));
+    } catch (Error&) {
+        raised = true;
+    }
+    if (!raised)
+        BOOST_ERROR("no error raised for null weights");
+}
+
+
+
+namespace {
+
+    void checkMergedValue(const std::string& name, const std::string& what,
+                          Real calculated, Real expected) {
+        Real tolerance = 1.0e-10;
+        if (std::fabs(calculated-expected) >
+            tolerance*std::max(1.0, std::fabs(expected)))
+            BOOST_ERROR("wrong " << what << " after merge (" << name << ")"
+                        << std::setprecision(14)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    void checkMerged(const std::string& name,
+                     const IncrementalStatistics& merged,
+                     const IncrementalStatistics& expected) {
+        if (merged.samples() != expected.samples()) {
+            BOOST_ERROR("wrong number of samples after merge (" << name << ")"
+                        << "\n    calculated: " << merged.samples()
+                        << "\n    expected:   " << expected.samples());
+            return;
+        }
+        checkMergedValue(name, "sum of weights",
+                         merged.weightSum(), expected.weightSum());
+        if (expected.samples() == 0)
+            return;
+        checkMergedValue(name, "mean", merged.mean(), expected.mean());
+        checkMergedValue(name, "min", merged.min(), expected.min());
+        checkMergedValue(name, "max", merged.max(), expected.max());
+        if (expected.samples() < 2)
+            return;
+        checkMergedValue(name, "variance",
+                         merged.variance(), expected.variance());
+        checkMergedValue(name, "downside variance",
+                         merged.downsideVariance(),
+                         expected.downsideVariance());
+        if (expected.samples() < 4)
+            return;
+        checkMergedValue(name, "skewness",
+                         merged.skewness(), expected.skewness());
+        checkMergedValue(name, "kurtosis",
+                         merged.kurtosis(), expected.kurtosis());
+    }
+
+}
+
+
+void StatisticsTest::testMerge() {
+
+    BOOST_TEST_MESSAGE("Testing merged against sequential statistics...");
+
+    MersenneTwisterUniformRng rng(42);
+    const Size n = 50, dimension = 3;
+    std::vector<std::vector<Real> > samples(n, std::vector<Real>(dimension));
+    std::vector<Real> weights(n);
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<dimension; ++j)
+            samples[i][j] = rng.next().value - 0.3*j;
+        weights[i] = 0.5 + rng.next().value;
+    }
+
+    // splits include empty left and right operands
+    Size splits[] = { 0, 1, 2, 17, 49, 50 };
+    for (Size k=0; k<LENGTH(splits); ++k) {
+        Size split = splits[k];
+        std::ostringstream name;
+        name << split << " + " << n-split << " samples";
+
+        IncrementalStatistics sequential, left, right;
+        SequenceStatisticsInc sequentialSeq, leftSeq, rightSeq;
+        for (Size i=0; i<n; ++i) {
+            sequential.add(samples[i][0], weights[i]);
+            sequentialSeq.add(samples[i], weights[i]);
+            if (i < split) {
+                left.add(samples[i][0], weights[i]);
+                leftSeq.add(samples[i], weights[i]);
+            } else {
+                right.add(samples[i][0], weights[i]);
+                rightSeq.add(samples[i], weights[i]);
+            }
+        }
+
+        left.merge(right);
+        checkMerged(name.str(), left, sequential);
+
+        leftSeq.merge(rightSeq);
+        if (leftSeq.size() != dimension) {
+            BOOST_ERROR("wrong dimension after merge (" << name.str() << ")"
+                        << "\n    calculated: " << leftSeq.size()
+                        << "\n    expected:   " << dimension);
+            continue;
+        }
+        if (leftSeq.samples() != sequentialSeq.samples())
+            BOOST_ERROR("wrong number of samples after merge ("
+                        << name.str() << ")"
+                        << "\n    calculated: " << leftSeq.samples()
+                        << "\n    expected:   " << sequentialSeq.samples());
+        std::vector<Real> calculatedMeans = leftSeq.mean(),
+                          expectedMeans = sequentialSeq.mean();
+        for (Size j=0; j<dimension; ++j)
+            checkMergedValue(name.str(), "mean",
+                             calculatedMeans[j], expectedMeans[j]);
+        Matrix calculated = leftSeq.covariance();
+        Matrix expected = sequentialSeq.covariance();
+        for (Size i=0; i<dimension; ++i)
+            for (Size j=0; j<dimension; ++j)
+                checkMergedValue(name.str(), "covariance",
+                                 calculated[i][j], expected[i][j]);
+    }
+
+    // merging two empty instances leaves them empty
+    IncrementalStatistics empty;
+    empty.merge(IncrementalStatistics());
+    checkMerged("empty", empty, IncrementalStatistics());
+    SequenceStatisticsInc emptySeq;
+    emptySeq.merge(SequenceStatisticsInc());
+    if (emptySeq.size() != 0 || emptySeq.samples() != 0)
+        BOOST_ERROR("merging empty sequence statistics gave "
+                    << emptySeq.size() << " dimensions and "
+                    << emptySeq.samples() << " samples");
+}
+
 
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testKendallsTau));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testKendallsTauMatrix));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testMerge));
     return suite;
 }
 
@@ -31,6 +31,9 @@ class StatisticsTest {
     static void testStatistics();
     static void testSequenceStatistics();
     static void testConvergenceStatistics();
+    static void testKendallsTau();
+    static void testKendallsTauMatrix();
+    static void testMerge();
     static boost::unit_test_framework::test_suite* suite();
 };
 
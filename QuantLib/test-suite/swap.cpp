@@ -21,6 +21,7 @@
 #include "utilities.hpp"
 #include <ql/instruments/vanillaswap.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/pricingengines/swap/portfoliodiscountingswapengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
@@ -322,6 +323,70 @@ void SwapTest::testCachedValue() {
                     << "    expected:   " << cachedNPV);
 }
 
+void SwapTest::testPortfolioEngine() {
+
+    BOOST_TEST_MESSAGE("Testing portfolio discounting swap engine...");
+
+    CommonVars vars;
+
+    Integer lengths[] = { 1, 2, 5, 10, 20 };
+    Rate rates[] = { 0.04, 0.05, 0.06 };
+    Spread spreads[] = { -0.001, 0.0, 0.002 };
+
+    boost::shared_ptr<PortfolioDiscountingSwapEngine> portfolioEngine(
+                     new PortfolioDiscountingSwapEngine(vars.termStructure));
+
+    std::vector<boost::shared_ptr<Swap> > portfolio;
+    std::vector<Real> expectedNPVs, expectedBPSs;
+    for (Size i=0; i<LENGTH(lengths); i++) {
+        for (Size j=0; j<LENGTH(rates); j++) {
+            for (Size k=0; k<LENGTH(spreads); k++) {
+                boost::shared_ptr<VanillaSwap> swap =
+                    vars.makeSwap(lengths[i], rates[j], spreads[k]);
+                expectedNPVs.push_back(swap->NPV());
+                expectedBPSs.push_back(swap->legBPS(1));
+                swap->setPricingEngine(portfolioEngine);
+                portfolio.push_back(swap);
+            }
+        }
+    }
+
+    // without prefetching, and after it
+    for (Size n=0; n<2; ++n) {
+        if (n == 1) {
+            portfolioEngine->prefetch(portfolio);
+            if (portfolioEngine->prefetchedDates() == 0)
+                BOOST_FAIL("no discount factor prefetched");
+        }
+
+        for (Size i=0; i<portfolio.size(); ++i) {
+            portfolio[i]->recalculate();
+            if (std::fabs(portfolio[i]->NPV()-expectedNPVs[i]) > 1.0e-10
+                || std::fabs(portfolio[i]->legBPS(1)-expectedBPSs[i])
+                                                                > 1.0e-10)
+                BOOST_ERROR("failed to reproduce swap results "
+                            << (n == 0 ? "without" : "with")
+                            << " prefetching:\n"
+                            << std::setprecision(12)
+                            << "    calculated NPV: "
+                            << portfolio[i]->NPV() << "\n"
+                            << "    expected NPV:   "
+                            << expectedNPVs[i] << "\n"
+                            << "    calculated BPS: "
+                            << portfolio[i]->legBPS(1) << "\n"
+                            << "    expected BPS:   "
+                            << expectedBPSs[i]);
+        }
+    }
+
+    // a curve change must discard the prefetched discounts
+    vars.termStructure.linkTo(flatRate(vars.settlement, 0.04,
+                                       Actual365Fixed()));
+    if (portfolioEngine->prefetchedDates() != 0)
+        BOOST_ERROR("prefetched discount factors not discarded "
+                    "after curve change");
+}
+
 
 test_suite* SwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swap tests");
@@ -331,6 +396,7 @@ test_suite* SwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testSpreadDependency));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testInArrears));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testCachedValue));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testPortfolioEngine));
     return suite;
 }
 
@@ -23,6 +23,7 @@
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <ql/indexes/ibor/eonia.hpp>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -193,11 +194,54 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testFixingLookup() {
+    BOOST_TEST_MESSAGE("Testing lookup of stored index fixings...");
+
+    IndexHistoryCleaner cleaner;
+
+    Eonia index;
+    Calendar calendar = index.fixingCalendar();
+    Date d0(2, January, 2014), d1(31, December, 2014);
+
+    std::vector<Date> dates;
+    std::vector<Real> fixings;
+    for (Date d = d0; d <= d1; d = calendar.advance(d, 1, Days)) {
+        dates.push_back(d);
+        fixings.push_back(0.001 + 0.00001*dates.size());
+    }
+    index.addFixings(dates.begin(), dates.end(), fixings.begin());
+
+    for (Date d = d0 - 10; d <= d1 + 10; ++d) {
+        Real expected = index.timeSeries()[d];
+        Real calculated = index.historicalFixing(d);
+        if (calculated != expected)
+            BOOST_ERROR("fixing lookup failed at " << d << ":"
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    // new fixings must be seen by the lookup...
+    Date d2 = calendar.advance(d1, 1, Days);
+    index.addFixing(d2, 0.002);
+    if (index.historicalFixing(d2) != 0.002)
+        BOOST_ERROR("added fixing not found");
+
+    // ...and so must cleared ones, also through another instance
+    Eonia otherIndex;
+    otherIndex.clearFixings();
+    if (index.historicalFixing(d0) != Null<Real>())
+        BOOST_ERROR("cleared fixing still found");
+    index.addFixing(d0, 0.003);
+    if (otherIndex.historicalFixing(d0) != 0.003)
+        BOOST_ERROR("fixing added after clearing history not found");
+}
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testFixingLookup));
     return suite;
 }
 
@@ -30,6 +30,7 @@ class TimeSeriesTest {
     static void testConstruction();
     static void testIntervalPrice();
     static void testIterators();
+    static void testFixingLookup();
     static boost::unit_test_framework::test_suite* suite();
     
 };